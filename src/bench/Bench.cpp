@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Exception.h"
+#include "common/version.h"
+#include "timer/Timer.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace love
+{
+namespace bench
+{
+
+static volatile uint64 sinkValue = 0;
+static const void * volatile sinkPointer = nullptr;
+
+void consume(uint64 value)
+{
+	sinkValue = sinkValue + value;
+}
+
+void consume(const void *ptr)
+{
+	sinkPointer = ptr;
+}
+
+static const int64 MAX_ITERATIONS_PER_SAMPLE = 1LL << 30;
+
+static double timeIterations(const Case &c, int64 iterations)
+{
+	double start = timer::Timer::getTime();
+
+	for (int64 i = 0; i < iterations; i++)
+		c.run();
+
+	return timer::Timer::getTime() - start;
+}
+
+// Nearest-rank percentile of a sorted list.
+static double percentile(const std::vector<double> &sorted, double p)
+{
+	size_t rank = (size_t) std::ceil(p / 100.0 * (double) sorted.size());
+	rank = std::min(std::max(rank, (size_t) 1), sorted.size());
+	return sorted[rank - 1];
+}
+
+static std::string escapeJSON(const std::string &str)
+{
+	std::string out;
+	out.reserve(str.size());
+
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out += '\\';
+			out += c;
+		}
+		else if ((unsigned char) c < 0x20)
+		{
+			char buf[8];
+			snprintf(buf, sizeof(buf), "\\u%04x", (unsigned int) c);
+			out += buf;
+		}
+		else
+			out += c;
+	}
+
+	return out;
+}
+
+static std::string formatNumber(double value)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "%.3f", value);
+	return buf;
+}
+
+Suite::Suite()
+{
+}
+
+void Suite::add(const std::string &name, const std::string &unit, double items, const std::function<void()> &run)
+{
+	Case c = {name, unit, items, run};
+	cases.push_back(c);
+}
+
+const std::vector<Case> &Suite::getCases() const
+{
+	return cases;
+}
+
+Result Suite::run(const Case &c, int samples, double sampleTime) const
+{
+	Result r = {};
+	r.name = c.name;
+	r.unit = c.unit;
+	r.items = c.items;
+
+	try
+	{
+		// This also serves as the warm-up.
+		int64 iterations = 1;
+		for (;;)
+		{
+			double elapsed = timeIterations(c, iterations);
+			if (elapsed >= sampleTime * 0.5 || iterations >= MAX_ITERATIONS_PER_SAMPLE)
+				break;
+
+			if (elapsed < sampleTime * 0.01)
+				iterations *= 10;
+			else
+				iterations = (int64) std::ceil((double) iterations * sampleTime / elapsed);
+
+			iterations = std::min(iterations, MAX_ITERATIONS_PER_SAMPLE);
+		}
+
+		std::vector<double> times;
+		times.reserve(samples);
+
+		for (int i = 0; i < samples; i++)
+			times.push_back(timeIterations(c, iterations) * 1.0e9 / (double) iterations);
+
+		std::sort(times.begin(), times.end());
+
+		double total = 0.0;
+		for (double t : times)
+			total += t;
+
+		r.samples = samples;
+		r.iterationsPerSample = iterations;
+		r.min = times.front();
+		r.mean = total / (double) samples;
+		r.p50 = percentile(times, 50.0);
+		r.p90 = percentile(times, 90.0);
+		r.p99 = percentile(times, 99.0);
+		r.max = times.back();
+	}
+	catch (love::Exception &e)
+	{
+		r.error = e.what();
+	}
+	catch (std::exception &e)
+	{
+		r.error = e.what();
+	}
+
+	return r;
+}
+
+std::string Suite::toJSON(const std::vector<Result> &results)
+{
+	std::string json;
+
+	json += "{\n";
+	json += "\t\"version\": \"" + std::string(love::VERSION) + "\",\n";
+	json += "\t\"benchmarks\": [";
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const Result &r = results[i];
+
+		json += i > 0 ? ",\n" : "\n";
+		json += "\t\t{\n";
+		json += "\t\t\t\"name\": \"" + escapeJSON(r.name) + "\",\n";
+
+		if (!r.error.empty())
+		{
+			json += "\t\t\t\"error\": \"" + escapeJSON(r.error) + "\"\n";
+			json += "\t\t}";
+			continue;
+		}
+
+		double throughput = r.p50 > 0.0 ? r.items * 1.0e9 / r.p50 : 0.0;
+
+		json += "\t\t\t\"unit\": \"" + escapeJSON(r.unit) + "\",\n";
+		json += "\t\t\t\"items_per_iteration\": " + formatNumber(r.items) + ",\n";
+		json += "\t\t\t\"samples\": " + std::to_string(r.samples) + ",\n";
+		json += "\t\t\t\"iterations_per_sample\": " + std::to_string(r.iterationsPerSample) + ",\n";
+		json += "\t\t\t\"ns_per_iteration\": {";
+		json += "\"min\": " + formatNumber(r.min);
+		json += ", \"mean\": " + formatNumber(r.mean);
+		json += ", \"p50\": " + formatNumber(r.p50);
+		json += ", \"p90\": " + formatNumber(r.p90);
+		json += ", \"p99\": " + formatNumber(r.p99);
+		json += ", \"max\": " + formatNumber(r.max) + "},\n";
+		json += "\t\t\t\"items_per_second\": " + formatNumber(throughput) + "\n";
+		json += "\t\t}";
+	}
+
+	json += "\n\t]\n}\n";
+	return json;
+}
+
+} // bench
+} // love
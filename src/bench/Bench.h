@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_BENCH_BENCH_H
+#define LOVE_BENCH_BENCH_H
+
+// LOVE
+#include "common/int.h"
+
+// C++
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace love
+{
+namespace bench
+{
+
+/**
+ * A single microbenchmark. Each call to run() performs one iteration of the
+ * measured work, which processes 'items' units of 'unit' (vertices, bytes,
+ * particles, ...). The items are only used to report throughput.
+ **/
+struct Case
+{
+	std::string name;
+	std::string unit;
+	double items;
+	std::function<void()> run;
+};
+
+/**
+ * Timings of a Case. All times are in nanoseconds per iteration.
+ **/
+struct Result
+{
+	std::string name;
+	std::string unit;
+	double items;
+
+	int samples;
+	int64 iterationsPerSample;
+
+	double min;
+	double mean;
+	double p50;
+	double p90;
+	double p99;
+	double max;
+
+	std::string error;
+};
+
+class Suite
+{
+public:
+
+	Suite();
+
+	void add(const std::string &name, const std::string &unit, double items, const std::function<void()> &run);
+
+	const std::vector<Case> &getCases() const;
+
+	/**
+	 * Times a Case. The number of iterations per sample is calibrated so each
+	 * sample takes roughly sampleTime seconds, which keeps timer resolution
+	 * out of the results for very short cases.
+	 **/
+	Result run(const Case &c, int samples, double sampleTime) const;
+
+	static std::string toJSON(const std::vector<Result> &results);
+
+private:
+
+	std::vector<Case> cases;
+
+}; // Suite
+
+/**
+ * Keeps the compiler from optimizing away work whose result is otherwise
+ * unused.
+ **/
+void consume(uint64 value);
+void consume(const void *ptr);
+
+// Each of these registers the benchmarks for one subsystem.
+void addMathBenchmarks(Suite &suite);
+void addDataBenchmarks(Suite &suite);
+void addImageBenchmarks(Suite &suite);
+void addFontBenchmarks(Suite &suite);
+void addGraphicsBenchmarks(Suite &suite);
+void addThreadBenchmarks(Suite &suite);
+void addPhysicsBenchmarks(Suite &suite);
+void addLuaBenchmarks(Suite &suite);
+
+} // bench
+} // love
+
+#endif // LOVE_BENCH_BENCH_H
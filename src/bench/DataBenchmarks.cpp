@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "data/Compressor.h"
+#include "data/HashFunction.h"
+
+// C++
+#include <memory>
+#include <vector>
+
+namespace love
+{
+namespace bench
+{
+
+static const size_t DATA_SIZE = 1024 * 1024;
+
+// Text-like data which compresses reasonably, so the compressors aren't
+// benchmarked on either trivial or incompressible input.
+static std::shared_ptr<std::vector<char>> createInput()
+{
+	static const char *words[] = {
+		"love", "graphics", "draw", "update", "particle", "sprite", "batch",
+		"mesh", "shader", "canvas", "audio", "source", "thread", "channel",
+		"physics", "world", "body", "fixture", "the", "a", "of", "and",
+	};
+
+	const int wordcount = (int) (sizeof(words) / sizeof(words[0]));
+
+	auto input = std::make_shared<std::vector<char>>();
+	input->reserve(DATA_SIZE);
+
+	uint32 seed = 0x12345678;
+	while (input->size() < DATA_SIZE)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		const char *word = words[(seed >> 16) % wordcount];
+
+		for (const char *c = word; *c != '\0' && input->size() < DATA_SIZE; c++)
+			input->push_back(*c);
+
+		if (input->size() < DATA_SIZE)
+			input->push_back((seed & 0xF) == 0 ? '\n' : ' ');
+	}
+
+	return input;
+}
+
+static void addCompressor(Suite &suite, const std::shared_ptr<std::vector<char>> &input, data::Compressor::Format format)
+{
+	const char *formatname = nullptr;
+	data::Compressor::getConstant(format, formatname);
+
+	data::Compressor *compressor = data::Compressor::getCompressor(format);
+	if (compressor == nullptr)
+		return;
+
+	size_t compressedsize = 0;
+	char *compressedbytes = compressor->compress(format, input->data(), input->size(), -1, compressedsize);
+
+	auto compressed = std::make_shared<std::vector<char>>(compressedbytes, compressedbytes + compressedsize);
+	delete[] compressedbytes;
+
+	suite.add(std::string("data.compress.") + formatname, "bytes", (double) input->size(), [=]()
+	{
+		size_t size = 0;
+		char *bytes = compressor->compress(format, input->data(), input->size(), -1, size);
+		consume((uint64) size);
+		delete[] bytes;
+	});
+
+	suite.add(std::string("data.decompress.") + formatname, "bytes", (double) input->size(), [=]()
+	{
+		size_t size = input->size();
+		char *bytes = compressor->decompress(format, compressed->data(), compressed->size(), size);
+		consume((uint64) size);
+		delete[] bytes;
+	});
+}
+
+static void addHashFunction(Suite &suite, const std::shared_ptr<std::vector<char>> &input, data::HashFunction::Function function)
+{
+	const char *functionname = nullptr;
+	data::HashFunction::getConstant(function, functionname);
+
+	data::HashFunction *hashfunction = data::HashFunction::getHashFunction(function);
+	if (hashfunction == nullptr)
+		return;
+
+	suite.add(std::string("data.hash.") + functionname, "bytes", (double) input->size(), [=]()
+	{
+		data::HashFunction::Value value;
+		hashfunction->hash(function, input->data(), input->size(), value);
+		consume((uint64) (uint8) value.data[0]);
+	});
+}
+
+void addDataBenchmarks(Suite &suite)
+{
+	auto input = createInput();
+
+	for (int i = 0; i < (int) data::Compressor::FORMAT_MAX_ENUM; i++)
+		addCompressor(suite, input, (data::Compressor::Format) i);
+
+	for (int i = 0; i < (int) data::HashFunction::FUNCTION_MAX_ENUM; i++)
+		addHashFunction(suite, input, (data::HashFunction::Function) i);
+}
+
+} // bench
+} // love
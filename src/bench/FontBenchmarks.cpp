@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Module.h"
+#include "font/freetype/Font.h"
+#include "graphics/Font.h"
+#include "libraries/utf8/utf8.h"
+
+// C++
+#include <cmath>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace love
+{
+namespace bench
+{
+
+static const char *PARAGRAPH =
+	"LOVE is an *awesome* framework you can use to make 2D games in Lua. It's free, "
+	"open-source, and works on Windows, macOS, Linux, Android and iOS. Whereas "
+	"Text objects cache their layout, printing a string or measuring its width "
+	"walks every codepoint, looks up its glyph and applies kerning between pairs. "
+	"Äpfel, Übergrößen und naïve façades exercise the multi-byte decoding path.\n";
+
+/**
+ * Runs graphics::Font's layout code, with glyph spacing and kerning caches
+ * like the ones graphics::Font keeps, but without the glyph textures which
+ * need a graphics context.
+ **/
+class HeadlessLayout
+{
+public:
+
+	HeadlessLayout(font::Rasterizer *rasterizer)
+		: rasterizer(rasterizer)
+	{
+	}
+
+	int getWidth(const std::string &str)
+	{
+		return graphics::Font::getWidth(str,
+			[this](uint32 glyph) { return getSpacing(glyph); },
+			[this](uint32 left, uint32 right) { return getKerning(left, right); });
+	}
+
+private:
+
+	int getSpacing(uint32 glyph)
+	{
+		const auto it = spacing.find(glyph);
+		if (it != spacing.end())
+			return it->second;
+
+		StrongRef<font::GlyphData> gd(rasterizer->getGlyphData(glyph), Acquire::NORETAIN);
+		int s = (int) floorf(gd->getAdvance() / rasterizer->getDPIScale() + 0.5f);
+
+		spacing[glyph] = s;
+		return s;
+	}
+
+	float getKerning(uint32 leftglyph, uint32 rightglyph)
+	{
+		uint64 packedglyphs = ((uint64) leftglyph << 32) | (uint64) rightglyph;
+
+		const auto it = kerning.find(packedglyphs);
+		if (it != kerning.end())
+			return it->second;
+
+		float k = floorf(rasterizer->getKerning(leftglyph, rightglyph) / rasterizer->getDPIScale() + 0.5f);
+
+		kerning[packedglyphs] = k;
+		return k;
+	}
+
+	StrongRef<font::Rasterizer> rasterizer;
+
+	std::unordered_map<uint32, int> spacing;
+	std::unordered_map<uint64, float> kerning;
+
+}; // HeadlessLayout
+
+void addFontBenchmarks(Suite &suite)
+{
+	// Modules stay alive for the whole run, as they do in love itself.
+	font::Font *fontmodule = new font::freetype::Font();
+	Module::registerInstance(fontmodule);
+
+	StrongRef<font::Rasterizer> rasterizer(fontmodule->newTrueTypeRasterizer(14, 1.0f, font::TrueTypeRasterizer::HINTING_NORMAL), Acquire::NORETAIN);
+
+	suite.add("font.Rasterizer.getGlyphData.ascii", "glyphs", 95, [rasterizer]()
+	{
+		for (uint32 glyph = 32; glyph < 127; glyph++)
+		{
+			StrongRef<font::GlyphData> gd(rasterizer->getGlyphData(glyph), Acquire::NORETAIN);
+			consume(gd->getData());
+		}
+	});
+
+	auto layout = std::make_shared<HeadlessLayout>(rasterizer);
+	std::string paragraph = PARAGRAPH;
+	double codepoints = (double) utf8::distance(paragraph.begin(), paragraph.end());
+
+	// Warm the caches, so this measures the steady state of a game which
+	// keeps drawing text with the same Font.
+	layout->getWidth(paragraph);
+
+	suite.add("font.layout.getWidth", "codepoints", codepoints, [layout, paragraph]()
+	{
+		consume((uint64) layout->getWidth(paragraph));
+	});
+}
+
+} // bench
+} // love
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "graphics/ParticleSystem.h"
+#include "graphics/Texture.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace bench
+{
+
+/**
+ * A Texture with dimensions but no GPU resource, for objects which only need
+ * a texture's size and quad outside of drawing.
+ **/
+class HeadlessTexture : public graphics::Texture
+{
+public:
+
+	HeadlessTexture(int w, int h)
+		: graphics::Texture(graphics::TEXTURE_2D)
+	{
+		format = PIXELFORMAT_RGBA8;
+		width = pixelWidth = w;
+		height = pixelHeight = h;
+		initQuad();
+	}
+
+	bool setWrap(const Wrap &w) override
+	{
+		wrap = w;
+		return true;
+	}
+
+	bool setMipmapSharpness(float sharpness) override
+	{
+		mipmapSharpness = sharpness;
+		return true;
+	}
+
+	ptrdiff_t getHandle() const override
+	{
+		return 0;
+	}
+
+}; // HeadlessTexture
+
+static void addParticleSystemUpdate(Suite &suite, uint32 count)
+{
+	StrongRef<graphics::Texture> texture(new HeadlessTexture(32, 32), Acquire::NORETAIN);
+	StrongRef<graphics::ParticleSystem> ps(new graphics::ParticleSystem(texture, count), Acquire::NORETAIN);
+
+	ps->setParticleLifetime(1.0f, 2.0f);
+	ps->setEmissionRate((float) count);
+	ps->setEmissionArea(graphics::ParticleSystem::DISTRIBUTION_UNIFORM, 100.0f, 100.0f, 0.0f, false);
+	ps->setSpeed(50.0f, 200.0f);
+	ps->setSpread((float) (2.0 * LOVE_M_PI));
+	ps->setLinearAcceleration(-10.0f, 20.0f, 10.0f, 40.0f);
+	ps->setRadialAcceleration(-5.0f, 5.0f);
+	ps->setTangentialAcceleration(-5.0f, 5.0f);
+	ps->setLinearDamping(0.1f, 0.5f);
+	ps->setSizes({0.5f, 1.0f, 1.5f, 0.25f});
+	ps->setSpin(-1.0f, 1.0f);
+	ps->setColor({Colorf(1.0f, 1.0f, 1.0f, 1.0f), Colorf(1.0f, 0.5f, 0.0f, 0.5f), Colorf(0.2f, 0.2f, 0.2f, 0.0f)});
+	ps->start();
+
+	// Run it into its steady state, where particles die and spawn each frame.
+	for (int i = 0; i < 180; i++)
+		ps->update(1.0f / 60.0f);
+
+	suite.add("graphics.ParticleSystem.update." + std::to_string(count), "particles", count, [ps]()
+	{
+		ps->update(1.0f / 60.0f);
+		consume((uint64) ps->getCount());
+	});
+}
+
+void addGraphicsBenchmarks(Suite &suite)
+{
+	addParticleSystemUpdate(suite, 1000);
+	addParticleSystemUpdate(suite, 10000);
+}
+
+} // bench
+} // love
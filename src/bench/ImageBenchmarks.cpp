@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Color.h"
+#include "image/ImageData.h"
+
+// C++
+#include <memory>
+
+namespace love
+{
+namespace bench
+{
+
+static const int IMAGE_SIZE = 512;
+
+static StrongRef<image::ImageData> createImageData(PixelFormat format)
+{
+	StrongRef<image::ImageData> data(new image::ImageData(IMAGE_SIZE, IMAGE_SIZE, format), Acquire::NORETAIN);
+
+	for (int y = 0; y < IMAGE_SIZE; y++)
+	{
+		for (int x = 0; x < IMAGE_SIZE; x++)
+		{
+			Colorf c(x / (float) IMAGE_SIZE, y / (float) IMAGE_SIZE, 0.5f, 1.0f);
+			data->setPixel(x, y, c);
+		}
+	}
+
+	return data;
+}
+
+static void addPaste(Suite &suite, PixelFormat srcformat, PixelFormat dstformat)
+{
+	const char *srcname = nullptr;
+	const char *dstname = nullptr;
+	getConstant(srcformat, srcname);
+	getConstant(dstformat, dstname);
+
+	StrongRef<image::ImageData> src = createImageData(srcformat);
+	StrongRef<image::ImageData> dst(new image::ImageData(IMAGE_SIZE, IMAGE_SIZE, dstformat), Acquire::NORETAIN);
+
+	std::string name = std::string("image.ImageData.paste.") + srcname + "_to_" + dstname;
+
+	suite.add(name, "pixels", IMAGE_SIZE * IMAGE_SIZE, [src, dst]()
+	{
+		dst->paste(src, 0, 0, 0, 0, IMAGE_SIZE, IMAGE_SIZE);
+		consume(dst->getData());
+	});
+}
+
+static void addPixelAccess(Suite &suite, PixelFormat format)
+{
+	const char *formatname = nullptr;
+	getConstant(format, formatname);
+
+	StrongRef<image::ImageData> data = createImageData(format);
+
+	suite.add(std::string("image.ImageData.setPixel.") + formatname, "pixels", IMAGE_SIZE * IMAGE_SIZE, [data]()
+	{
+		Colorf c(0.25f, 0.5f, 0.75f, 1.0f);
+		for (int y = 0; y < IMAGE_SIZE; y++)
+		{
+			for (int x = 0; x < IMAGE_SIZE; x++)
+				data->setPixel(x, y, c);
+		}
+		consume(data->getData());
+	});
+
+	suite.add(std::string("image.ImageData.getPixel.") + formatname, "pixels", IMAGE_SIZE * IMAGE_SIZE, [data]()
+	{
+		float sum = 0.0f;
+		Colorf c;
+		for (int y = 0; y < IMAGE_SIZE; y++)
+		{
+			for (int x = 0; x < IMAGE_SIZE; x++)
+			{
+				data->getPixel(x, y, c);
+				sum += c.r;
+			}
+		}
+		consume((uint64) sum);
+	});
+}
+
+void addImageBenchmarks(Suite &suite)
+{
+	addPaste(suite, PIXELFORMAT_RGBA8, PIXELFORMAT_RGBA8);
+	addPaste(suite, PIXELFORMAT_RGBA8, PIXELFORMAT_RGBA16);
+	addPaste(suite, PIXELFORMAT_RGBA8, PIXELFORMAT_RGBA32F);
+	addPaste(suite, PIXELFORMAT_RGBA32F, PIXELFORMAT_RGBA8);
+	addPaste(suite, PIXELFORMAT_RGBA16F, PIXELFORMAT_RGBA8);
+
+	addPixelAccess(suite, PIXELFORMAT_RGBA8);
+	addPixelAccess(suite, PIXELFORMAT_RGBA16F);
+	addPixelAccess(suite, PIXELFORMAT_RGBA32F);
+}
+
+} // bench
+} // love
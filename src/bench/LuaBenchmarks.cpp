@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Object.h"
+#include "common/runtime.h"
+
+// C++
+#include <memory>
+#include <vector>
+
+namespace love
+{
+namespace bench
+{
+
+static const int OBJECT_COUNT = 1000;
+
+class BenchObject : public Object
+{
+public:
+
+	static love::Type type;
+
+}; // BenchObject
+
+love::Type BenchObject::type("BenchObject", &Object::type);
+
+struct LuaState
+{
+	lua_State *L;
+	std::vector<StrongRef<BenchObject>> objects;
+
+	LuaState()
+		: L(luaL_newstate())
+	{
+		luaL_openlibs(L);
+		luax_register_type(L, &BenchObject::type, nullptr);
+
+		for (int i = 0; i < OBJECT_COUNT; i++)
+			objects.emplace_back(new BenchObject(), Acquire::NORETAIN);
+	}
+
+	~LuaState()
+	{
+		lua_close(L);
+	}
+
+}; // LuaState
+
+void addLuaBenchmarks(Suite &suite)
+{
+	auto state = std::make_shared<LuaState>();
+
+	// Objects which already have a Proxy in the state, which is the common
+	// case for objects returned by getters every frame.
+	lua_createtable(state->L, OBJECT_COUNT, 0);
+	for (int i = 0; i < OBJECT_COUNT; i++)
+	{
+		luax_pushtype(state->L, state->objects[i].get());
+		lua_rawseti(state->L, -2, i + 1);
+	}
+	lua_setfield(state->L, LUA_REGISTRYINDEX, "_lovebenchobjects");
+
+	suite.add("lua.luax_pushtype.existing", "objects", OBJECT_COUNT, [state]()
+	{
+		lua_State *L = state->L;
+		for (BenchObject *object : state->objects)
+		{
+			luax_pushtype(L, object);
+			lua_pop(L, 1);
+		}
+	});
+
+	suite.add("lua.luax_checktype", "objects", OBJECT_COUNT, [state]()
+	{
+		lua_State *L = state->L;
+		lua_getfield(L, LUA_REGISTRYINDEX, "_lovebenchobjects");
+		for (int i = 1; i <= OBJECT_COUNT; i++)
+		{
+			lua_rawgeti(L, -1, i);
+			consume(luax_checktype<BenchObject>(L, -1));
+			lua_pop(L, 1);
+		}
+		lua_pop(L, 1);
+	});
+
+	// A separate state, since the Proxies have to be collected between
+	// iterations for every push to create a new one. Includes the GC.
+	auto newstate = std::make_shared<LuaState>();
+
+	suite.add("lua.luax_pushtype.new", "objects", OBJECT_COUNT, [newstate]()
+	{
+		lua_State *L = newstate->L;
+		for (BenchObject *object : newstate->objects)
+		{
+			luax_pushtype(L, object);
+			lua_pop(L, 1);
+		}
+		lua_gc(L, LUA_GCCOLLECT, 0);
+	});
+}
+
+} // bench
+} // love
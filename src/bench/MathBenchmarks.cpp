@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Matrix.h"
+#include "common/Vector.h"
+#include "graphics/vertex.h"
+#include "math/MathModule.h"
+
+// C++
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace love
+{
+namespace bench
+{
+
+static const int TRANSFORM_VERTEX_COUNT = 4096;
+
+template <typename Vdst>
+static void addTransformXY(Suite &suite, const std::string &name)
+{
+	struct State
+	{
+		Matrix4 m;
+		std::vector<Vector2> src;
+		std::vector<Vdst> dst;
+	};
+
+	auto state = std::make_shared<State>();
+	state->m = Matrix4(100.0f, 50.0f, 0.5f, 2.0f, 1.5f, 16.0f, 16.0f, 0.0f, 0.0f);
+	state->src.resize(TRANSFORM_VERTEX_COUNT);
+	state->dst.resize(TRANSFORM_VERTEX_COUNT);
+
+	for (int i = 0; i < TRANSFORM_VERTEX_COUNT; i++)
+		state->src[i] = Vector2((float) (i % 64), (float) (i / 64));
+
+	suite.add(name, "vertices", TRANSFORM_VERTEX_COUNT, [state]()
+	{
+		state->m.transformXY(state->dst.data(), state->src.data(), TRANSFORM_VERTEX_COUNT);
+		consume(state->dst.data());
+	});
+}
+
+static void addTransformXYInPlace(Suite &suite)
+{
+	// Text transforms its glyph vertices in place.
+	typedef graphics::vertex::XYf_STus_RGBAub GlyphVertex;
+
+	struct State
+	{
+		Matrix4 m;
+		std::vector<GlyphVertex> vertices;
+	};
+
+	auto state = std::make_shared<State>();
+
+	// Close to the identity so repeated transforms stay finite.
+	state->m = Matrix4(0.0f, 0.0f, 0.001f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+	state->vertices.resize(TRANSFORM_VERTEX_COUNT);
+
+	for (int i = 0; i < TRANSFORM_VERTEX_COUNT; i++)
+	{
+		state->vertices[i].x = (float) (i % 64);
+		state->vertices[i].y = (float) (i / 64);
+	}
+
+	suite.add("math.Matrix4.transformXY.GlyphVertex", "vertices", TRANSFORM_VERTEX_COUNT, [state]()
+	{
+		state->m.transformXY(state->vertices.data(), state->vertices.data(), TRANSFORM_VERTEX_COUNT);
+		consume(state->vertices.data());
+	});
+}
+
+static void addMatrix3TransformXY(Suite &suite)
+{
+	// The same work ParticleSystem::draw does for each particle.
+	const int quadcount = TRANSFORM_VERTEX_COUNT / 4;
+
+	struct State
+	{
+		Vector2 positions[4];
+		std::vector<graphics::vertex::XYf_STf_RGBAub> dst;
+	};
+
+	auto state = std::make_shared<State>();
+	state->positions[0] = Vector2(0.0f, 0.0f);
+	state->positions[1] = Vector2(0.0f, 32.0f);
+	state->positions[2] = Vector2(32.0f, 32.0f);
+	state->positions[3] = Vector2(32.0f, 0.0f);
+	state->dst.resize(quadcount * 4);
+
+	suite.add("math.Matrix3.transformXY.particles", "vertices", quadcount * 4, [state, quadcount]()
+	{
+		Matrix3 t;
+		auto dst = state->dst.data();
+
+		for (int i = 0; i < quadcount; i++)
+		{
+			t.setTransformation((float) i, (float) i, i * 0.01f, 1.0f, 1.0f, 16.0f, 16.0f, 0.0f, 0.0f);
+			t.transformXY(dst + i * 4, state->positions, 4);
+		}
+
+		consume(dst);
+	});
+}
+
+static void addTriangulate(Suite &suite, int vertexcount)
+{
+	// A star-shaped (concave) polygon.
+	auto polygon = std::make_shared<std::vector<Vector2>>();
+
+	for (int i = 0; i < vertexcount; i++)
+	{
+		float angle = (float) (2.0 * LOVE_M_PI * i / vertexcount);
+		float radius = (i % 2) == 0 ? 100.0f : 40.0f;
+		polygon->push_back(Vector2(cosf(angle) * radius, sinf(angle) * radius));
+	}
+
+	suite.add("math.triangulate." + std::to_string(vertexcount), "polygons", 1, [polygon]()
+	{
+		std::vector<math::Triangle> triangles = math::triangulate(*polygon);
+		consume((uint64) triangles.size());
+	});
+}
+
+void addMathBenchmarks(Suite &suite)
+{
+	addTransformXY<Vector2>(suite, "math.Matrix4.transformXY.Vector2");
+	addTransformXY<graphics::vertex::XYf_STf_RGBAub>(suite, "math.Matrix4.transformXY.XYf_STf_RGBAub");
+	addTransformXYInPlace(suite);
+	addMatrix3TransformXY(suite);
+
+	addTriangulate(suite, 16);
+	addTriangulate(suite, 256);
+}
+
+} // bench
+} // love
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Module.h"
+#include "physics/box2d/Physics.h"
+
+namespace love
+{
+namespace bench
+{
+
+using namespace love::physics::box2d;
+
+static void addStatic(Physics *physics, World *world, float x, float y, float w, float h)
+{
+	Body *body = physics->newBody(world, x, y, Body::BODY_STATIC);
+	PolygonShape *shape = physics->newRectangleShape(w, h);
+	Fixture *fixture = physics->newFixture(body, shape, 1.0f);
+
+	// The World keeps Bodies and Fixtures alive until it's destroyed.
+	fixture->release();
+	shape->release();
+	body->release();
+}
+
+static void addWorldUpdate(Suite &suite, Physics *physics, int count)
+{
+	const float size = 16.0f;
+	const int columns = 32;
+	const float width = columns * size * 1.5f;
+
+	StrongRef<World> world(physics->newWorld(0.0f, 9.81f * 64.0f, false), Acquire::NORETAIN);
+
+	addStatic(physics, world, width * 0.5f, width, width, size);
+	addStatic(physics, world, 0.0f, width * 0.5f, size, width);
+	addStatic(physics, world, width, width * 0.5f, size, width);
+
+	for (int i = 0; i < count; i++)
+	{
+		float x = size + (i % columns) * size * 1.4f;
+		float y = width - size * 2.0f - (i / columns) * size * 1.4f;
+
+		Body *body = physics->newBody(world, x, y, Body::BODY_DYNAMIC);
+
+		Shape *shape = nullptr;
+		if (i % 2 == 0)
+			shape = physics->newRectangleShape(size, size);
+		else
+			shape = physics->newCircleShape(size * 0.5f);
+
+		Fixture *fixture = physics->newFixture(body, shape, 1.0f);
+
+		fixture->release();
+		shape->release();
+		body->release();
+	}
+
+	// Let the bodies settle, so the benchmark measures a resting pile with
+	// persistent contacts rather than the initial fall. Sleeping is disabled
+	// so every body stays simulated.
+	for (int i = 0; i < 120; i++)
+		world->update(1.0f / 60.0f);
+
+	suite.add("physics.World.update." + std::to_string(count), "bodies", count, [world]()
+	{
+		world->update(1.0f / 60.0f);
+		consume((uint64) world->getBodyCount());
+	});
+}
+
+void addPhysicsBenchmarks(Suite &suite)
+{
+	// Modules stay alive for the whole run, as they do in love itself.
+	Physics *physics = new Physics();
+	Module::registerInstance(physics);
+
+	physics->setMeter(64);
+
+	addWorldUpdate(suite, physics, 256);
+	addWorldUpdate(suite, physics, 1024);
+}
+
+} // bench
+} // love
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/Variant.h"
+#include "thread/Channel.h"
+#include "thread/threads.h"
+
+// C++
+#include <memory>
+#include <string>
+
+namespace love
+{
+namespace bench
+{
+
+static const int MESSAGE_COUNT = 1000;
+
+typedef std::function<Variant(int)> MessageFunction;
+
+static void addPushPop(Suite &suite, const std::string &name, const MessageFunction &message)
+{
+	StrongRef<thread::Channel> channel(new thread::Channel(), Acquire::NORETAIN);
+
+	suite.add("thread.Channel.push_pop." + name, "messages", MESSAGE_COUNT, [channel, message]()
+	{
+		for (int i = 0; i < MESSAGE_COUNT; i++)
+			channel->push(message(i));
+
+		Variant v;
+		while (channel->pop(&v))
+			consume((uint64) v.getType());
+	});
+}
+
+class Producer : public thread::Threadable
+{
+public:
+
+	Producer(thread::Channel *channel, int count)
+		: channel(channel)
+		, count(count)
+	{
+		threadName = "BenchProducer";
+	}
+
+	void threadFunction() override
+	{
+		for (int i = 0; i < count; i++)
+			channel->push(Variant((double) i));
+	}
+
+private:
+
+	StrongRef<thread::Channel> channel;
+	int count;
+
+}; // Producer
+
+static void addProducerConsumer(Suite &suite)
+{
+	// Includes the cost of starting the producer thread, which is small
+	// compared to the messages.
+	const int count = MESSAGE_COUNT * 10;
+
+	StrongRef<thread::Channel> channel(new thread::Channel(), Acquire::NORETAIN);
+
+	suite.add("thread.Channel.producer_consumer.number", "messages", count, [channel, count]()
+	{
+		StrongRef<Producer> producer(new Producer(channel, count), Acquire::NORETAIN);
+		producer->start();
+
+		Variant v;
+		for (int i = 0; i < count; i++)
+			channel->demand(&v);
+
+		producer->wait();
+	});
+}
+
+void addThreadBenchmarks(Suite &suite)
+{
+	addPushPop(suite, "number", [](int i)
+	{
+		return Variant((double) i);
+	});
+
+	addPushPop(suite, "string", [](int)
+	{
+		static const std::string str(64, 'x');
+		return Variant(str);
+	});
+
+	addPushPop(suite, "table", [](int i)
+	{
+		auto table = new std::vector<std::pair<Variant, Variant>>();
+		table->reserve(8);
+		for (int j = 1; j <= 8; j++)
+			table->emplace_back(Variant((double) j), Variant((double) (i + j)));
+		return Variant(table);
+	});
+
+	addProducerConsumer(suite);
+}
+
+} // bench
+} // love
@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Bench.h"
+#include "common/config.h"
+
+// C++
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef LOVE_WINDOWS
+#include <windows.h>
+#endif
+
+using namespace love::bench;
+
+static void printUsage(const char *argv0)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"\n"
+		"Runs LOVE's CPU-side microbenchmarks and prints the results as JSON.\n"
+		"\n"
+		"Options:\n"
+		"  --list               List the benchmarks and exit.\n"
+		"  --filter <text>      Only run benchmarks whose name contains <text>.\n"
+		"  --samples <n>        Number of timed samples per benchmark (default 30).\n"
+		"  --sample-time <ms>   Approximate duration of each sample (default 10).\n"
+		"  --output <file>      Write the JSON to <file> instead of stdout.\n",
+		argv0);
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<std::string> filters;
+	int samples = 30;
+	double sampleTime = 0.010;
+	const char *output = nullptr;
+	bool list = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		bool hasvalue = i + 1 < argc;
+
+		if (strcmp(arg, "--list") == 0)
+			list = true;
+		else if (strcmp(arg, "--filter") == 0 && hasvalue)
+			filters.push_back(argv[++i]);
+		else if (strcmp(arg, "--samples") == 0 && hasvalue)
+			samples = std::max(atoi(argv[++i]), 1);
+		else if (strcmp(arg, "--sample-time") == 0 && hasvalue)
+			sampleTime = std::max(atof(argv[++i]), 0.001) / 1000.0;
+		else if (strcmp(arg, "--output") == 0 && hasvalue)
+			output = argv[++i];
+		else
+		{
+			printUsage(argv[0]);
+			return strcmp(arg, "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	// Nothing here needs an audio device, but make sure OpenAL Soft never
+	// opens a real one if a benchmark ends up touching it.
+#ifdef LOVE_WINDOWS
+	_putenv_s("ALSOFT_DRIVERS", "null");
+#else
+	setenv("ALSOFT_DRIVERS", "null", 1);
+#endif
+
+	Suite suite;
+
+	try
+	{
+		addMathBenchmarks(suite);
+		addDataBenchmarks(suite);
+		addImageBenchmarks(suite);
+		addFontBenchmarks(suite);
+		addGraphicsBenchmarks(suite);
+		addThreadBenchmarks(suite);
+		addPhysicsBenchmarks(suite);
+		addLuaBenchmarks(suite);
+	}
+	catch (std::exception &e)
+	{
+		fprintf(stderr, "Error setting up benchmarks: %s\n", e.what());
+		return 1;
+	}
+
+	std::vector<Result> results;
+
+	for (const Case &c : suite.getCases())
+	{
+		bool matches = filters.empty();
+		for (const std::string &filter : filters)
+			matches = matches || c.name.find(filter) != std::string::npos;
+
+		if (!matches)
+			continue;
+
+		if (list)
+		{
+			printf("%s\n", c.name.c_str());
+			continue;
+		}
+
+		fprintf(stderr, "%s... ", c.name.c_str());
+		fflush(stderr);
+
+		Result r = suite.run(c, samples, sampleTime);
+		results.push_back(r);
+
+		if (r.error.empty())
+			fprintf(stderr, "%.1f ns (p50)\n", r.p50);
+		else
+			fprintf(stderr, "error: %s\n", r.error.c_str());
+	}
+
+	if (list)
+		return 0;
+
+	std::string json = Suite::toJSON(results);
+
+	FILE *file = output != nullptr ? fopen(output, "wb") : stdout;
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Could not open %s for writing.\n", output);
+		return 1;
+	}
+
+	fwrite(json.data(), 1, json.size(), file);
+
+	if (file != stdout)
+		fclose(file);
+
+	for (const Result &r : results)
+	{
+		if (!r.error.empty())
+			return 1;
+	}
+
+	return 0;
+}
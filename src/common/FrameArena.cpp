@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "FrameArena.h"
+#include "memory.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+
+// Needed because std::max takes it by reference.
+const size_t FrameArena::MAX_RETAINED_SIZE;
+
+FrameArena::FrameArena(size_t blocksize)
+	: blockSize(blocksize)
+	, currentBlock(0)
+	, offset(0)
+	, lastOffset(0)
+	, allocationCount(0)
+	, allocatedSize(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+	for (const Block &block : blocks)
+		alignedFree(block.memory);
+}
+
+void FrameArena::addBlock(size_t size)
+{
+	void *mem = nullptr;
+	if (!alignedMalloc(&mem, size, DEFAULT_ALIGNMENT))
+		throw std::bad_alloc();
+
+	Block block = {(uint8 *) mem, size};
+	blocks.push_back(block);
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment)
+{
+	allocationCount++;
+	allocatedSize += size;
+
+	size = std::max(size, (size_t) 1);
+
+	// Find the first block from the current one which has enough space.
+	while (currentBlock < blocks.size())
+	{
+		const Block &block = blocks[currentBlock];
+		size_t start = alignUp((size_t) block.memory + offset, alignment) - (size_t) block.memory;
+
+		if (start + size <= block.size)
+		{
+			lastOffset = start;
+			offset = start + size;
+			return block.memory + start;
+		}
+
+		currentBlock++;
+		offset = 0;
+	}
+
+	addBlock(std::max(blockSize, alignUp(size, DEFAULT_ALIGNMENT) + alignment));
+	currentBlock = blocks.size() - 1;
+
+	const Block &block = blocks[currentBlock];
+	size_t start = alignUp((size_t) block.memory, alignment) - (size_t) block.memory;
+
+	lastOffset = start;
+	offset = start + size;
+	return block.memory + start;
+}
+
+void FrameArena::deallocate(void *mem, size_t size)
+{
+	if (mem == nullptr || currentBlock >= blocks.size())
+		return;
+
+	uint8 *top = blocks[currentBlock].memory + lastOffset;
+
+	if (mem == top && lastOffset + std::max(size, (size_t) 1) == offset)
+	{
+		offset = lastOffset;
+		allocatedSize -= size;
+	}
+}
+
+void FrameArena::reset()
+{
+	rewind();
+
+	allocationCount = 0;
+	allocatedSize = 0;
+}
+
+void FrameArena::rewind()
+{
+	size_t total = getCapacity();
+	size_t maxsize = std::max(blockSize, MAX_RETAINED_SIZE);
+
+	if (blocks.size() > 1 || total > maxsize)
+	{
+		for (const Block &block : blocks)
+			alignedFree(block.memory);
+
+		blocks.clear();
+		addBlock(std::min(total, maxsize));
+	}
+
+	currentBlock = 0;
+	offset = 0;
+	lastOffset = 0;
+}
+
+size_t FrameArena::getCapacity() const
+{
+	size_t total = 0;
+	for (const Block &block : blocks)
+		total += block.size;
+	return total;
+}
+
+} // love
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "int.h"
+
+// C++
+#include <vector>
+#include <new>
+#include <stddef.h>
+
+namespace love
+{
+
+/**
+ * A bump allocator for short-lived memory, such as temporary vertex arrays
+ * which are only needed until the end of the current frame. Allocations are
+ * only freed when the arena is reset, except for the most recent one.
+ *
+ * Not thread-safe; each arena must only be used by one thread.
+ **/
+class FrameArena
+{
+public:
+
+	static const size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+	static const size_t DEFAULT_ALIGNMENT = 16;
+
+	// The most memory reset() keeps around for later allocations. Anything
+	// past this is freed.
+	static const size_t MAX_RETAINED_SIZE = 4 * 1024 * 1024;
+
+	FrameArena(size_t blocksize = DEFAULT_BLOCK_SIZE);
+	~FrameArena();
+
+	void *allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+
+	/**
+	 * Returns the memory to the arena if it's the most recent allocation,
+	 * otherwise does nothing until the next reset.
+	 **/
+	void deallocate(void *mem, size_t size);
+
+	/**
+	 * Frees all allocations at once. Memory from any previous allocation must
+	 * not be used afterward. If the arena had to grow, its blocks are
+	 * combined into one large enough for the same amount of memory, up to
+	 * MAX_RETAINED_SIZE.
+	 **/
+	void reset();
+
+	/**
+	 * Same as reset(), except allocations keep counting toward
+	 * getAllocationCount and getAllocatedSize.
+	 **/
+	void rewind();
+
+	// Since the last reset.
+	int getAllocationCount() const { return allocationCount; }
+	int64 getAllocatedSize() const { return allocatedSize; }
+
+	size_t getCapacity() const;
+
+private:
+
+	struct Block
+	{
+		uint8 *memory;
+		size_t size;
+	};
+
+	FrameArena(const FrameArena &) = delete;
+	FrameArena &operator = (const FrameArena &) = delete;
+
+	void addBlock(size_t size);
+
+	size_t blockSize;
+
+	std::vector<Block> blocks;
+	size_t currentBlock;
+	size_t offset;
+
+	// Start of the most recent allocation in the current block.
+	size_t lastOffset;
+
+	int allocationCount;
+	int64 allocatedSize;
+
+}; // FrameArena
+
+/**
+ * An STL allocator which uses a FrameArena, or the heap when it doesn't have
+ * one. Containers using it can be passed around regardless of where their
+ * memory comes from.
+ **/
+template <typename T>
+class FrameAllocator
+{
+public:
+
+	typedef T value_type;
+
+	FrameAllocator(FrameArena *arena = nullptr) noexcept
+		: arena(arena)
+	{}
+
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U> &other) noexcept
+		: arena(other.getArena())
+	{}
+
+	T *allocate(size_t n)
+	{
+		if (arena != nullptr)
+			return (T *) arena->allocate(n * sizeof(T), alignof(T) > FrameArena::DEFAULT_ALIGNMENT ? alignof(T) : FrameArena::DEFAULT_ALIGNMENT);
+		return (T *) ::operator new(n * sizeof(T));
+	}
+
+	void deallocate(T *p, size_t n)
+	{
+		if (arena != nullptr)
+			arena->deallocate(p, n * sizeof(T));
+		else
+			::operator delete(p);
+	}
+
+	FrameArena *getArena() const noexcept { return arena; }
+
+private:
+
+	FrameArena *arena;
+
+}; // FrameAllocator
+
+template <typename T, typename U>
+inline bool operator == (const FrameAllocator<T> &a, const FrameAllocator<U> &b) noexcept
+{
+	return a.getArena() == b.getArena();
+}
+
+template <typename T, typename U>
+inline bool operator != (const FrameAllocator<T> &a, const FrameAllocator<U> &b) noexcept
+{
+	return a.getArena() != b.getArena();
+}
+
+} // love
@@ -551,4 +551,78 @@ void Matrix3::setTransformation(float x, float y, float angle, float sx, float s
 	e[8] = 1.0f;
 }
 
+void transformAffine2D(float a, float b, float c, float d, float tx, float ty,
+                       float *dst, size_t dststride, const float *src, size_t srcstride, int count)
+{
+	int i = 0;
+
+	// Two vertices are processed per iteration: [x0 y0 x1 y1] is multiplied by
+	// [a d a d], its pairwise-swapped form [y0 x0 y1 x1] by [c b c b], and the
+	// translation is added. Each pair is loaded before it's stored, so src and
+	// dst may alias.
+#if defined(LOVE_SIMD_SSE)
+
+	const __m128 mxy = _mm_setr_ps(a, d, a, d);
+	const __m128 myx = _mm_setr_ps(c, b, c, b);
+	const __m128 t = _mm_setr_ps(tx, ty, tx, ty);
+
+	for (; i + 2 <= count; i += 2)
+	{
+		const float *s0 = (const float *) ((const char *) src + srcstride * i);
+		const float *s1 = (const float *) ((const char *) s0 + srcstride);
+		float *d0 = (float *) ((char *) dst + dststride * i);
+		float *d1 = (float *) ((char *) d0 + dststride);
+
+		__m128 v = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) s0);
+		v = _mm_loadh_pi(v, (const __m64 *) s1);
+
+		__m128 vs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, mxy), _mm_mul_ps(vs, myx)), t);
+
+		_mm_storel_pi((__m64 *) d0, r);
+		_mm_storeh_pi((__m64 *) d1, r);
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	const float mxyvalues[4] = {a, d, a, d};
+	const float myxvalues[4] = {c, b, c, b};
+	const float tvalues[4] = {tx, ty, tx, ty};
+
+	const float32x4_t mxy = vld1q_f32(mxyvalues);
+	const float32x4_t myx = vld1q_f32(myxvalues);
+	const float32x4_t t = vld1q_f32(tvalues);
+
+	for (; i + 2 <= count; i += 2)
+	{
+		const float *s0 = (const float *) ((const char *) src + srcstride * i);
+		const float *s1 = (const float *) ((const char *) s0 + srcstride);
+		float *d0 = (float *) ((char *) dst + dststride * i);
+		float *d1 = (float *) ((char *) d0 + dststride);
+
+		float32x4_t v = vcombine_f32(vld1_f32(s0), vld1_f32(s1));
+
+		float32x4_t vs = vrev64q_f32(v);
+		float32x4_t r = vaddq_f32(vaddq_f32(vmulq_f32(v, mxy), vmulq_f32(vs, myx)), t);
+
+		vst1_f32(d0, vget_low_f32(r));
+		vst1_f32(d1, vget_high_f32(r));
+	}
+
+#endif
+
+	for (; i < count; i++)
+	{
+		const float *s = (const float *) ((const char *) src + srcstride * i);
+		float *p = (float *) ((char *) dst + dststride * i);
+
+		// Store in temp variables in case src = dst
+		float x = (a*s[0]) + (c*s[1]) + tx;
+		float y = (b*s[0]) + (d*s[1]) + ty;
+
+		p[0] = x;
+		p[1] = y;
+	}
+}
+
 } // love
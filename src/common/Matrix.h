@@ -24,9 +24,37 @@
 // LOVE
 #include "math.h"
 
+// C++
+#include <cstddef>
+#include <type_traits>
+
 namespace love
 {
 
+/**
+ * Applies the 2D affine transform
+ * | a c tx |
+ * | b d ty |
+ * to count vertices whose x and y components are consecutive floats. The
+ * strides are the distances in bytes between consecutive vertices, so x/y can
+ * be embedded in larger vertex structs. Uses SSE or NEON when available. The
+ * source and destination may be the same.
+ **/
+void transformAffine2D(float a, float b, float c, float d, float tx, float ty,
+                       float *dst, size_t dststride, const float *src, size_t srcstride, int count);
+
+/**
+ * Whether the vertex type has float x and y members next to each other, so it
+ * can go through transformAffine2D.
+ **/
+template <typename V>
+inline bool hasPackedFloatXY(const V *v)
+{
+	return std::is_same<decltype(V::x), float>::value
+		&& std::is_same<decltype(V::y), float>::value
+		&& (const char *) &v->y == (const char *) &v->x + sizeof(float);
+}
+
 /**
  * This class is the basis for all transformations in LOVE. Although not really
  * needed for 2D, it contains 4x4 elements to be compatible with OpenGL without
@@ -315,6 +343,13 @@ class Matrix3
 template <typename Vdst, typename Vsrc>
 void Matrix4::transformXY(Vdst *dst, const Vsrc *src, int size) const
 {
+	if (size > 0 && hasPackedFloatXY(dst) && hasPackedFloatXY(src))
+	{
+		transformAffine2D(e[0], e[1], e[4], e[5], e[12], e[13],
+		                  (float *) &dst->x, sizeof(Vdst), (const float *) &src->x, sizeof(Vsrc), size);
+		return;
+	}
+
 	for (int i = 0; i < size; i++)
 	{
 		// Store in temp variables in case src = dst
@@ -376,6 +411,13 @@ void Matrix4::transformXYZ(Vdst *dst, const Vsrc *src, int size) const
 template <typename Vdst, typename Vsrc>
 void Matrix3::transformXY(Vdst *dst, const Vsrc *src, int size) const
 {
+	if (size > 0 && hasPackedFloatXY(dst) && hasPackedFloatXY(src))
+	{
+		transformAffine2D(e[0], e[1], e[3], e[4], e[6], e[7],
+		                  (float *) &dst->x, sizeof(Vdst), (const float *) &src->x, sizeof(Vsrc), size);
+		return;
+	}
+
 	for (int i = 0; i < size; i++)
 	{
 		float x = (e[0]*src[i].x) + (e[3]*src[i].y) + (e[6]);
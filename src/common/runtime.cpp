@@ -193,7 +193,7 @@ static int w__release(lua_State *L)
 			ObjectKey objectkey = luax_computeloveobjectkey(L, object);
 			luax_pushloveobjectkey(L, objectkey);
 			lua_pushnil(L);
-			lua_settable(L, -3);
+			lua_rawset(L, -3);
 		}
 
 		lua_pop(L, 1);
@@ -609,15 +609,8 @@ int luax_register_searcher(lua_State *L, lua_CFunction f, int pos)
 	return 0;
 }
 
-void luax_rawnewtype(lua_State *L, love::Type &type, love::Object *object)
+static void luax_pushnamedmetatable(lua_State *L, love::Type &type)
 {
-	Proxy *u = (Proxy *)lua_newuserdata(L, sizeof(Proxy));
-
-	object->retain();
-
-	u->object = object;
-	u->type = &type;
-
 	const char *name = type.getName();
 	luaL_newmetatable(L, name);
 
@@ -632,10 +625,56 @@ void luax_rawnewtype(lua_State *L, love::Type &type, love::Object *object)
 		lua_pushcfunction(L, w__gc);
 		lua_setfield(L, -2, "__gc");
 	}
+}
+
+/**
+ * Pushes the metatable for Proxies of the given type. The metatable of the
+ * loveobjects table (at the absolute index objectsidx) doubles as a cache of
+ * these, indexed by type id, which is much cheaper than looking them up in
+ * the registry by name. An objectsidx of 0 skips the cache.
+ **/
+static void luax_pushproxymetatable(lua_State *L, love::Type &type, int objectsidx)
+{
+	if (objectsidx == 0 || !lua_getmetatable(L, objectsidx))
+		return luax_pushnamedmetatable(L, type);
+
+	int id = (int) type.getId();
+
+	lua_rawgeti(L, -1, id);
+
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+
+		luax_pushnamedmetatable(L, type);
+
+		// cache[id] = metatable
+		lua_pushvalue(L, -1);
+		lua_rawseti(L, -3, id);
+	}
+
+	// Remove the cache table from the stack.
+	lua_remove(L, -2);
+}
+
+static void luax_newproxy(lua_State *L, love::Type &type, love::Object *object, int objectsidx)
+{
+	Proxy *u = (Proxy *)lua_newuserdata(L, sizeof(Proxy));
+
+	object->retain();
 
+	u->object = object;
+	u->type = &type;
+
+	luax_pushproxymetatable(L, type, objectsidx);
 	lua_setmetatable(L, -2);
 }
 
+void luax_rawnewtype(lua_State *L, love::Type &type, love::Object *object)
+{
+	luax_newproxy(L, type, object, 0);
+}
+
 void luax_pushtype(lua_State *L, love::Type &type, love::Object *object)
 {
 	if (object == nullptr)
@@ -654,28 +693,31 @@ void luax_pushtype(lua_State *L, love::Type &type, love::Object *object)
 		return luax_rawnewtype(L, type, object);
 	}
 
+	int objects = lua_gettop(L);
+
 	ObjectKey objectkey = luax_computeloveobjectkey(L, object);
 
-	// Get the value of loveobjects[object] on the stack.
+	// Get the value of loveobjects[object] on the stack. The table's only
+	// metamethod is __mode, so raw access is safe.
 	luax_pushloveobjectkey(L, objectkey);
-	lua_gettable(L, -2);
+	lua_rawget(L, objects);
 
 	// If the Proxy userdata isn't in the instantiated types table yet, add it.
 	if (lua_type(L, -1) != LUA_TUSERDATA)
 	{
 		lua_pop(L, 1);
 
-		luax_rawnewtype(L, type, object);
+		luax_newproxy(L, type, object, objects);
 
 		luax_pushloveobjectkey(L, objectkey);
 		lua_pushvalue(L, -2);
 
 		// loveobjects[object] = Proxy.
-		lua_settable(L, -4);
+		lua_rawset(L, objects);
 	}
 
 	// Remove the loveobjects table from the stack.
-	lua_remove(L, -2);
+	lua_remove(L, objects);
 
 	// Keep the Proxy userdata on the stack.
 }
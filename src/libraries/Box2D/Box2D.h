@@ -50,6 +50,7 @@ For discussion please visit http://box2d.org/forum
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 #include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/b2WorldSnapshot.h>
 
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
 
@@ -107,6 +107,7 @@ class b2BroadPhase
 private:
 
 	friend class b2DynamicTree;
+	friend class b2WorldSnapshot;
 
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
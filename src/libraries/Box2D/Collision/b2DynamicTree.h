@@ -125,6 +125,8 @@ class b2DynamicTree
 
 private:
 
+	friend class b2WorldSnapshot;
+
 	int32 AllocateNode();
 	void FreeNode(int32 node);
 
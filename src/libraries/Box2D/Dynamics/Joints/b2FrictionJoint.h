@@ -85,6 +85,7 @@ class b2FrictionJoint : public b2Joint
 protected:
 
 	friend class b2Joint;
+	friend class b2WorldSnapshot;
 
 	b2FrictionJoint(const b2FrictionJointDef* def);
 
@@ -97,6 +97,7 @@ class b2MouseJoint : public b2Joint
 
 protected:
 	friend class b2Joint;
+	friend class b2WorldSnapshot;
 
 	b2MouseJoint(const b2MouseJointDef* def);
 
@@ -149,6 +149,7 @@ class b2PrismaticJoint : public b2Joint
 
 protected:
 	friend class b2Joint;
+	friend class b2WorldSnapshot;
 	friend class b2GearJoint;
 	b2PrismaticJoint(const b2PrismaticJointDef* def);
 
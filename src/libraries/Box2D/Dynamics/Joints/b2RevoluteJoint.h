@@ -157,6 +157,7 @@ class b2RevoluteJoint : public b2Joint
 protected:
 	
 	friend class b2Joint;
+	friend class b2WorldSnapshot;
 	friend class b2GearJoint;
 
 	b2RevoluteJoint(const b2RevoluteJointDef* def);
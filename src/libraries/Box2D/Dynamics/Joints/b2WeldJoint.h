@@ -91,6 +91,7 @@ class b2WeldJoint : public b2Joint
 protected:
 
 	friend class b2Joint;
+	friend class b2WorldSnapshot;
 
 	b2WeldJoint(const b2WeldJointDef* def);
 
@@ -223,6 +223,7 @@ class b2World
 	friend class b2Fixture;
 	friend class b2ContactManager;
 	friend class b2Controller;
+	friend class b2WorldSnapshot;
 
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
@@ -0,0 +1,748 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include <Box2D/Dynamics/b2WorldSnapshot.h>
+#include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Fixture.h>
+#include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Dynamics/Joints/b2DistanceJoint.h>
+#include <Box2D/Dynamics/Joints/b2FrictionJoint.h>
+#include <Box2D/Dynamics/Joints/b2GearJoint.h>
+#include <Box2D/Dynamics/Joints/b2MotorJoint.h>
+#include <Box2D/Dynamics/Joints/b2MouseJoint.h>
+#include <Box2D/Dynamics/Joints/b2PrismaticJoint.h>
+#include <Box2D/Dynamics/Joints/b2PulleyJoint.h>
+#include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
+#include <Box2D/Dynamics/Joints/b2RopeJoint.h>
+#include <Box2D/Dynamics/Joints/b2WeldJoint.h>
+#include <Box2D/Dynamics/Joints/b2WheelJoint.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+
+const int32 b2_snapshotMagic = 0x53573262; // "b2WS"
+const int32 b2_snapshotVersion = 1;
+
+struct b2SnapshotHeader
+{
+	int32 magic;
+	int32 version;
+	int32 bodyCount;
+	int32 fixtureCount;
+	int32 jointCount;
+	int32 moveCount;
+	int32 contactCount;
+	int32 newFixture;
+	float32 inv_dt0;
+	int32 stepComplete;
+};
+
+struct b2BodyRecord
+{
+	int32 type;
+	int32 fixtureCount;
+	uint32 flags;
+	b2Transform xf;
+	b2Sweep sweep;
+	b2Vec2 linearVelocity;
+	float32 angularVelocity;
+	b2Vec2 force;
+	float32 torque;
+	float32 sleepTime;
+};
+
+struct b2ProxyRecord
+{
+	b2AABB aabb;
+	b2AABB fatAABB;
+};
+
+struct b2FixtureIndex
+{
+	const b2Fixture* fixture;
+	int32 index;
+
+	bool operator<(const b2FixtureIndex& other) const { return fixture < other.fixture; }
+};
+
+int32 b2FindFixture(const b2FixtureIndex* fixtures, int32 count, const b2Fixture* fixture)
+{
+	b2FixtureIndex key = {fixture, 0};
+	const b2FixtureIndex* it = std::lower_bound(fixtures, fixtures + count, key);
+	b2Assert(it != fixtures + count && it->fixture == fixture);
+	return it->index;
+}
+
+bool b2IsValidLimitState(b2LimitState state)
+{
+	return state == e_inactiveLimit || state == e_atLowerLimit || state == e_atUpperLimit || state == e_equalLimits;
+}
+
+bool b2IsValidManifold(const b2Manifold& manifold)
+{
+	return 0 <= manifold.pointCount && manifold.pointCount <= b2_maxManifoldPoints
+		&& (manifold.type == b2Manifold::e_circles || manifold.type == b2Manifold::e_faceA || manifold.type == b2Manifold::e_faceB);
+}
+
+} // namespace
+
+struct b2WorldSnapshot::ContactRecord
+{
+	int32 fixtureA;
+	int32 indexA;
+	int32 fixtureB;
+	int32 indexB;
+	uint32 flags;
+	b2Manifold manifold;
+	int32 toiCount;
+	float32 toi;
+	float32 friction;
+	float32 restitution;
+	float32 tangentSpeed;
+};
+
+class b2WorldSnapshot::Writer
+{
+public:
+	Writer(void* buffer) : m_buffer((uint8*)buffer), m_size(0) {}
+
+	// With no buffer this only counts bytes.
+	template <typename T>
+	void Write(const T& value)
+	{
+		if (m_buffer)
+		{
+			memcpy(m_buffer + m_size, &value, sizeof(T));
+		}
+		m_size += sizeof(T);
+	}
+
+	int32 GetSize() const { return m_size; }
+
+private:
+	uint8* m_buffer;
+	int32 m_size;
+};
+
+class b2WorldSnapshot::Reader
+{
+public:
+	Reader(const void* buffer, int32 size)
+		: m_buffer((const uint8*)buffer), m_size(size), m_offset(0), m_failed(false) {}
+
+	template <typename T>
+	bool Read(T& value)
+	{
+		if (m_failed || m_size - m_offset < (int32)sizeof(T))
+		{
+			m_failed = true;
+			memset((void*)&value, 0, sizeof(T));
+			return false;
+		}
+		memcpy(&value, m_buffer + m_offset, sizeof(T));
+		m_offset += sizeof(T);
+		return true;
+	}
+
+	// Reads a value and only stores it when applying.
+	template <typename T>
+	void Apply(T& target, bool apply)
+	{
+		T value;
+		if (Read(value) && apply)
+		{
+			target = value;
+		}
+	}
+
+	void Fail() { m_failed = true; }
+	bool IsValid() const { return m_failed == false; }
+	bool IsFinished() const { return m_failed == false && m_offset == m_size; }
+
+private:
+	const uint8* m_buffer;
+	int32 m_size;
+	int32 m_offset;
+	bool m_failed;
+};
+
+// The persistent state of each joint type: accumulated impulses for warm
+// starting, plus anything else which carries over from one step to the next.
+void b2WorldSnapshot::WriteJoint(Writer& writer, const b2Joint* joint)
+{
+	writer.Write((int32)joint->GetType());
+
+	switch (joint->GetType())
+	{
+	case e_distanceJoint:
+		writer.Write(((const b2DistanceJoint*)joint)->m_impulse);
+		break;
+	case e_frictionJoint:
+		writer.Write(((const b2FrictionJoint*)joint)->m_linearImpulse);
+		writer.Write(((const b2FrictionJoint*)joint)->m_angularImpulse);
+		break;
+	case e_gearJoint:
+		writer.Write(((const b2GearJoint*)joint)->m_impulse);
+		break;
+	case e_motorJoint:
+		writer.Write(((const b2MotorJoint*)joint)->m_linearImpulse);
+		writer.Write(((const b2MotorJoint*)joint)->m_angularImpulse);
+		break;
+	case e_mouseJoint:
+		writer.Write(((const b2MouseJoint*)joint)->m_targetA);
+		writer.Write(((const b2MouseJoint*)joint)->m_impulse);
+		break;
+	case e_prismaticJoint:
+		writer.Write(((const b2PrismaticJoint*)joint)->m_impulse);
+		writer.Write(((const b2PrismaticJoint*)joint)->m_motorImpulse);
+		writer.Write(((const b2PrismaticJoint*)joint)->m_limitState);
+		break;
+	case e_pulleyJoint:
+		writer.Write(((const b2PulleyJoint*)joint)->m_impulse);
+		break;
+	case e_revoluteJoint:
+		writer.Write(((const b2RevoluteJoint*)joint)->m_impulse);
+		writer.Write(((const b2RevoluteJoint*)joint)->m_motorImpulse);
+		writer.Write(((const b2RevoluteJoint*)joint)->m_limitState);
+		break;
+	case e_ropeJoint:
+		writer.Write(((const b2RopeJoint*)joint)->m_impulse);
+		writer.Write(((const b2RopeJoint*)joint)->m_length);
+		writer.Write(((const b2RopeJoint*)joint)->m_state);
+		break;
+	case e_weldJoint:
+		writer.Write(((const b2WeldJoint*)joint)->m_impulse);
+		break;
+	case e_wheelJoint:
+		writer.Write(((const b2WheelJoint*)joint)->m_impulse);
+		writer.Write(((const b2WheelJoint*)joint)->m_motorImpulse);
+		writer.Write(((const b2WheelJoint*)joint)->m_springImpulse);
+		break;
+	default:
+		break;
+	}
+}
+
+void b2WorldSnapshot::ReadJoint(Reader& reader, b2Joint* joint, bool apply)
+{
+	int32 type;
+	if (reader.Read(type) == false || type != (int32)joint->GetType())
+	{
+		reader.Fail();
+		return;
+	}
+
+	b2LimitState state = e_inactiveLimit;
+
+	switch (joint->GetType())
+	{
+	case e_distanceJoint:
+		reader.Apply(((b2DistanceJoint*)joint)->m_impulse, apply);
+		break;
+	case e_frictionJoint:
+		reader.Apply(((b2FrictionJoint*)joint)->m_linearImpulse, apply);
+		reader.Apply(((b2FrictionJoint*)joint)->m_angularImpulse, apply);
+		break;
+	case e_gearJoint:
+		reader.Apply(((b2GearJoint*)joint)->m_impulse, apply);
+		break;
+	case e_motorJoint:
+		reader.Apply(((b2MotorJoint*)joint)->m_linearImpulse, apply);
+		reader.Apply(((b2MotorJoint*)joint)->m_angularImpulse, apply);
+		break;
+	case e_mouseJoint:
+		reader.Apply(((b2MouseJoint*)joint)->m_targetA, apply);
+		reader.Apply(((b2MouseJoint*)joint)->m_impulse, apply);
+		break;
+	case e_prismaticJoint:
+		reader.Apply(((b2PrismaticJoint*)joint)->m_impulse, apply);
+		reader.Apply(((b2PrismaticJoint*)joint)->m_motorImpulse, apply);
+		reader.Read(state);
+		if (apply)
+		{
+			((b2PrismaticJoint*)joint)->m_limitState = state;
+		}
+		break;
+	case e_pulleyJoint:
+		reader.Apply(((b2PulleyJoint*)joint)->m_impulse, apply);
+		break;
+	case e_revoluteJoint:
+		reader.Apply(((b2RevoluteJoint*)joint)->m_impulse, apply);
+		reader.Apply(((b2RevoluteJoint*)joint)->m_motorImpulse, apply);
+		reader.Read(state);
+		if (apply)
+		{
+			((b2RevoluteJoint*)joint)->m_limitState = state;
+		}
+		break;
+	case e_ropeJoint:
+		reader.Apply(((b2RopeJoint*)joint)->m_impulse, apply);
+		reader.Apply(((b2RopeJoint*)joint)->m_length, apply);
+		reader.Read(state);
+		if (apply)
+		{
+			((b2RopeJoint*)joint)->m_state = state;
+		}
+		break;
+	case e_weldJoint:
+		reader.Apply(((b2WeldJoint*)joint)->m_impulse, apply);
+		break;
+	case e_wheelJoint:
+		reader.Apply(((b2WheelJoint*)joint)->m_impulse, apply);
+		reader.Apply(((b2WheelJoint*)joint)->m_motorImpulse, apply);
+		reader.Apply(((b2WheelJoint*)joint)->m_springImpulse, apply);
+		break;
+	default:
+		break;
+	}
+
+	if (b2IsValidLimitState(state) == false)
+	{
+		reader.Fail();
+	}
+}
+
+int32 b2WorldSnapshot::GetSize(const b2World* world)
+{
+	return Save(world, NULL);
+}
+
+int32 b2WorldSnapshot::Save(const b2World* world, void* buffer)
+{
+	const b2ContactManager& contactManager = world->m_contactManager;
+	const b2BroadPhase& broadPhase = contactManager.m_broadPhase;
+
+	int32 fixtureCount = 0;
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		fixtureCount += b->m_fixtureCount;
+	}
+
+	Writer writer(buffer);
+
+	b2SnapshotHeader header;
+	memset((void*)&header, 0, sizeof(header));
+	header.magic = b2_snapshotMagic;
+	header.version = b2_snapshotVersion;
+	header.bodyCount = world->m_bodyCount;
+	header.fixtureCount = fixtureCount;
+	header.jointCount = world->m_jointCount;
+	header.moveCount = broadPhase.m_moveCount;
+	header.contactCount = contactManager.m_contactCount;
+	header.newFixture = (world->m_flags & b2World::e_newFixture) ? 1 : 0;
+	header.inv_dt0 = world->m_inv_dt0;
+	header.stepComplete = world->m_stepComplete ? 1 : 0;
+	writer.Write(header);
+
+	// Contacts refer to fixtures by their index in body list order.
+	b2FixtureIndex* fixtures = NULL;
+	if (buffer && fixtureCount > 0)
+	{
+		fixtures = (b2FixtureIndex*)b2Alloc(fixtureCount * sizeof(b2FixtureIndex));
+	}
+
+	int32 fixtureIndex = 0;
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b2BodyRecord body;
+		memset((void*)&body, 0, sizeof(body));
+		body.type = b->m_type;
+		body.fixtureCount = b->m_fixtureCount;
+		body.flags = b->m_flags & (b2Body::e_awakeFlag | b2Body::e_toiFlag);
+		body.xf = b->m_xf;
+		body.sweep = b->m_sweep;
+		body.linearVelocity = b->m_linearVelocity;
+		body.angularVelocity = b->m_angularVelocity;
+		body.force = b->m_force;
+		body.torque = b->m_torque;
+		body.sleepTime = b->m_sleepTime;
+		writer.Write(body);
+
+		for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			if (fixtures)
+			{
+				fixtures[fixtureIndex].fixture = f;
+				fixtures[fixtureIndex].index = fixtureIndex;
+			}
+			++fixtureIndex;
+
+			writer.Write(f->m_proxyCount);
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2ProxyRecord proxy;
+				proxy.aabb = f->m_proxies[i].aabb;
+				proxy.fatAABB = broadPhase.GetFatAABB(f->m_proxies[i].proxyId);
+				writer.Write(proxy);
+			}
+		}
+	}
+
+	for (const b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		WriteJoint(writer, j);
+	}
+
+	for (int32 i = 0; i < broadPhase.m_moveCount; ++i)
+	{
+		writer.Write(broadPhase.m_moveBuffer[i]);
+	}
+
+	if (fixtures)
+	{
+		std::sort(fixtures, fixtures + fixtureCount);
+	}
+
+	for (const b2Contact* c = contactManager.m_contactList; c; c = c->m_next)
+	{
+		ContactRecord contact;
+		memset((void*)&contact, 0, sizeof(contact));
+		contact.fixtureA = fixtures ? b2FindFixture(fixtures, fixtureCount, c->m_fixtureA) : 0;
+		contact.indexA = c->m_indexA;
+		contact.fixtureB = fixtures ? b2FindFixture(fixtures, fixtureCount, c->m_fixtureB) : 0;
+		contact.indexB = c->m_indexB;
+		contact.flags = c->m_flags & ~b2Contact::e_islandFlag;
+		contact.manifold = c->m_manifold;
+		contact.toiCount = c->m_toiCount;
+		contact.toi = c->m_toi;
+		contact.friction = c->m_friction;
+		contact.restitution = c->m_restitution;
+		contact.tangentSpeed = c->m_tangentSpeed;
+		writer.Write(contact);
+	}
+
+	if (fixtures)
+	{
+		b2Free(fixtures);
+	}
+
+	return writer.GetSize();
+}
+
+bool b2WorldSnapshot::IsCompatible(const b2World* world, const void* buffer, int32 size)
+{
+	bool fastContacts = false;
+	return Process(const_cast<b2World*>(world), buffer, size, false, fastContacts);
+}
+
+bool b2WorldSnapshot::Restore(b2World* world, const void* buffer, int32 size)
+{
+	b2Assert(world->IsLocked() == false);
+	if (world->IsLocked())
+	{
+		return false;
+	}
+
+	// Check everything before changing anything, so a bad snapshot can't
+	// leave the world half restored.
+	bool fastContacts = false;
+	if (Process(world, buffer, size, false, fastContacts) == false)
+	{
+		return false;
+	}
+
+	Process(world, buffer, size, true, fastContacts);
+	return true;
+}
+
+bool b2WorldSnapshot::Process(b2World* world, const void* buffer, int32 size, bool apply, bool& fastContacts)
+{
+	b2ContactManager& contactManager = world->m_contactManager;
+	b2BroadPhase& broadPhase = contactManager.m_broadPhase;
+	b2DynamicTree& tree = broadPhase.m_tree;
+
+	Reader reader(buffer, size);
+
+	b2SnapshotHeader header;
+	if (reader.Read(header) == false
+		|| header.magic != b2_snapshotMagic
+		|| header.version != b2_snapshotVersion
+		|| header.bodyCount != world->m_bodyCount
+		|| header.jointCount != world->m_jointCount
+		|| header.moveCount < 0
+		|| header.contactCount < 0)
+	{
+		return false;
+	}
+
+	// Contacts are destroyed before the bodies are restored, because
+	// destroying them can wake bodies up. When the contact list hasn't
+	// changed since the snapshot, the contacts are kept and only their state
+	// is restored.
+	if (apply && fastContacts == false)
+	{
+		while (contactManager.m_contactList)
+		{
+			contactManager.Destroy(contactManager.m_contactList);
+		}
+	}
+
+	if (apply)
+	{
+		world->m_flags &= ~b2World::e_newFixture;
+		if (header.newFixture)
+		{
+			world->m_flags |= b2World::e_newFixture;
+		}
+		world->m_inv_dt0 = header.inv_dt0;
+		world->m_stepComplete = header.stepComplete != 0;
+	}
+
+	b2Fixture** fixtures = NULL;
+	if (header.fixtureCount > 0 && header.fixtureCount <= size)
+	{
+		fixtures = (b2Fixture**)b2Alloc(header.fixtureCount * sizeof(b2Fixture*));
+	}
+
+	int32 fixtureIndex = 0;
+	for (b2Body* b = world->m_bodyList; b && reader.IsValid(); b = b->m_next)
+	{
+		b2BodyRecord body;
+		if (reader.Read(body) == false || body.type != b->m_type || body.fixtureCount != b->m_fixtureCount)
+		{
+			reader.Fail();
+			break;
+		}
+
+		if (apply)
+		{
+			const uint32 mask = b2Body::e_awakeFlag | b2Body::e_toiFlag;
+			b->m_flags = (uint16)((b->m_flags & ~mask) | (body.flags & mask));
+			b->m_xf = body.xf;
+			b->m_sweep = body.sweep;
+			b->m_linearVelocity = body.linearVelocity;
+			b->m_angularVelocity = body.angularVelocity;
+			b->m_force = body.force;
+			b->m_torque = body.torque;
+			b->m_sleepTime = body.sleepTime;
+		}
+
+		for (b2Fixture* f = b->m_fixtureList; f && reader.IsValid(); f = f->m_next)
+		{
+			if (fixtures == NULL || fixtureIndex >= header.fixtureCount)
+			{
+				reader.Fail();
+				break;
+			}
+			fixtures[fixtureIndex++] = f;
+
+			int32 proxyCount;
+			if (reader.Read(proxyCount) == false || proxyCount != f->m_proxyCount)
+			{
+				reader.Fail();
+				break;
+			}
+
+			for (int32 i = 0; i < proxyCount; ++i)
+			{
+				b2ProxyRecord proxy;
+				if (reader.Read(proxy) == false || proxy.fatAABB.IsValid() == false)
+				{
+					reader.Fail();
+					break;
+				}
+
+				if (apply)
+				{
+					b2FixtureProxy* p = f->m_proxies + i;
+					p->aabb = proxy.aabb;
+
+					// The broad-phase only reports pairs, so its tree's shape
+					// doesn't matter, but the fat bounds decide which pairs it
+					// finds.
+					b2TreeNode* node = tree.m_nodes + p->proxyId;
+					if (memcmp(&node->aabb, &proxy.fatAABB, sizeof(b2AABB)) != 0)
+					{
+						tree.RemoveLeaf(p->proxyId);
+						node->aabb = proxy.fatAABB;
+						tree.InsertLeaf(p->proxyId);
+					}
+				}
+			}
+		}
+	}
+
+	if (reader.IsValid() && fixtureIndex != header.fixtureCount)
+	{
+		reader.Fail();
+	}
+
+	for (b2Joint* j = world->m_jointList; j && reader.IsValid(); j = j->m_next)
+	{
+		ReadJoint(reader, j, apply);
+	}
+
+	if (apply)
+	{
+		broadPhase.m_moveCount = 0;
+	}
+
+	for (int32 i = 0; i < header.moveCount && reader.IsValid(); ++i)
+	{
+		int32 proxyId;
+		reader.Read(proxyId);
+
+		if (proxyId != b2BroadPhase::e_nullProxy
+			&& (proxyId < 0 || proxyId >= tree.m_nodeCapacity || tree.m_nodes[proxyId].height != 0))
+		{
+			reader.Fail();
+		}
+		else if (apply)
+		{
+			broadPhase.BufferMove(proxyId);
+		}
+	}
+
+	if (apply == false)
+	{
+		fastContacts = header.contactCount == contactManager.m_contactCount;
+	}
+
+	ContactRecord* created = NULL;
+	if (apply && fastContacts == false && header.contactCount > 0 && header.contactCount <= size)
+	{
+		created = (ContactRecord*)b2Alloc(header.contactCount * sizeof(ContactRecord));
+	}
+
+	b2Contact* current = contactManager.m_contactList;
+	for (int32 i = 0; i < header.contactCount && reader.IsValid(); ++i)
+	{
+		ContactRecord contact;
+		if (reader.Read(contact) == false
+			|| contact.fixtureA < 0 || contact.fixtureA >= header.fixtureCount
+			|| contact.fixtureB < 0 || contact.fixtureB >= header.fixtureCount
+			|| b2IsValidManifold(contact.manifold) == false)
+		{
+			reader.Fail();
+			break;
+		}
+
+		b2Fixture* fixtureA = fixtures[contact.fixtureA];
+		b2Fixture* fixtureB = fixtures[contact.fixtureB];
+
+		if (fixtureA->m_body == fixtureB->m_body
+			|| contact.indexA < 0 || contact.indexA >= fixtureA->m_proxyCount
+			|| contact.indexB < 0 || contact.indexB >= fixtureB->m_proxyCount)
+		{
+			reader.Fail();
+			break;
+		}
+
+		if (apply == false)
+		{
+			fastContacts = fastContacts && current
+				&& current->m_fixtureA == fixtureA && current->m_indexA == contact.indexA
+				&& current->m_fixtureB == fixtureB && current->m_indexB == contact.indexB;
+		}
+		else if (fastContacts)
+		{
+			SetContactState(current, contact);
+		}
+		else
+		{
+			created[i] = contact;
+		}
+
+		current = current ? current->m_next : NULL;
+	}
+
+	// New contacts are added to the front of the lists, so creating them in
+	// reverse gives the world and every body their saved contact order.
+	if (created)
+	{
+		for (int32 i = header.contactCount - 1; i >= 0; --i)
+		{
+			const ContactRecord& contact = created[i];
+			b2Contact* c = b2Contact::Create(fixtures[contact.fixtureA], contact.indexA, fixtures[contact.fixtureB], contact.indexB, &world->m_blockAllocator);
+			if (c == NULL)
+			{
+				continue;
+			}
+
+			LinkContact(contactManager, c);
+			SetContactState(c, contact);
+		}
+
+		b2Free(created);
+	}
+
+	if (fixtures)
+	{
+		b2Free(fixtures);
+	}
+
+	return reader.IsFinished();
+}
+
+void b2WorldSnapshot::SetContactState(b2Contact* c, const ContactRecord& contact)
+{
+	c->m_flags = contact.flags & ~b2Contact::e_islandFlag;
+	c->m_manifold = contact.manifold;
+	c->m_toiCount = contact.toiCount;
+	c->m_toi = contact.toi;
+	c->m_friction = contact.friction;
+	c->m_restitution = contact.restitution;
+	c->m_tangentSpeed = contact.tangentSpeed;
+}
+
+void b2WorldSnapshot::LinkContact(b2ContactManager& contactManager, b2Contact* c)
+{
+	b2Body* bodyA = c->m_fixtureA->m_body;
+	b2Body* bodyB = c->m_fixtureB->m_body;
+
+	// Insert into the world.
+	c->m_prev = NULL;
+	c->m_next = contactManager.m_contactList;
+	if (contactManager.m_contactList != NULL)
+	{
+		contactManager.m_contactList->m_prev = c;
+	}
+	contactManager.m_contactList = c;
+
+	// Connect to body A
+	c->m_nodeA.contact = c;
+	c->m_nodeA.other = bodyB;
+
+	c->m_nodeA.prev = NULL;
+	c->m_nodeA.next = bodyA->m_contactList;
+	if (bodyA->m_contactList != NULL)
+	{
+		bodyA->m_contactList->prev = &c->m_nodeA;
+	}
+	bodyA->m_contactList = &c->m_nodeA;
+
+	// Connect to body B
+	c->m_nodeB.contact = c;
+	c->m_nodeB.other = bodyA;
+
+	c->m_nodeB.prev = NULL;
+	c->m_nodeB.next = bodyB->m_contactList;
+	if (bodyB->m_contactList != NULL)
+	{
+		bodyB->m_contactList->prev = &c->m_nodeB;
+	}
+	bodyB->m_contactList = &c->m_nodeB;
+
+	++contactManager.m_contactCount;
+}
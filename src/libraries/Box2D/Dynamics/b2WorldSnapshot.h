@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef B2_WORLD_SNAPSHOT_H
+#define B2_WORLD_SNAPSHOT_H
+
+#include <Box2D/Common/b2Settings.h>
+
+class b2World;
+class b2Joint;
+class b2Contact;
+class b2ContactManager;
+
+/// Saves and restores the simulation state of a world: body motion, broad-phase
+/// bounds, joint impulses and the contact list with its manifolds. This is
+/// everything the next step depends on, so restoring a snapshot and stepping
+/// reproduces the original steps exactly.
+/// Snapshots don't create or destroy bodies, fixtures or joints. They can only
+/// be restored into the world they came from, while it still has the same
+/// bodies, fixtures and joints. The data layout is specific to this build and
+/// platform.
+class b2WorldSnapshot
+{
+public:
+	/// Get the number of bytes needed to save the world.
+	static int32 GetSize(const b2World* world);
+
+	/// Save the world into a buffer of at least GetSize bytes.
+	/// @return the number of bytes written.
+	static int32 Save(const b2World* world, void* buffer);
+
+	/// Check whether a snapshot can be restored into the world.
+	static bool IsCompatible(const b2World* world, const void* buffer, int32 size);
+
+	/// Restore a snapshot. The world is left untouched if the snapshot isn't
+	/// compatible with it.
+	/// @warning this should be called outside of a time step.
+	/// @return false if the snapshot isn't compatible.
+	static bool Restore(b2World* world, const void* buffer, int32 size);
+
+private:
+	struct ContactRecord;
+	class Writer;
+	class Reader;
+
+	static void WriteJoint(Writer& writer, const b2Joint* joint);
+	static void ReadJoint(Reader& reader, b2Joint* joint, bool apply);
+
+	static bool Process(b2World* world, const void* buffer, int32 size, bool apply, bool& fastContacts);
+
+	static void SetContactState(b2Contact* contact, const ContactRecord& record);
+	static void LinkContact(b2ContactManager& contactManager, b2Contact* contact);
+};
+
+#endif
@@ -33,6 +33,7 @@
 #include <cstdio>
 #include <cstddef>
 #include <algorithm>
+#include <vector>
 
 extern "C" {
 #define LUA_COMPAT_ALL
@@ -42,9 +43,166 @@ extern "C" {
 #include <enet/enet.h>
 }
 
+// LOVE
+#include "common/runtime.h"
+#include "common/Data.h"
+#include "common/Exception.h"
+#include "data/wrap_Data.h"
+#include "thread/threads.h"
+
 #define check_host(l, idx)\
 	*(ENetHost**)luaL_checkudata(l, idx, "enet_host")
 
+#define check_host_state(l, idx)\
+	((HostState*)luaL_checkudata(l, idx, "enet_host"))
+
+/**
+ * A received packet's payload as love Data, so it reaches Lua without being
+ * copied into a string.
+ */
+class PacketData : public love::Data {
+public:
+	static love::Type type;
+
+	PacketData(ENetPacket *packet) : packet(packet) {}
+	virtual ~PacketData() { enet_packet_destroy(packet); }
+
+	PacketData *clone() const override {
+		ENetPacket *copy = enet_packet_create(packet->data, packet->dataLength, packet->flags & ~ENET_PACKET_FLAG_NO_ALLOCATE);
+		if (copy == NULL)
+			throw love::Exception("Out of memory.");
+		return new PacketData(copy);
+	}
+
+	void *getData() const override { return packet->data; }
+	size_t getSize() const override { return packet->dataLength; }
+
+private:
+	ENetPacket *packet;
+};
+
+love::Type PacketData::type("ENetPacketData", &love::Data::type);
+
+/**
+ * Services a host on a background thread, collecting its events into batches
+ * which Lua takes all at once. ENet isn't thread-safe, so everything else
+ * which touches the host or its peers holds the thread's mutex (via
+ * ServiceLock) while the thread exists.
+ */
+class ServiceThread : public love::thread::Threadable {
+public:
+	ServiceThread(ENetHost *host, enet_uint32 wait_ms)
+		: host(host), wait_ms(wait_ms), stopping(false), failed(false) {
+		threadName = "ENetService";
+	}
+
+	virtual ~ServiceThread() {
+		for (size_t i = 0; i < events.size(); i++) {
+			if (events[i].type == ENET_EVENT_TYPE_RECEIVE)
+				enet_packet_destroy(events[i].packet);
+		}
+	}
+
+	void threadFunction() override {
+		while (true) {
+			{
+				love::thread::Lock lock(mutex);
+				if (stopping)
+					break;
+
+				ENetEvent event;
+				int out;
+				while ((out = enet_host_service(host, &event, 0)) > 0)
+					events.push_back(event);
+
+				if (out < 0) {
+					failed = true;
+					break;
+				}
+			}
+
+			// Sleep until something arrives, without keeping Lua locked out.
+			enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE | ENET_SOCKET_WAIT_INTERRUPT;
+			enet_socket_wait(host->socket, &condition, wait_ms);
+		}
+	}
+
+	void stop() {
+		{
+			love::thread::Lock lock(mutex);
+			stopping = true;
+		}
+		wait();
+	}
+
+	/**
+	 * Swaps out the events collected so far. The returned batch is only
+	 * touched by the Lua thread, until the next call.
+	 */
+	std::vector<ENetEvent> &take_events(bool &service_failed) {
+		love::thread::Lock lock(mutex);
+		taken.clear();
+		taken.swap(events);
+		service_failed = failed;
+		return taken;
+	}
+
+	love::thread::MutexRef mutex;
+
+private:
+	ENetHost *host;
+	enet_uint32 wait_ms;
+
+	std::vector<ENetEvent> events;
+	std::vector<ENetEvent> taken;
+
+	bool stopping;
+	bool failed;
+};
+
+/**
+ * The enet_host userdata. The host has to come first, since check_host reads
+ * it directly. Every peer's data field points back at this.
+ */
+struct HostState {
+	ENetHost *host;
+	bool data_packets;
+	ServiceThread *thread;
+};
+
+/**
+ * Keeps a host's service thread (if it has one) out of ENet while in scope.
+ * Lua errors mustn't be raised while one is held.
+ */
+class ServiceLock {
+public:
+	ServiceLock(HostState *state)
+		: mutex(state != NULL && state->thread != NULL ? (love::thread::Mutex*) state->thread->mutex : NULL) {
+		if (mutex)
+			mutex->lock();
+	}
+
+	~ServiceLock() {
+		if (mutex)
+			mutex->unlock();
+	}
+
+private:
+	love::thread::Mutex *mutex;
+};
+
+static HostState *peer_host_state(ENetPeer *peer) {
+	return (HostState*)peer->data;
+}
+
+static void stop_service_thread(HostState *state) {
+	if (state->thread) {
+		state->thread->stop();
+		state->thread->release();
+		state->thread = NULL;
+	}
+}
+
 #define check_peer(l, idx)\
 	*(ENetPeer**)luaL_checkudata(l, idx, "enet_peer")
 
@@ -210,7 +368,7 @@ static void push_peer(lua_State *l, ENetPeer *peer) {
 	lua_remove(l, -2); // remove enet_peers
 }
 
-static void push_event(lua_State *l, ENetEvent *event) {
+static void push_event(lua_State *l, ENetEvent *event, bool data_packets) {
 	lua_newtable(l); // event table
 
 	if (event->peer) {
@@ -232,15 +390,21 @@ static void push_event(lua_State *l, ENetEvent *event) {
 			lua_pushstring(l, "disconnect");
 			break;
 		case ENET_EVENT_TYPE_RECEIVE:
-			lua_pushlstring(l, (const char *)event->packet->data, event->packet->dataLength);
+			if (data_packets) {
+				// The Data takes ownership of the packet.
+				PacketData *data = new PacketData(event->packet);
+				love::luax_pushtype(l, data);
+				data->release();
+			} else {
+				lua_pushlstring(l, (const char *)event->packet->data, event->packet->dataLength);
+				enet_packet_destroy(event->packet);
+			}
 			lua_setfield(l, -2, "data");
 
 			lua_pushinteger(l, event->channelID);
 			lua_setfield(l, -2, "channel");
 
 			lua_pushstring(l, "receive");
-
-			enet_packet_destroy(event->packet);
 			break;
 		case ENET_EVENT_TYPE_NONE:
 			lua_pushstring(l, "none");
@@ -250,16 +414,29 @@ static void push_event(lua_State *l, ENetEvent *event) {
 	lua_setfield(l, -2, "type");
 }
 
+static void ENET_CALLBACK release_packet_data(ENetPacket *packet) {
+	((love::Data*)packet->userData)->release();
+}
+
 /**
- * Read a packet off the stack as a string
+ * Read a packet off the stack as a string or love Data
  * idx is position of string
+ *
+ * Data isn't copied: the packet refers to its memory and keeps it alive until
+ * ENet is done with it, so it shouldn't be modified until then.
  */
 static ENetPacket *read_packet(lua_State *l, int idx, enet_uint8 *channel_id) {
-	size_t size;
+	size_t size = 0;
 	int argc = lua_gettop(l);
-	const void *data = luaL_checklstring(l, idx, &size);
+	const void *data = NULL;
+	love::Data *payload = NULL;
 	ENetPacket *packet;
 
+	if (love::luax_istype(l, idx, love::Data::type))
+		payload = love::data::luax_checkdata(l, idx);
+	else
+		data = luaL_checklstring(l, idx, &size);
+
 	enet_uint32 flags = ENET_PACKET_FLAG_RELIABLE;
 	*channel_id = 0;
 
@@ -280,7 +457,17 @@ static ENetPacket *read_packet(lua_State *l, int idx, enet_uint8 *channel_id) {
 		*channel_id = (int) luaL_checknumber(l, idx+1);
 	}
 
-	packet = enet_packet_create(data, size, flags);
+	if (payload != NULL) {
+		packet = enet_packet_create(payload->getData(), payload->getSize(), flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+		if (packet != NULL) {
+			payload->retain();
+			packet->userData = payload;
+			packet->freeCallback = release_packet_data;
+		}
+	} else {
+		packet = enet_packet_create(data, size, flags);
+	}
+
 	if (packet == NULL) {
 		luaL_error(l, "Failed to create packet");
 	}
@@ -333,7 +520,14 @@ static int host_create(lua_State *l) {
 		return 2;
 	}
 
-	*(ENetHost**)lua_newuserdata(l, sizeof(void*)) = host;
+	HostState *state = (HostState*)lua_newuserdata(l, sizeof(HostState));
+	state->host = host;
+	state->data_packets = false;
+	state->thread = NULL;
+
+	for (size_t i = 0; i < host->peerCount; i++)
+		host->peers[i].data = state;
+
 	luaL_getmetatable(l, "enet_host");
 	lua_setmetatable(l, -2);
 
@@ -362,6 +556,10 @@ static int host_service(lua_State *l) {
 	if (!host) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
+	HostState *state = check_host_state(l, 1);
+	if (state->thread) {
+		return luaL_error(l, "Host is serviced by a thread; use receive_events instead.");
+	}
 	ENetEvent event;
 	int timeout = 0, out;
 
@@ -372,7 +570,7 @@ static int host_service(lua_State *l) {
 	if (out == 0) return 0;
 	if (out < 0) return luaL_error(l, "Error during service");
 
-	push_event(l, &event);
+	push_event(l, &event, state->data_packets);
 	return 1;
 }
 
@@ -384,12 +582,101 @@ static int host_check_events(lua_State *l) {
 	if (!host) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
+	HostState *state = check_host_state(l, 1);
+	if (state->thread) {
+		return luaL_error(l, "Host is serviced by a thread; use receive_events instead.");
+	}
 	ENetEvent event;
 	int out = enet_host_check_events(host, &event);
 	if (out == 0) return 0;
 	if (out < 0) return luaL_error(l, "Error checking event");
 
-	push_event(l, &event);
+	push_event(l, &event, state->data_packets);
+	return 1;
+}
+
+/**
+ * Enables or disables receiving packets as love Data rather than strings,
+ * which avoids copying them.
+ * Args:
+ *	enable
+ */
+static int host_receive_as_data(lua_State *l) {
+	HostState *state = check_host_state(l, 1);
+	if (!state->host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+	state->data_packets = lua_toboolean(l, 2) != 0;
+	return 0;
+}
+
+/**
+ * Starts servicing the host on a background thread. Events are then fetched
+ * with receive_events instead of service or check_events.
+ * Args:
+ *	[wait_ms = 1] longest time the thread waits for incoming data before
+ *	sending queued packets
+ */
+static int host_start_service_thread(lua_State *l) {
+	HostState *state = check_host_state(l, 1);
+	if (!state->host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+	if (state->thread) return 0;
+
+	lua_Number wait_ms = luaL_optnumber(l, 2, 1);
+	if (wait_ms < 0) {
+		return luaL_argerror(l, 2, "wait time must not be negative");
+	}
+
+	ServiceThread *thread = new ServiceThread(state->host, (enet_uint32) wait_ms);
+	if (!thread->start()) {
+		thread->release();
+		return luaL_error(l, "Failed to start service thread");
+	}
+
+	state->thread = thread;
+	return 0;
+}
+
+static int host_stop_service_thread(lua_State *l) {
+	HostState *state = check_host_state(l, 1);
+	stop_service_thread(state);
+	return 0;
+}
+
+/**
+ * Takes every event the service thread has collected since the last call
+ *
+ * Return
+ *	an array of event tables (possibly empty)
+ */
+static int host_receive_events(lua_State *l) {
+	HostState *state = check_host_state(l, 1);
+	if (!state->host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+	if (!state->thread) {
+		return luaL_error(l, "Host has no service thread.");
+	}
+
+	bool failed = false;
+	std::vector<ENetEvent> &events = state->thread->take_events(failed);
+
+	// The thread stops collecting events when servicing fails, so the ones
+	// from before that are returned first and the error is raised by the
+	// next call.
+	if (failed && events.empty()) {
+		return luaL_error(l, "Error during service");
+	}
+
+	lua_createtable(l, (int) events.size(), 0);
+	for (size_t i = 0; i < events.size(); i++) {
+		push_event(l, &events[i], state->data_packets);
+		lua_rawseti(l, -2, (int) i + 1);
+	}
+	events.clear();
+
 	return 1;
 }
 
@@ -403,7 +690,11 @@ static int host_compress_with_range_coder(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	int result = enet_host_compress_with_range_coder (host);
+	int result;
+	{
+		ServiceLock lock(check_host_state(l, 1));
+		result = enet_host_compress_with_range_coder (host);
+	}
 	if (result == 0) {
 		lua_pushboolean (l, 1);
 	} else {
@@ -441,7 +732,10 @@ static int host_connect(lua_State *l) {
 	}
 
 	// printf("host connect, channels=%d, data=%d\n", channel_count, data);
-	peer = enet_host_connect(host, &address, channel_count, data);
+	{
+		ServiceLock lock(check_host_state(l, 1));
+		peer = enet_host_connect(host, &address, channel_count, data);
+	}
 
 	if (peer == NULL) {
 		return luaL_error(l, "Failed to create peer");
@@ -457,6 +751,7 @@ static int host_flush(lua_State *l) {
 	if (!host) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
+	ServiceLock lock(check_host_state(l, 1));
 	enet_host_flush(host);
 	return 0;
 }
@@ -469,6 +764,7 @@ static int host_broadcast(lua_State *l) {
 
 	enet_uint8 channel_id;
 	ENetPacket *packet = read_packet(l, 2, &channel_id);
+	ServiceLock lock(check_host_state(l, 1));
 	enet_host_broadcast(host, channel_id, packet);
 	return 0;
 }
@@ -480,6 +776,7 @@ static int host_channel_limit(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 	int limit = (int) luaL_checknumber(l, 2);
+	ServiceLock lock(check_host_state(l, 1));
 	enet_host_channel_limit(host, limit);
 	return 0;
 }
@@ -491,6 +788,7 @@ static int host_bandwidth_limit(lua_State *l) {
 	}
 	enet_uint32 in_bandwidth = (int) luaL_checknumber(l, 2);
 	enet_uint32 out_bandwidth = (int) luaL_checknumber(l, 2);
+	ServiceLock lock(check_host_state(l, 1));
 	enet_host_bandwidth_limit(host, in_bandwidth, out_bandwidth);
 	return 0;
 }
@@ -517,7 +815,12 @@ static int host_total_sent_data(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	lua_pushinteger (l, host->totalSentData);
+	enet_uint32 value;
+	{
+		ServiceLock lock(check_host_state(l, 1));
+		value = host->totalSentData;
+	}
+	lua_pushinteger (l, value);
 
 	return 1;
 }
@@ -528,7 +831,12 @@ static int host_total_received_data(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	lua_pushinteger (l, host->totalReceivedData);
+	enet_uint32 value;
+	{
+		ServiceLock lock(check_host_state(l, 1));
+		value = host->totalReceivedData;
+	}
+	lua_pushinteger (l, value);
 
 	return 1;
 }
@@ -538,7 +846,12 @@ static int host_service_time(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	lua_pushinteger (l, host->serviceTime);
+	enet_uint32 value;
+	{
+		ServiceLock lock(check_host_state(l, 1));
+		value = host->serviceTime;
+	}
+	lua_pushinteger (l, value);
 
 	return 1;
 }
@@ -574,29 +887,37 @@ static int host_get_peer(lua_State *l) {
 
 static int host_gc(lua_State *l) {
 	// We have to manually grab the userdata so that we can set it to NULL.
-	ENetHost** host = (ENetHost**)luaL_checkudata(l, 1, "enet_host");
+	HostState *state = check_host_state(l, 1);
+	// The thread has to be gone before the host is.
+	stop_service_thread(state);
 	// We don't want to crash by destroying a non-existant host.
-	if (*host) {
-		enet_host_destroy(*host);
+	if (state->host) {
+		enet_host_destroy(state->host);
 	}
-	*host = NULL;
+	state->host = NULL;
 	return 0;
 }
 
 static int peer_tostring(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	ENetAddress address;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		address = peer->address;
+	}
 	char host_str[128];
-	enet_address_get_host_ip(&peer->address, host_str, 128);
+	enet_address_get_host_ip(&address, host_str, 128);
 
 	lua_pushstring(l, host_str);
 	lua_pushstring(l, ":");
-	lua_pushinteger(l, peer->address.port);
+	lua_pushinteger(l, address.port);
 	lua_concat(l, 3);
 	return 1;
 }
 
 static int peer_ping(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	ServiceLock lock(peer_host_state(peer));
 	enet_peer_ping(peer);
 	return 0;
 }
@@ -608,6 +929,7 @@ static int peer_throttle_configure(lua_State *l) {
 	enet_uint32 acceleration = (int) luaL_checknumber(l, 3);
 	enet_uint32 deceleration = (int) luaL_checknumber(l, 4);
 
+	ServiceLock lock(peer_host_state(peer));
 	enet_peer_throttle_configure(peer, interval, acceleration, deceleration);
 	return 0;
 }
@@ -615,12 +937,15 @@ static int peer_throttle_configure(lua_State *l) {
 static int peer_round_trip_time(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	if (lua_gettop(l) > 1) {
-		enet_uint32 round_trip_time = (int) luaL_checknumber(l, 2);
-		peer->roundTripTime = round_trip_time;
+	bool set = lua_gettop(l) > 1;
+	enet_uint32 round_trip_time = set ? (int) luaL_checknumber(l, 2) : 0;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		if (set) peer->roundTripTime = round_trip_time;
+		round_trip_time = peer->roundTripTime;
 	}
 
-	lua_pushinteger (l, peer->roundTripTime);
+	lua_pushinteger (l, round_trip_time);
 
 	return 1;
 }
@@ -628,11 +953,14 @@ static int peer_round_trip_time(lua_State *l) {
 static int peer_last_round_trip_time(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	if (lua_gettop(l) > 1) {
-		enet_uint32 round_trip_time = (int) luaL_checknumber(l, 2);
-		peer->lastRoundTripTime = round_trip_time;
+	bool set = lua_gettop(l) > 1;
+	enet_uint32 round_trip_time = set ? (int) luaL_checknumber(l, 2) : 0;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		if (set) peer->lastRoundTripTime = round_trip_time;
+		round_trip_time = peer->lastRoundTripTime;
 	}
-	lua_pushinteger (l, peer->lastRoundTripTime);
+	lua_pushinteger (l, round_trip_time);
 
 	return 1;
 }
@@ -640,12 +968,15 @@ static int peer_last_round_trip_time(lua_State *l) {
 static int peer_ping_interval(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	if (lua_gettop(l) > 1) {
-		enet_uint32 interval = (int) luaL_checknumber(l, 2);
-		enet_peer_ping_interval (peer, interval);
+	bool set = lua_gettop(l) > 1;
+	enet_uint32 interval = set ? (int) luaL_checknumber(l, 2) : 0;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		if (set) enet_peer_ping_interval (peer, interval);
+		interval = peer->pingInterval;
 	}
 
-	lua_pushinteger (l, peer->pingInterval);
+	lua_pushinteger (l, interval);
 
 	return 1;
 }
@@ -666,11 +997,17 @@ static int peer_timeout(lua_State *l) {
 			if (!lua_isnil(l, 2)) timeout_limit = (int) luaL_checknumber(l, 2);
 	}
 
-	enet_peer_timeout (peer, timeout_limit, timeout_minimum, timeout_maximum);
+	{
+		ServiceLock lock(peer_host_state(peer));
+		enet_peer_timeout (peer, timeout_limit, timeout_minimum, timeout_maximum);
+		timeout_limit = peer->timeoutLimit;
+		timeout_minimum = peer->timeoutMinimum;
+		timeout_maximum = peer->timeoutMaximum;
+	}
 
-	lua_pushinteger (l, peer->timeoutLimit);
-	lua_pushinteger (l, peer->timeoutMinimum);
-	lua_pushinteger (l, peer->timeoutMaximum);
+	lua_pushinteger (l, timeout_limit);
+	lua_pushinteger (l, timeout_minimum);
+	lua_pushinteger (l, timeout_maximum);
 
 	return 3;
 }
@@ -679,6 +1016,7 @@ static int peer_disconnect(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
 	enet_uint32 data = lua_gettop(l) > 1 ? (int) luaL_checknumber(l, 2) : 0;
+	ServiceLock lock(peer_host_state(peer));
 	enet_peer_disconnect(peer, data);
 	return 0;
 }
@@ -687,6 +1025,7 @@ static int peer_disconnect_now(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
 	enet_uint32 data = lua_gettop(l) > 1 ? (int) luaL_checknumber(l, 2) : 0;
+	ServiceLock lock(peer_host_state(peer));
 	enet_peer_disconnect_now(peer, data);
 	return 0;
 }
@@ -695,6 +1034,7 @@ static int peer_disconnect_later(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
 	enet_uint32 data = lua_gettop(l) > 1 ? (int) luaL_checknumber(l, 2) : 0;
+	ServiceLock lock(peer_host_state(peer));
 	enet_peer_disconnect_later(peer, data);
 	return 0;
 }
@@ -710,8 +1050,13 @@ static int peer_index(lua_State *l) {
 
 static int peer_state(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	ENetPeerState state;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		state = peer->state;
+	}
 
-	switch (peer->state) {
+	switch (state) {
 		case (ENET_PEER_STATE_DISCONNECTED):
 			lua_pushstring (l, "disconnected");
 			break;
@@ -751,8 +1096,13 @@ static int peer_state(lua_State *l) {
 
 static int peer_connect_id(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	enet_uint32 connect_id;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		connect_id = peer->connectID;
+	}
 
-	lua_pushinteger (l, peer->connectID);
+	lua_pushinteger (l, connect_id);
 
 	return 1;
 }
@@ -760,6 +1110,7 @@ static int peer_connect_id(lua_State *l) {
 
 static int peer_reset(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	ServiceLock lock(peer_host_state(peer));
 	enet_peer_reset(peer);
 	return 0;
 }
@@ -773,21 +1124,31 @@ static int peer_receive(lua_State *l) {
 		channel_id = (int) luaL_checknumber(l, 2);
 	}
 
-	packet = enet_peer_receive(peer, &channel_id);
+	{
+		ServiceLock lock(peer_host_state(peer));
+		packet = enet_peer_receive(peer, &channel_id);
+	}
 	if (packet == NULL) return 0;
 
-	lua_pushlstring(l, (const char *)packet->data, packet->dataLength);
+	if (peer_host_state(peer)->data_packets) {
+		// The Data takes ownership of the packet.
+		PacketData *data = new PacketData(packet);
+		love::luax_pushtype(l, data);
+		data->release();
+	} else {
+		lua_pushlstring(l, (const char *)packet->data, packet->dataLength);
+		enet_packet_destroy(packet);
+	}
 	lua_pushinteger(l, channel_id);
 
-	enet_packet_destroy(packet);
 	return 2;
 }
 
 
 /**
- * Send a lua string to a peer
+ * Send a lua string or love Data to a peer
  * Args:
- *	packet data, string
+ *	packet data, string or Data
  *	channel id
  *	flags ["reliable", nil]
  *
@@ -799,7 +1160,11 @@ static int peer_send(lua_State *l) {
 	ENetPacket *packet = read_packet(l, 2, &channel_id);
 
 	// printf("sending, channel_id=%d\n", channel_id);
-	int ret = enet_peer_send(peer, channel_id, packet);
+	int ret;
+	{
+		ServiceLock lock(peer_host_state(peer));
+		ret = enet_peer_send(peer, channel_id, packet);
+	}
 	if (ret < 0) {
 		enet_packet_destroy(packet);
 	}
@@ -836,6 +1201,12 @@ static const struct luaL_Reg enet_host_funcs [] = {
 	{"service_time", host_service_time},
 	{"peer_count", host_peer_count},
 	{"get_peer", host_get_peer},
+
+	// love additions: zero-copy Data packets and threaded servicing
+	{"receive_as_data", host_receive_as_data},
+	{"start_service_thread", host_start_service_thread},
+	{"stop_service_thread", host_stop_service_thread},
+	{"receive_events", host_receive_events},
 	{NULL, NULL}
 };
 
@@ -868,6 +1239,9 @@ int luaopen_enet(lua_State *l) {
 	enet_initialize();
 	atexit(enet_deinitialize);
 
+	love::luax_register_type(l, &PacketData::type, love::data::w_Data_functions, nullptr);
+	love::data::luax_rundatawrapper(l, PacketData::type);
+
 	// create metatables
 	luaL_newmetatable(l, "enet_host");
 	lua_newtable(l); // index
@@ -26,6 +26,11 @@
 #include <cmath>
 #include <iostream>
 
+// Put the Lua code directly into a raw string literal.
+static const char source_lua[] =
+#include "wrap_Source.lua"
+;
+
 namespace love
 {
 namespace audio
@@ -609,6 +614,38 @@ int w_Source_getChannels(lua_State *L)
 	return w_Source_getChannelCount(L);
 }
 
+// C functions in a struct, necessary for the FFI versions of Source functions.
+struct FFI_Source
+{
+	// Returns false if the Source is invalid or can't be positioned. The Lua
+	// side then falls back to the regular method to raise the error.
+	bool (*setPosition)(Proxy *p, float x, float y, float z);
+};
+
+static FFI_Source ffifuncs =
+{
+	[](Proxy *p, float x, float y, float z) -> bool // setPosition
+	{
+		Source *t = luax_ffi_checktype<Source>(p);
+		if (t == nullptr)
+			return false;
+
+		float v[3] = {x, y, z};
+
+		// Exceptions can't propagate through LuaJIT's FFI.
+		try
+		{
+			t->setPosition(v);
+		}
+		catch (std::exception &)
+		{
+			return false;
+		}
+
+		return true;
+	},
+};
+
 static const luaL_Reg w_Source_functions[] =
 {
 	{ "clone", w_Source_clone },
@@ -670,7 +707,11 @@ static const luaL_Reg w_Source_functions[] =
 
 extern "C" int luaopen_source(lua_State *L)
 {
-	return luax_register_type(L, &love::audio::Source::type, w_Source_functions, nullptr);
+	int n = luax_register_type(L, &love::audio::Source::type, w_Source_functions, nullptr);
+
+	luax_runwrapper(L, source_lua, sizeof(source_lua), "Source.lua", love::audio::Source::type, &ffifuncs);
+
+	return n;
 }
 
 } // audio
@@ -0,0 +1,69 @@
+R"luastring"--(
+-- DO NOT REMOVE THE ABOVE LINE. It is used to load this file as a C++ string.
+-- There is a matching delimiter at the bottom of the file.
+
+--[[
+Copyright (c) 2006-2023 LOVE Development Team
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+claim that you wrote the original software. If you use this software
+in a product, an acknowledgment in the product documentation would be
+appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+--]]
+
+
+local Source_mt, ffifuncspointer_str = ...
+local Source = Source_mt.__index
+
+local type = type
+
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+-- Matches the struct declaration in wrap_Source.cpp.
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_Source
+{
+	bool (*setPosition)(Proxy *p, float x, float y, float z);
+} FFI_Source;
+]])
+
+local ffifuncs = ffi.cast("FFI_Source **", ffifuncspointer_str)[0]
+
+-- The regular method handles non-number arguments (and raises the appropriate
+-- errors) when the FFI version can't be used.
+local _setPosition = Source.setPosition
+
+
+-- Overwrite some regular Source methods with FFI implementations.
+
+function Source:setPosition(x, y, z)
+	local fz = z == nil and 0 or z
+	if type(x) == "number" and type(y) == "number" and type(fz) == "number"
+		and ffifuncs.setPosition(self, x, y, fz) then
+		return
+	end
+	return _setPosition(self, x, y, z)
+end
+
+-- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
+--)luastring"--"
@@ -0,0 +1,352 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "BlockCompressedData.h"
+#include "common/Exception.h"
+#include "thread/JobSystem.h"
+
+// C++
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+
+namespace love
+{
+namespace data
+{
+
+namespace
+{
+
+// Container layout, with all values little-endian:
+//   char[4] magic ("LBCD")
+//   uint8   version
+//   uint8   format (a Compressor::Format value)
+//   uint16  reserved
+//   uint32  block size
+//   uint32  block count
+//   uint64  uncompressed size
+//   uint64  block offsets[block count + 1], relative to the end of the table
+//   ...     compressed blocks, as produced by Compressor::compress
+const char MAGIC[4] = {'L', 'B', 'C', 'D'};
+const uint8 VERSION = 1;
+const size_t FIXED_HEADER_SIZE = 24;
+
+void writeLE(char *dst, uint64 v, int bytes)
+{
+	for (int i = 0; i < bytes; i++)
+		dst[i] = (char) ((v >> (i * 8)) & 0xFF);
+}
+
+uint64 readLE(const char *src, int bytes)
+{
+	uint64 v = 0;
+	for (int i = 0; i < bytes; i++)
+		v |= (uint64) (uint8) src[i] << (i * 8);
+	return v;
+}
+
+/**
+ * Runs a function for every index in [0, count) on the shared JobSystem,
+ * including the calling thread.
+ **/
+void parallelFor(size_t count, const std::function<void(size_t)> &func)
+{
+	thread::JobSystem::getInstance()->parallelFor((int) count, 1, [&](int first, int last)
+	{
+		for (int i = first; i < last; i++)
+			func((size_t) i);
+	});
+}
+
+} // anonymous namespace
+
+love::Type BlockCompressedData::type("BlockCompressedData", &Data::type);
+
+BlockCompressedData::BlockCompressedData(Compressor::Format format, const char *rawbytes, size_t rawsize, int level, size_t blocksize)
+	: data(nullptr)
+	, dataSize(0)
+	, format(format)
+	, blockSize(blocksize)
+	, blockCount(0)
+	, rawSize(rawsize)
+{
+	if (blocksize == 0 || blocksize > MAX_BLOCK_SIZE)
+		throw love::Exception("Block size must be between 1 and %d bytes.", (int) MAX_BLOCK_SIZE);
+
+	Compressor *compressor = Compressor::getCompressor(format);
+	if (compressor == nullptr)
+		throw love::Exception("Invalid compression format.");
+
+	size_t count = rawsize / blocksize + (rawsize % blocksize != 0 ? 1 : 0);
+	if (count >= std::numeric_limits<uint32>::max())
+		throw love::Exception("Too many blocks; use a larger block size.");
+
+	std::vector<char *> blocks(count, nullptr);
+	std::vector<size_t> blocksizes(count, 0);
+
+	try
+	{
+		parallelFor(count, [&](size_t i)
+		{
+			size_t offset = i * blocksize;
+			size_t size = std::min(blocksize, rawsize - offset);
+			blocks[i] = compressor->compress(format, rawbytes + offset, size, level, blocksizes[i]);
+		});
+
+		size_t headersize = FIXED_HEADER_SIZE + (count + 1) * sizeof(uint64);
+
+		dataSize = headersize;
+		for (size_t size : blocksizes)
+			dataSize += size;
+
+		data = new char[dataSize];
+	}
+	catch (std::bad_alloc &)
+	{
+		for (char *block : blocks)
+			delete[] block;
+		throw love::Exception("Out of memory.");
+	}
+	catch (std::exception &)
+	{
+		for (char *block : blocks)
+			delete[] block;
+		throw;
+	}
+
+	memcpy(data, MAGIC, sizeof(MAGIC));
+	data[4] = (char) VERSION;
+	data[5] = (char) format;
+	writeLE(data + 6, 0, 2);
+	writeLE(data + 8, blocksize, 4);
+	writeLE(data + 12, count, 4);
+	writeLE(data + 16, rawsize, 8);
+
+	char *table = data + FIXED_HEADER_SIZE;
+	char *dst = table + (count + 1) * sizeof(uint64);
+	uint64 offset = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		writeLE(table + i * sizeof(uint64), offset, 8);
+
+		memcpy(dst + offset, blocks[i], blocksizes[i]);
+		offset += blocksizes[i];
+
+		delete[] blocks[i];
+	}
+
+	writeLE(table + count * sizeof(uint64), offset, 8);
+
+	parseHeader();
+}
+
+BlockCompressedData::BlockCompressedData(const void *containerbytes, size_t size)
+	: data(nullptr)
+	, dataSize(size)
+	, format(Compressor::FORMAT_MAX_ENUM)
+	, blockSize(0)
+	, blockCount(0)
+	, rawSize(0)
+{
+	try
+	{
+		data = new char[size];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	memcpy(data, containerbytes, size);
+
+	try
+	{
+		parseHeader();
+	}
+	catch (love::Exception &)
+	{
+		delete[] data;
+		throw;
+	}
+}
+
+BlockCompressedData::BlockCompressedData(const BlockCompressedData &c)
+	: data(nullptr)
+	, dataSize(c.dataSize)
+	, format(c.format)
+	, blockSize(c.blockSize)
+	, blockCount(c.blockCount)
+	, rawSize(c.rawSize)
+	, offsets(c.offsets)
+{
+	try
+	{
+		data = new char[dataSize];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	memcpy(data, c.data, dataSize);
+}
+
+BlockCompressedData::~BlockCompressedData()
+{
+	delete[] data;
+}
+
+void BlockCompressedData::parseHeader()
+{
+	const char *invalid = "Invalid block-compressed data.";
+
+	if (dataSize < FIXED_HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+		throw love::Exception(invalid);
+
+	if ((uint8) data[4] != VERSION)
+		throw love::Exception("Unsupported block-compressed data version: %d", (int) (uint8) data[4]);
+
+	uint8 f = (uint8) data[5];
+	uint64 bsize = readLE(data + 8, 4);
+	uint64 count = readLE(data + 12, 4);
+	uint64 rsize = readLE(data + 16, 8);
+
+	if (f >= Compressor::FORMAT_MAX_ENUM || bsize == 0 || bsize > MAX_BLOCK_SIZE)
+		throw love::Exception(invalid);
+
+	if (rsize > std::numeric_limits<size_t>::max() || count != rsize / bsize + (rsize % bsize != 0 ? 1 : 0))
+		throw love::Exception(invalid);
+
+	size_t tablesize = ((size_t) count + 1) * sizeof(uint64);
+	if (dataSize - FIXED_HEADER_SIZE < tablesize)
+		throw love::Exception(invalid);
+
+	const char *table = data + FIXED_HEADER_SIZE;
+	size_t blocksstart = FIXED_HEADER_SIZE + tablesize;
+
+	offsets.resize((size_t) count + 1);
+
+	for (size_t i = 0; i <= count; i++)
+	{
+		uint64 offset = readLE(table + i * sizeof(uint64), 8);
+
+		if (offset > dataSize - blocksstart || (i > 0 && blocksstart + offset < offsets[i - 1]))
+			throw love::Exception(invalid);
+
+		offsets[i] = blocksstart + (size_t) offset;
+	}
+
+	if (offsets[0] != blocksstart || offsets[count] != dataSize)
+		throw love::Exception(invalid);
+
+	format = (Compressor::Format) f;
+	blockSize = (size_t) bsize;
+	blockCount = (size_t) count;
+	rawSize = (size_t) rsize;
+}
+
+size_t BlockCompressedData::getDecompressedBlockSize(size_t index) const
+{
+	if (index >= blockCount)
+		throw love::Exception("Invalid block index.");
+
+	return std::min(blockSize, rawSize - index * blockSize);
+}
+
+char *BlockCompressedData::decompressBlock(size_t index, size_t &decompressedsize) const
+{
+	size_t expectedsize = getDecompressedBlockSize(index);
+
+	Compressor *compressor = Compressor::getCompressor(format);
+	if (compressor == nullptr)
+		throw love::Exception("Invalid compression format.");
+
+	// A known size makes LZ4 skip its bounds checks, which isn't safe for
+	// containers loaded from files.
+	decompressedsize = format == Compressor::FORMAT_LZ4 ? 0 : expectedsize;
+
+	const char *src = data + offsets[index];
+	size_t srcsize = offsets[index + 1] - offsets[index];
+
+	char *rawbytes = compressor->decompress(format, src, srcsize, decompressedsize);
+
+	if (decompressedsize != expectedsize)
+	{
+		delete[] rawbytes;
+		throw love::Exception("Could not decompress block %d: unexpected size.", (int) index + 1);
+	}
+
+	return rawbytes;
+}
+
+char *BlockCompressedData::decompress(size_t &decompressedsize) const
+{
+	char *rawbytes = nullptr;
+
+	try
+	{
+		rawbytes = new char[std::max(rawSize, (size_t) 1)];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	try
+	{
+		parallelFor(blockCount, [&](size_t i)
+		{
+			size_t size = 0;
+			char *block = decompressBlock(i, size);
+			memcpy(rawbytes + i * blockSize, block, size);
+			delete[] block;
+		});
+	}
+	catch (std::exception &)
+	{
+		delete[] rawbytes;
+		throw;
+	}
+
+	decompressedsize = rawSize;
+	return rawbytes;
+}
+
+BlockCompressedData *BlockCompressedData::clone() const
+{
+	return new BlockCompressedData(*this);
+}
+
+void *BlockCompressedData::getData() const
+{
+	return data;
+}
+
+size_t BlockCompressedData::getSize() const
+{
+	return dataSize;
+}
+
+} // data
+} // love
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Data.h"
+#include "common/int.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * A container of independently compressed blocks, with an index of where each
+ * block starts. Blocks are compressed and decompressed on several threads, and
+ * a single block can be decompressed without touching the rest.
+ **/
+class BlockCompressedData : public love::Data
+{
+public:
+
+	static love::Type type;
+
+	static const size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+	static const size_t MAX_BLOCK_SIZE = 1024 * 1024 * 1024;
+
+	/**
+	 * Compresses the given data in blocks of blocksize bytes.
+	 **/
+	BlockCompressedData(Compressor::Format format, const char *rawbytes, size_t rawsize, int level, size_t blocksize);
+
+	/**
+	 * Copies an existing container, for example one loaded from a file. Throws
+	 * an exception if it isn't a valid container.
+	 **/
+	BlockCompressedData(const void *containerbytes, size_t size);
+
+	BlockCompressedData(const BlockCompressedData &c);
+	virtual ~BlockCompressedData();
+
+	Compressor::Format getFormat() const { return format; }
+	size_t getBlockSize() const { return blockSize; }
+	size_t getBlockCount() const { return blockCount; }
+	size_t getDecompressedSize() const { return rawSize; }
+
+	/**
+	 * Gets the uncompressed size of a specific block. Only the last block can
+	 * be smaller than the block size.
+	 **/
+	size_t getDecompressedBlockSize(size_t index) const;
+
+	/**
+	 * Decompresses a single block. The result is allocated with new[].
+	 **/
+	char *decompressBlock(size_t index, size_t &decompressedsize) const;
+
+	/**
+	 * Decompresses every block. The result is allocated with new[].
+	 **/
+	char *decompress(size_t &decompressedsize) const;
+
+	// Implements Data.
+	BlockCompressedData *clone() const override;
+	void *getData() const override;
+	size_t getSize() const override;
+
+private:
+
+	void parseHeader();
+
+	char *data;
+	size_t dataSize;
+
+	Compressor::Format format;
+	size_t blockSize;
+	size_t blockCount;
+	size_t rawSize;
+
+	// Block i is stored in the range [offsets[i], offsets[i+1]) of the data.
+	std::vector<size_t> offsets;
+
+}; // BlockCompressedData
+
+} // data
+} // love
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "CompressionStream.h"
+#include "common/Exception.h"
+
+namespace love
+{
+namespace data
+{
+
+love::Type CompressionStream::type("CompressionStream", &Object::type);
+
+CompressionStream::CompressionStream(Mode mode, Compressor::Format format, int level)
+	: mode(mode)
+	, format(format)
+	, stream(nullptr)
+{
+	Compressor *compressor = Compressor::getCompressor(format);
+	if (compressor == nullptr)
+		throw love::Exception("Invalid compression format.");
+
+	if (mode == MODE_COMPRESS)
+		stream = compressor->newCompressStream(format, level);
+	else
+		stream = compressor->newDecompressStream(format);
+}
+
+CompressionStream::~CompressionStream()
+{
+	delete stream;
+}
+
+void CompressionStream::process(const char *data, size_t size, bool finish, std::vector<char> &output)
+{
+	stream->process(data, size, finish, output);
+}
+
+bool CompressionStream::isFinished() const
+{
+	return stream->isFinished();
+}
+
+} // data
+} // love
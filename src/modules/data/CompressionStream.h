@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Compresses or decompresses data incrementally, so large inputs don't need
+ * to be held in memory all at once.
+ **/
+class CompressionStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Mode
+	{
+		MODE_COMPRESS,
+		MODE_DECOMPRESS,
+	};
+
+	CompressionStream(Mode mode, Compressor::Format format, int level = -1);
+	virtual ~CompressionStream();
+
+	Mode getMode() const { return mode; }
+	Compressor::Format getFormat() const { return format; }
+
+	/**
+	 * Feeds more input into the stream, and appends any output produced to
+	 * the given vector. When finish is true, all remaining output is produced
+	 * and no more input can be given afterwards.
+	 **/
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output);
+
+	bool isFinished() const;
+
+private:
+
+	Mode mode;
+	Compressor::Format format;
+	Compressor::Stream *stream;
+
+}; // CompressionStream
+
+} // data
+} // love
@@ -28,11 +28,231 @@
 
 #include <zlib.h>
 
+// C++
+#include <algorithm>
+#include <limits>
+
 namespace love
 {
 namespace data
 {
 
+// LZ4 streams are split into blocks of at most this size. Each block can
+// refer back to the previous 64 KB of the stream.
+static const int LZ4_STREAM_BLOCK_SIZE = 64 * 1024;
+static const int LZ4_STREAM_DICT_SIZE = 64 * 1024;
+
+// Each LZ4 stream block is preceded by its uncompressed and compressed sizes.
+// A block with an uncompressed size of 0 marks the end of the stream.
+static const size_t LZ4_STREAM_HEADER_SIZE = sizeof(uint32) * 2;
+
+static void writeUint32LE(char *dst, uint32 v)
+{
+	for (int i = 0; i < 4; i++)
+		dst[i] = (char) ((v >> (i * 8)) & 0xFF);
+}
+
+static uint32 readUint32LE(const char *src)
+{
+	uint32 v = 0;
+	for (int i = 0; i < 4; i++)
+		v |= (uint32) (uint8) src[i] << (i * 8);
+	return v;
+}
+
+class LZ4CompressStream : public Compressor::Stream
+{
+public:
+
+	LZ4CompressStream(int level)
+		: highCompression(level > 8)
+		, stream(nullptr)
+		, streamHC(nullptr)
+		, finished(false)
+	{
+		if (highCompression)
+		{
+			streamHC = LZ4_createStreamHC();
+			if (streamHC != nullptr)
+				LZ4_resetStreamHC(streamHC, LZ4HC_CLEVEL_DEFAULT);
+		}
+		else
+			stream = LZ4_createStream();
+
+		if (stream == nullptr && streamHC == nullptr)
+			throw love::Exception("Out of memory.");
+
+		block.reserve(LZ4_STREAM_BLOCK_SIZE);
+		dict.resize(LZ4_STREAM_DICT_SIZE);
+	}
+
+	virtual ~LZ4CompressStream()
+	{
+		if (stream != nullptr)
+			LZ4_freeStream(stream);
+		if (streamHC != nullptr)
+			LZ4_freeStreamHC(streamHC);
+	}
+
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output) override
+	{
+		if (finished)
+			throw love::Exception("Cannot add data to a finished compression stream.");
+
+		while (size > 0)
+		{
+			size_t count = std::min(size, (size_t) LZ4_STREAM_BLOCK_SIZE - block.size());
+			block.insert(block.end(), data, data + count);
+
+			data += count;
+			size -= count;
+
+			if (block.size() == (size_t) LZ4_STREAM_BLOCK_SIZE)
+				compressBlock(output);
+		}
+
+		if (finish)
+		{
+			if (!block.empty())
+				compressBlock(output);
+
+			size_t offset = output.size();
+			output.resize(offset + LZ4_STREAM_HEADER_SIZE);
+			writeUint32LE(&output[offset], 0);
+			writeUint32LE(&output[offset + sizeof(uint32)], 0);
+
+			finished = true;
+		}
+	}
+
+	bool isFinished() const override
+	{
+		return finished;
+	}
+
+private:
+
+	void compressBlock(std::vector<char> &output)
+	{
+		int rawsize = (int) block.size();
+		int maxsize = LZ4_compressBound(rawsize);
+
+		size_t offset = output.size();
+		output.resize(offset + LZ4_STREAM_HEADER_SIZE + maxsize);
+		char *dst = &output[offset + LZ4_STREAM_HEADER_SIZE];
+
+		int csize = 0;
+		if (highCompression)
+			csize = LZ4_compress_HC_continue(streamHC, block.data(), dst, rawsize, maxsize);
+		else
+			csize = LZ4_compress_fast_continue(stream, block.data(), dst, rawsize, maxsize, 1);
+
+		if (csize <= 0)
+			throw love::Exception("Could not LZ4-compress data.");
+
+		writeUint32LE(&output[offset], (uint32) rawsize);
+		writeUint32LE(&output[offset + sizeof(uint32)], (uint32) csize);
+		output.resize(offset + LZ4_STREAM_HEADER_SIZE + csize);
+
+		// The next block refers back to this one, but the block buffer is
+		// about to be reused, so the history has to be copied somewhere safe.
+		if (highCompression)
+			LZ4_saveDictHC(streamHC, dict.data(), LZ4_STREAM_DICT_SIZE);
+		else
+			LZ4_saveDict(stream, dict.data(), LZ4_STREAM_DICT_SIZE);
+
+		block.clear();
+	}
+
+	bool highCompression;
+
+	LZ4_stream_t *stream;
+	LZ4_streamHC_t *streamHC;
+
+	std::vector<char> block;
+	std::vector<char> dict;
+
+	bool finished;
+
+}; // LZ4CompressStream
+
+class LZ4DecompressStream : public Compressor::Stream
+{
+public:
+
+	LZ4DecompressStream()
+		: finished(false)
+	{
+	}
+
+	virtual ~LZ4DecompressStream() {}
+
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output) override
+	{
+		if (!finished)
+			pending.insert(pending.end(), data, data + size);
+
+		size_t offset = 0;
+
+		while (!finished && pending.size() - offset >= LZ4_STREAM_HEADER_SIZE)
+		{
+			uint32 rawsize = readUint32LE(&pending[offset]);
+			uint32 csize = readUint32LE(&pending[offset + sizeof(uint32)]);
+
+			if (rawsize == 0)
+			{
+				finished = true;
+				offset += LZ4_STREAM_HEADER_SIZE;
+				break;
+			}
+
+			if (rawsize > (uint32) LZ4_STREAM_BLOCK_SIZE || csize > (uint32) LZ4_compressBound(LZ4_STREAM_BLOCK_SIZE))
+				throw love::Exception("Could not decompress LZ4-compressed data.");
+
+			if (pending.size() - offset - LZ4_STREAM_HEADER_SIZE < csize)
+				break;
+
+			size_t outoffset = output.size();
+			output.resize(outoffset + rawsize);
+
+			int result = LZ4_decompress_safe_usingDict(&pending[offset + LZ4_STREAM_HEADER_SIZE],
+			                                           &output[outoffset], (int) csize, (int) rawsize,
+			                                           history.data(), (int) history.size());
+
+			if (result != (int) rawsize)
+				throw love::Exception("Could not decompress LZ4-compressed data.");
+
+			// Keep the most recent 64 KB around for the next block to refer to.
+			history.insert(history.end(), output.begin() + outoffset, output.end());
+			if (history.size() > (size_t) LZ4_STREAM_DICT_SIZE)
+				history.erase(history.begin(), history.end() - LZ4_STREAM_DICT_SIZE);
+
+			offset += LZ4_STREAM_HEADER_SIZE + csize;
+		}
+
+		if (finished)
+			pending.clear();
+		else
+			pending.erase(pending.begin(), pending.begin() + offset);
+
+		if (finish && !finished)
+			throw love::Exception("Could not decompress LZ4-compressed data: unexpected end of stream.");
+	}
+
+	bool isFinished() const override
+	{
+		return finished;
+	}
+
+private:
+
+	std::vector<char> pending;
+	std::vector<char> history;
+
+	bool finished;
+
+}; // LZ4DecompressStream
+
 class LZ4Compressor : public Compressor
 {
 public:
@@ -158,6 +378,22 @@ class LZ4Compressor : public Compressor
 		return rawbytes;
 	}
 
+	Stream *newCompressStream(Format format, int level) override
+	{
+		if (format != FORMAT_LZ4)
+			throw love::Exception("Invalid format (expecting LZ4)");
+
+		return new LZ4CompressStream(level);
+	}
+
+	Stream *newDecompressStream(Format format) override
+	{
+		if (format != FORMAT_LZ4)
+			throw love::Exception("Invalid format (expecting LZ4)");
+
+		return new LZ4DecompressStream();
+	}
+
 	bool isSupported(Format format) const override
 	{
 		return format == FORMAT_LZ4;
@@ -166,6 +402,159 @@ class LZ4Compressor : public Compressor
 }; // LZ4Compressor
 
 
+class zlibStream : public Compressor::Stream
+{
+public:
+
+	zlibStream(Compressor::Format format, int level, bool compressing)
+		: compressing(compressing)
+		, stream()
+		, finished(false)
+	{
+		int err = Z_OK;
+
+		if (compressing)
+		{
+			int windowbits = 15;
+			if (format == Compressor::FORMAT_GZIP)
+				windowbits += 16; // This tells zlib to use a gzip header.
+			else if (format == Compressor::FORMAT_DEFLATE)
+				windowbits = -windowbits;
+
+			err = deflateInit2(&stream, level, Z_DEFLATED, windowbits, 8, Z_DEFAULT_STRATEGY);
+		}
+		else
+		{
+			// 15 is the default. Adding 32 makes zlib auto-detect the header type.
+			int windowbits = 15 + 32;
+			if (format == Compressor::FORMAT_DEFLATE)
+				windowbits = -15;
+
+			err = inflateInit2(&stream, windowbits);
+		}
+
+		if (err == Z_MEM_ERROR)
+			throw love::Exception("Out of memory.");
+		else if (err != Z_OK)
+			throw love::Exception("Could not initialize zlib stream.");
+	}
+
+	virtual ~zlibStream()
+	{
+		if (compressing)
+			deflateEnd(&stream);
+		else
+			inflateEnd(&stream);
+	}
+
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output) override
+	{
+		if (finished)
+		{
+			if (compressing)
+				throw love::Exception("Cannot add data to a finished compression stream.");
+			return;
+		}
+
+		// zlib's sizes are 32 bit, so very large inputs are fed in pieces.
+		const size_t maxchunk = std::numeric_limits<uInt>::max() / 2;
+
+		do
+		{
+			size_t count = std::min(size, maxchunk);
+			bool last = count == size;
+
+			stream.next_in = (Bytef *) data;
+			stream.avail_in = (uInt) count;
+
+			if (compressing)
+				deflateChunk(finish && last, output);
+			else
+				inflateChunk(output);
+
+			data += count;
+			size -= count;
+		}
+		while (size > 0 && !finished);
+
+		if (finish && !finished)
+			throw love::Exception("Could not decompress zlib/gzip-compressed data: unexpected end of stream.");
+	}
+
+	bool isFinished() const override
+	{
+		return finished;
+	}
+
+private:
+
+	static const size_t OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+	void deflateChunk(bool finish, std::vector<char> &output)
+	{
+		int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+
+		while (true)
+		{
+			size_t offset = output.size();
+			output.resize(offset + OUTPUT_CHUNK_SIZE);
+
+			stream.next_out = (Bytef *) &output[offset];
+			stream.avail_out = (uInt) OUTPUT_CHUNK_SIZE;
+
+			int err = deflate(&stream, flush);
+			output.resize(output.size() - stream.avail_out);
+
+			if (err == Z_STREAM_END)
+			{
+				finished = true;
+				break;
+			}
+			else if (err != Z_OK && err != Z_BUF_ERROR)
+				throw love::Exception("Could not zlib/gzip-compress data.");
+
+			// deflate only leaves output space unused once it's consumed all of
+			// its input and has nothing more to write yet.
+			if (stream.avail_out != 0 && !finish)
+				break;
+		}
+	}
+
+	void inflateChunk(std::vector<char> &output)
+	{
+		while (true)
+		{
+			size_t offset = output.size();
+			output.resize(offset + OUTPUT_CHUNK_SIZE);
+
+			stream.next_out = (Bytef *) &output[offset];
+			stream.avail_out = (uInt) OUTPUT_CHUNK_SIZE;
+
+			int err = inflate(&stream, Z_NO_FLUSH);
+			output.resize(output.size() - stream.avail_out);
+
+			if (err == Z_STREAM_END)
+			{
+				// Anything after the end of the stream is ignored.
+				finished = true;
+				break;
+			}
+			else if (err == Z_MEM_ERROR)
+				throw love::Exception("Out of memory.");
+			else if (err != Z_OK && err != Z_BUF_ERROR)
+				throw love::Exception("Could not decompress zlib/gzip-compressed data.");
+
+			if (stream.avail_out != 0)
+				break;
+		}
+	}
+
+	bool compressing;
+	z_stream stream;
+	bool finished;
+
+}; // zlibStream
+
 class zlibCompressor : public Compressor
 {
 private:
@@ -351,6 +740,27 @@ class zlibCompressor : public Compressor
 		return rawbytes;
 	}
 
+	Stream *newCompressStream(Format format, int level) override
+	{
+		if (!isSupported(format))
+			throw love::Exception("Invalid format (expecting zlib or gzip)");
+
+		if (level < 0)
+			level = Z_DEFAULT_COMPRESSION;
+		else if (level > 9)
+			level = 9;
+
+		return new zlibStream(format, level, true);
+	}
+
+	Stream *newDecompressStream(Format format) override
+	{
+		if (!isSupported(format))
+			throw love::Exception("Invalid format (expecting zlib or gzip)");
+
+		return new zlibStream(format, 0, false);
+	}
+
 	bool isSupported(Format format) const override
 	{
 		return format == FORMAT_ZLIB || format == FORMAT_GZIP || format == FORMAT_DEFLATE;
@@ -23,6 +23,9 @@
 // LOVE
 #include "common/StringMap.h"
 
+// C++
+#include <vector>
+
 namespace love
 {
 namespace data
@@ -44,6 +47,33 @@ class Compressor
 		FORMAT_MAX_ENUM
 	};
 
+	/**
+	 * Incrementally compresses or decompresses data which arrives in multiple
+	 * pieces.
+	 **/
+	class Stream
+	{
+	public:
+
+		virtual ~Stream() {}
+
+		/**
+		 * Feeds more input into the stream.
+		 *
+		 * @param[in] data The input data.
+		 * @param[in] size The size in bytes of the input data.
+		 * @param[in] finish Whether this is the last of the input.
+		 * @param[out] output Any output produced is appended to this.
+		 **/
+		virtual void process(const char *data, size_t size, bool finish, std::vector<char> &output) = 0;
+
+		/**
+		 * Gets whether the end of the stream has been reached.
+		 **/
+		virtual bool isFinished() const = 0;
+
+	}; // Stream
+
 	/**
 	 * Gets a Compressor that can compress and decompress a specific format.
 	 * Returns null if there are no supported compressors for the given format.
@@ -81,6 +111,23 @@ class Compressor
 	 **/
 	virtual char *decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize) = 0;
 
+	/**
+	 * Creates a new Stream which compresses its input.
+	 *
+	 * LZ4 streams are a sequence of linked blocks rather than the single block
+	 * produced by compress(), so the two aren't interchangeable.
+	 *
+	 * @return A new Stream, owned by the caller.
+	 **/
+	virtual Stream *newCompressStream(Format format, int level) = 0;
+
+	/**
+	 * Creates a new Stream which decompresses its input.
+	 *
+	 * @return A new Stream, owned by the caller.
+	 **/
+	virtual Stream *newDecompressStream(Format format) = 0;
+
 	/**
 	 * Gets whether a specific format is supported by this backend.
 	 **/
@@ -221,6 +221,26 @@ DataModule::~DataModule()
 {
 }
 
+Hasher *DataModule::newHasher(HashFunction::Function function)
+{
+	return new Hasher(function);
+}
+
+CompressionStream *DataModule::newCompressionStream(CompressionStream::Mode mode, Compressor::Format format, int level)
+{
+	return new CompressionStream(mode, format, level);
+}
+
+BlockCompressedData *DataModule::newBlockCompressedData(Compressor::Format format, const char *rawbytes, size_t rawsize, int level, size_t blocksize)
+{
+	return new BlockCompressedData(format, rawbytes, rawsize, level, blocksize);
+}
+
+BlockCompressedData *DataModule::newBlockCompressedData(const void *containerbytes, size_t size)
+{
+	return new BlockCompressedData(containerbytes, size);
+}
+
 DataView *DataModule::newDataView(Data *data, size_t offset, size_t size)
 {
 	return new DataView(data, offset, size);
@@ -24,6 +24,9 @@
 #include "Compressor.h"
 #include "HashFunction.h"
 #include "DataView.h"
+#include "Hasher.h"
+#include "CompressionStream.h"
+#include "BlockCompressedData.h"
 #include "ByteData.h"
 
 // LOVE
@@ -125,6 +128,10 @@ class DataModule : public Module
 	ByteData *newByteData(size_t size);
 	ByteData *newByteData(const void *d, size_t size);
 	ByteData *newByteData(void *d, size_t size, bool own);
+	Hasher *newHasher(HashFunction::Function function);
+	CompressionStream *newCompressionStream(CompressionStream::Mode mode, Compressor::Format format, int level = -1);
+	BlockCompressedData *newBlockCompressedData(Compressor::Format format, const char *rawbytes, size_t rawsize, int level, size_t blocksize);
+	BlockCompressedData *newBlockCompressedData(const void *containerbytes, size_t size);
 
 }; // DataModule
 
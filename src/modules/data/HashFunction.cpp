@@ -19,6 +19,11 @@
  **/
 
 #include "HashFunction.h"
+#include "libraries/xxHash/xxhash.h"
+
+// C++
+#include <algorithm>
+#include <memory>
 
 // FIXME: Probably trivial by having tole and tobe functions, which can be ifdeffed to being identity functions
 #ifdef LOVE_BIG_ENDIAN
@@ -50,13 +55,104 @@ inline uint64 rightrot(uint64 x, uint8 amount)
 	return (x >> amount) | (x << (64 - amount));
 }
 
-// Extend the value of `a` to make it a multiple of `n`.
-inline uint64 extend_multiple(uint64 a, uint64 n)
+inline uint32 loadBE32(const uint8 *b)
+{
+	return ((uint32) b[0] << 24) | ((uint32) b[1] << 16) | ((uint32) b[2] << 8) | (uint32) b[3];
+}
+
+inline uint64 loadBE64(const uint8 *b)
 {
-	uint64 r = a % n;
-	return r == 0 ? a : a + (n-r);
+	return ((uint64) loadBE32(b) << 32) | (uint64) loadBE32(b + 4);
 }
 
+/**
+ * MD5 and SHA consume their input in fixed-size blocks, and finish with a
+ * padding bit and the input's length in bits. Partial blocks are buffered
+ * between updates, so input can arrive in pieces of any size.
+ **/
+template <size_t BLOCKSIZE, size_t LENGTHSIZE, bool BIGENDIAN>
+class BlockContext : public HashFunction::State
+{
+public:
+
+	BlockContext()
+		: buffered(0)
+		, totalLength(0)
+	{}
+
+	virtual ~BlockContext() {}
+
+	void update(const char *input, uint64 length) override
+	{
+		const uint8 *in = (const uint8 *) input;
+		totalLength += length;
+
+		if (buffered > 0)
+		{
+			size_t count = (size_t) std::min<uint64>(length, BLOCKSIZE - buffered);
+			memcpy(buffer + buffered, in, count);
+
+			buffered += count;
+			in += count;
+			length -= count;
+
+			if (buffered < BLOCKSIZE)
+				return;
+
+			processBlock(buffer);
+			buffered = 0;
+		}
+
+		for (; length >= BLOCKSIZE; in += BLOCKSIZE, length -= BLOCKSIZE)
+			processBlock(in);
+
+		memcpy(buffer, in, (size_t) length);
+		buffered = (size_t) length;
+	}
+
+	void finish(HashFunction::Value &output) override
+	{
+		uint64 bit_length = totalLength * 8;
+
+		buffer[buffered++] = 0x80; // append bit
+
+		// Not enough room left for the length, so it goes in an extra block.
+		if (buffered > BLOCKSIZE - LENGTHSIZE)
+		{
+			memset(buffer + buffered, 0, BLOCKSIZE - buffered);
+			processBlock(buffer);
+			buffered = 0;
+		}
+
+		memset(buffer + buffered, 0, BLOCKSIZE - buffered);
+
+		// Append length in bits. Only its low 64 bits are ever used.
+		uint8 *lengthbytes = buffer + BLOCKSIZE - 8;
+		for (int i = 0; i < 8; i++)
+		{
+			if (BIGENDIAN)
+				lengthbytes[i] = (bit_length >> (56 - i * 8)) & 0xFF;
+			else
+				lengthbytes[i] = (bit_length >> (i * 8)) & 0xFF;
+		}
+
+		processBlock(buffer);
+		getDigest(output);
+	}
+
+protected:
+
+	virtual void processBlock(const uint8 *block) = 0;
+	virtual void getDigest(HashFunction::Value &output) const = 0;
+
+private:
+
+	uint8 buffer[BLOCKSIZE];
+	size_t buffered;
+	uint64 totalLength;
+
+}; // BlockContext
+
 /**
  * The following implementation is based on the pseudocode provided by multiple
  * authors on wikipedia: https://en.wikipedia.org/wiki/MD5
@@ -70,38 +166,23 @@ class MD5 : public HashFunction
 	static const uint8 shifts[64];
 	static const uint32 constants[64];
 
-public:
-	bool isSupported(Function function) const override
-	{
-		return function == FUNCTION_MD5;
-	}
-
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	class Context : public BlockContext<64, 8, false>
 	{
-		if (function != FUNCTION_MD5)
-			throw love::Exception("Hash function not supported by MD5 implementation");
+	public:
 
-		uint32 a0 = 0x67452301;
-		uint32 b0 = 0xefcdab89;
-		uint32 c0 = 0x98badcfe;
-		uint32 d0 = 0x10325476;
+		Context()
+			: a0(0x67452301)
+			, b0(0xefcdab89)
+			, c0(0x98badcfe)
+			, d0(0x10325476)
+		{}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
+	protected:
 
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits
-		uint64 bit_length = length * 8;
-		memcpy(((uint8*)padded) + paddedLength - 8, &bit_length, 8);
-
-		// Process chunks
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		void processBlock(const uint8 *block) override
 		{
-			uint32 *chunk = &padded[i];
+			uint32 chunk[16];
+			memcpy(chunk, block, 64);
 
 			uint32 A = a0;
 			uint32 B = b0;
@@ -146,13 +227,33 @@ class MD5 : public HashFunction
 			d0 += D;
 		}
 
-		delete[] padded;
+		void getDigest(Value &output) const override
+		{
+			memcpy(&output.data[ 0], &a0, 4);
+			memcpy(&output.data[ 4], &b0, 4);
+			memcpy(&output.data[ 8], &c0, 4);
+			memcpy(&output.data[12], &d0, 4);
+			output.size = 16;
+		}
 
-		memcpy(&output.data[ 0], &a0, 4);
-		memcpy(&output.data[ 4], &b0, 4);
-		memcpy(&output.data[ 8], &c0, 4);
-		memcpy(&output.data[12], &d0, 4);
-		output.size = 16;
+	private:
+
+		uint32 a0, b0, c0, d0;
+
+	}; // Context
+
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_MD5;
+	}
+
+	HashFunction::State *newState(Function function) const override
+	{
+		if (function != FUNCTION_MD5)
+			throw love::Exception("Hash function not supported by MD5 implementation");
+
+		return new Context();
 	}
 } md5;
 
@@ -189,48 +290,25 @@ const uint32 MD5::constants[64] = {
  **/
 class SHA1 : public HashFunction
 {
-public:
-	bool isSupported(Function function) const override
-	{
-		return function == FUNCTION_SHA1;
-	}
+private:
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	class Context : public BlockContext<64, 8, true>
 	{
-		if (function != FUNCTION_SHA1)
-			throw love::Exception("Hash function not supported by SHA1 implementation");
+	public:
 
-		uint32 intermediate[5] = {
-			0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
-		};
+		Context()
+			: intermediate{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0}
+		{}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
+	protected:
 
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits (big endian)
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
-
-		// Allocate our extended words
-		uint32 words[80];
-
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		void processBlock(const uint8 *block) override
 		{
-			uint32 *chunk = &padded[i];
+			// Allocate our extended words
+			uint32 words[80];
+
 			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = loadBE32(block + j * 4);
 			for (int j = 16; j < 80; j++)
 				words[j] = leftrot(words[j-3] ^ words[j-8] ^ words[j-14] ^ words[j-16], 1);
 
@@ -267,17 +345,37 @@ class SHA1 : public HashFunction
 			intermediate[4] += E;
 		}
 
-		delete[] padded;
-
-		for (int i = 0; i < 20; i += 4)
+		void getDigest(Value &output) const override
 		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
+			for (int i = 0; i < 20; i += 4)
+			{
+				output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
+				output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
+				output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
+				output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
+			}
+
+			output.size = 20;
 		}
 
-		output.size = 20;
+	private:
+
+		uint32 intermediate[5];
+
+	}; // Context
+
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA1;
+	}
+
+	HashFunction::State *newState(Function function) const override
+	{
+		if (function != FUNCTION_SHA1)
+			throw love::Exception("Hash function not supported by SHA1 implementation");
+
+		return new Context();
 	}
 } sha1;
 
@@ -292,50 +390,28 @@ class SHA256 : public HashFunction
 	static const uint32 initial256[8];
 	static const uint32 constants[64];
 
-public:
-	bool isSupported(Function function) const override
+	class Context : public BlockContext<64, 8, true>
 	{
-		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
-	}
+	public:
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
-	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
-
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
-
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits (big endian)
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
-
-		uint32 intermediate[8];
-		if (function == FUNCTION_SHA224)
-			memcpy(intermediate, initial224, sizeof(intermediate));
-		else
-			memcpy(intermediate, initial256, sizeof(intermediate));
+		Context(Function function)
+			: hashlength(function == FUNCTION_SHA224 ? 28 : 32)
+		{
+			if (function == FUNCTION_SHA224)
+				memcpy(intermediate, initial224, sizeof(intermediate));
+			else
+				memcpy(intermediate, initial256, sizeof(intermediate));
+		}
 
-		// Allocate our extended words
-		uint32 words[64];
+	protected:
 
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		void processBlock(const uint8 *block) override
 		{
-			uint32 *chunk = &padded[i];
+			// Allocate our extended words
+			uint32 words[64];
+
 			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = loadBE32(block + j * 4);
 			for (int j = 16; j < 64; j++)
 			{
 				words[j] = rightrot(words[j-2], 17) ^ rightrot(words[j-2], 19) ^ (words[j-2] >> 10);
@@ -380,21 +456,38 @@ class SHA256 : public HashFunction
 			intermediate[7] += H;
 		}
 
-		delete[] padded;
-
-		int hashlength = 32;
-		if (function == FUNCTION_SHA224)
-			hashlength = 28;
-
-		for (int i = 0; i < hashlength; i += 4)
+		void getDigest(Value &output) const override
 		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
+			for (int i = 0; i < hashlength; i += 4)
+			{
+				output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
+				output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
+				output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
+				output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
+			}
+
+			output.size = hashlength;
 		}
 
-		output.size = hashlength;
+	private:
+
+		uint32 intermediate[8];
+		int hashlength;
+
+	}; // Context
+
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
+	}
+
+	HashFunction::State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
+
+		return new Context(function);
 	}
 } sha256;
 
@@ -438,55 +531,28 @@ class SHA512 : public HashFunction
 	static const uint64 initial512[8];
 	static const uint64 constants[80];
 
-public:
-	bool isSupported(Function function) const override
+	class Context : public BlockContext<128, 16, true>
 	{
-		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
-	}
-
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
-	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
-
-		uint64 intermediates[8];
-		if (function == FUNCTION_SHA384)
-			memcpy(intermediates, initial384, sizeof(intermediates));
-		else
-			memcpy(intermediates, initial512, sizeof(intermediates));
-
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 16, 128);
+	public:
 
-		uint64 *padded = new uint64[paddedLength / 8];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits (big endian), note we only write a 64-bit int, so
-		// we have filled the first 8 bytes with zeroes
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
+		Context(Function function)
+			: hashlength(function == FUNCTION_SHA384 ? 48 : 64)
+		{
+			if (function == FUNCTION_SHA384)
+				memcpy(intermediates, initial384, sizeof(intermediates));
+			else
+				memcpy(intermediates, initial512, sizeof(intermediates));
+		}
 
-		// Allocate our extended words
-		uint64 words[80];
+	protected:
 
-		for (uint64 i = 0; i < paddedLength/8; i += 16)
+		void processBlock(const uint8 *block) override
 		{
-			uint64 *chunk = &padded[i];
+			// Allocate our extended words
+			uint64 words[80];
+
 			for (int j = 0; j < 16; ++j)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 56) & 0xFF;
-				c[1] = (chunk[j] >> 48) & 0xFF;
-				c[2] = (chunk[j] >> 40) & 0xFF;
-				c[3] = (chunk[j] >> 32) & 0xFF;
-				c[4] = (chunk[j] >> 24) & 0xFF;
-				c[5] = (chunk[j] >> 16) & 0xFF;
-				c[6] = (chunk[j] >>  8) & 0xFF;
-				c[7] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = loadBE64(block + j * 8);
 			for (int j = 16; j < 80; ++j)
 			{
 				words[j] = words[j-7] + words[j-16];
@@ -530,25 +596,42 @@ class SHA512 : public HashFunction
 			intermediates[7] += H;
 		}
 
-		delete[] padded;
-
-		int hashlength = 64;
-		if (function == FUNCTION_SHA384)
-			hashlength = 48;
-
-		for (int i = 0; i < hashlength; i += 8)
+		void getDigest(Value &output) const override
 		{
-			output.data[i+0] = (intermediates[i/8] >> 56) & 0xFF;
-			output.data[i+1] = (intermediates[i/8] >> 48) & 0xFF;
-			output.data[i+2] = (intermediates[i/8] >> 40) & 0xFF;
-			output.data[i+3] = (intermediates[i/8] >> 32) & 0xFF;
-			output.data[i+4] = (intermediates[i/8] >> 24) & 0xFF;
-			output.data[i+5] = (intermediates[i/8] >> 16) & 0xFF;
-			output.data[i+6] = (intermediates[i/8] >>  8) & 0xFF;
-			output.data[i+7] = (intermediates[i/8] >>  0) & 0xFF;
+			for (int i = 0; i < hashlength; i += 8)
+			{
+				output.data[i+0] = (intermediates[i/8] >> 56) & 0xFF;
+				output.data[i+1] = (intermediates[i/8] >> 48) & 0xFF;
+				output.data[i+2] = (intermediates[i/8] >> 40) & 0xFF;
+				output.data[i+3] = (intermediates[i/8] >> 32) & 0xFF;
+				output.data[i+4] = (intermediates[i/8] >> 24) & 0xFF;
+				output.data[i+5] = (intermediates[i/8] >> 16) & 0xFF;
+				output.data[i+6] = (intermediates[i/8] >>  8) & 0xFF;
+				output.data[i+7] = (intermediates[i/8] >>  0) & 0xFF;
+			}
+
+			output.size = hashlength;
 		}
 
-		output.size = hashlength;
+	private:
+
+		uint64 intermediates[8];
+		int hashlength;
+
+	}; // Context
+
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
+	}
+
+	HashFunction::State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
+
+		return new Context(function);
 	}
 } sha512;
 
@@ -585,9 +668,136 @@ const uint64 SHA512::constants[80] = {
 	0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
 };
 
+/**
+ * Non-cryptographic hashes from the vendored xxHash library. Digests are in
+ * xxHash's canonical (big endian) byte order.
+ **/
+class XXHash : public HashFunction
+{
+private:
+
+	class Context32 : public HashFunction::State
+	{
+	public:
+
+		Context32()
+			: state(XXH32_createState())
+		{
+			if (state == nullptr)
+				throw love::Exception("Out of memory.");
+
+			XXH32_reset(state, 0);
+		}
+
+		virtual ~Context32()
+		{
+			XXH32_freeState(state);
+		}
+
+		void update(const char *input, uint64 length) override
+		{
+			XXH32_update(state, input, (size_t) length);
+		}
+
+		void finish(Value &output) override
+		{
+			getDigest(XXH32_digest(state), output);
+		}
+
+		static void getDigest(XXH32_hash_t hash, Value &output)
+		{
+			XXH32_canonical_t canonical;
+			XXH32_canonicalFromHash(&canonical, hash);
+			memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+			output.size = sizeof(canonical.digest);
+		}
+
+	private:
+
+		XXH32_state_t *state;
+
+	}; // Context32
+
+	class Context64 : public HashFunction::State
+	{
+	public:
+
+		Context64()
+			: state(XXH64_createState())
+		{
+			if (state == nullptr)
+				throw love::Exception("Out of memory.");
+
+			XXH64_reset(state, 0);
+		}
+
+		virtual ~Context64()
+		{
+			XXH64_freeState(state);
+		}
+
+		void update(const char *input, uint64 length) override
+		{
+			XXH64_update(state, input, (size_t) length);
+		}
+
+		void finish(Value &output) override
+		{
+			getDigest(XXH64_digest(state), output);
+		}
+
+		static void getDigest(XXH64_hash_t hash, Value &output)
+		{
+			XXH64_canonical_t canonical;
+			XXH64_canonicalFromHash(&canonical, hash);
+			memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+			output.size = sizeof(canonical.digest);
+		}
+
+	private:
+
+		XXH64_state_t *state;
+
+	}; // Context64
+
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_XXH32 || function == FUNCTION_XXH64;
+	}
+
+	// One-shot hashing doesn't need a heap-allocated state.
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function == FUNCTION_XXH32)
+			Context32::getDigest(XXH32(input, (size_t) length, 0), output);
+		else if (function == FUNCTION_XXH64)
+			Context64::getDigest(XXH64(input, (size_t) length, 0), output);
+		else
+			throw love::Exception("Hash function not supported by xxHash implementation");
+	}
+
+	HashFunction::State *newState(Function function) const override
+	{
+		if (function == FUNCTION_XXH32)
+			return new Context32();
+		else if (function == FUNCTION_XXH64)
+			return new Context64();
+		else
+			throw love::Exception("Hash function not supported by xxHash implementation");
+	}
+} xxhash;
+
 } // impl
 }
 
+void HashFunction::hash(Function function, const char *input, uint64 length, Value &output) const
+{
+	std::unique_ptr<State> state(newState(function));
+	state->update(input, length);
+	state->finish(output);
+}
+
 HashFunction *HashFunction::getHashFunction(Function function)
 {
 	switch(function)
@@ -602,6 +812,9 @@ HashFunction *HashFunction::getHashFunction(Function function)
 	case FUNCTION_SHA384:
 	case FUNCTION_SHA512:
 		return &impl::sha512;
+	case FUNCTION_XXH32:
+	case FUNCTION_XXH64:
+		return &impl::xxhash;
 	case FUNCTION_MAX_ENUM:
 		return nullptr;
 	// No default for compiler warnings
@@ -631,6 +844,8 @@ StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM>::Entry HashFu
 	{"sha256", FUNCTION_SHA256},
 	{"sha384", FUNCTION_SHA384},
 	{"sha512", FUNCTION_SHA512},
+	{"xxh32", FUNCTION_XXH32},
+	{"xxh64", FUNCTION_XXH64},
 };
 
 StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM> HashFunction::functionNames(HashFunction::functionEntries, sizeof(HashFunction::functionEntries));
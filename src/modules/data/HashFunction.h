@@ -42,6 +42,8 @@ class HashFunction
 		FUNCTION_SHA256,
 		FUNCTION_SHA384,
 		FUNCTION_SHA512,
+		FUNCTION_XXH32,
+		FUNCTION_XXH64,
 		FUNCTION_MAX_ENUM
 	};
 
@@ -51,6 +53,28 @@ class HashFunction
 		size_t size;
 	};
 
+	/**
+	 * Running state for hashing input which arrives in multiple pieces.
+	 **/
+	class State
+	{
+	public:
+
+		virtual ~State() {}
+
+		/**
+		 * Feed more input into the hash.
+		 **/
+		virtual void update(const char *input, uint64 length) = 0;
+
+		/**
+		 * Produce the hash of all input given so far. The state must not be
+		 * used again afterwards.
+		 **/
+		virtual void finish(Value &output) = 0;
+
+	}; // State
+
 	/**
 	 * Get a HashFunction instance for the given function.
 	 *
@@ -70,7 +94,15 @@ class HashFunction
 	 * @param[in] length The length of the input data.
 	 * @param[out] output The result of the hash function.
 	 **/
-	virtual void hash(Function function, const char *input, uint64 length, Value &output) const = 0;
+	virtual void hash(Function function, const char *input, uint64 length, Value &output) const;
+
+	/**
+	 * Create a new State for hashing input incrementally.
+	 *
+	 * @param[in] function The selected hash function.
+	 * @return A new State, owned by the caller.
+	 **/
+	virtual State *newState(Function function) const = 0;
 
 	/**
 	 * @param[in] function The requested hash function.
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "HashFunction.h"
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Computes a hash of input which arrives in multiple pieces, without needing
+ * the whole input in memory at once.
+ **/
+class Hasher : public Object
+{
+public:
+
+	static love::Type type;
+
+	Hasher(HashFunction::Function function);
+	virtual ~Hasher();
+
+	HashFunction::Function getFunction() const { return function; }
+
+	void update(const char *input, uint64 length);
+
+	/**
+	 * Produces the hash of all input given so far. No more input can be
+	 * given afterwards.
+	 **/
+	void finish(HashFunction::Value &output);
+
+	bool isFinished() const { return state == nullptr; }
+
+private:
+
+	HashFunction::Function function;
+	HashFunction::State *state;
+
+}; // Hasher
+
+} // data
+} // love
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_BlockCompressedData.h"
+#include "wrap_Data.h"
+#include "wrap_DataModule.h"
+#include "DataModule.h"
+
+namespace love
+{
+namespace data
+{
+
+#define instance() (Module::getInstance<DataModule>(Module::M_DATA))
+
+BlockCompressedData *luax_checkblockcompresseddata(lua_State *L, int idx)
+{
+	return luax_checktype<BlockCompressedData>(L, idx);
+}
+
+int w_BlockCompressedData_clone(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1), *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->clone(); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_BlockCompressedData_getFormat(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1);
+
+	const char *fname = nullptr;
+	if (!Compressor::getConstant(t->getFormat(), fname))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(Compressor::FORMAT_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+int w_BlockCompressedData_getBlockCount(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1);
+	lua_pushinteger(L, (lua_Integer) t->getBlockCount());
+	return 1;
+}
+
+int w_BlockCompressedData_getBlockSize(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1);
+	lua_pushinteger(L, (lua_Integer) t->getBlockSize());
+	return 1;
+}
+
+int w_BlockCompressedData_getDecompressedSize(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1);
+	lua_pushnumber(L, (lua_Number) t->getDecompressedSize());
+	return 1;
+}
+
+static int pushDecompressed(lua_State *L, ContainerType ctype, char *rawbytes, size_t rawsize)
+{
+	if (ctype == CONTAINER_DATA)
+	{
+		ByteData *data = nullptr;
+		luax_catchexcept(L,
+			[&]() { data = instance()->newByteData(rawbytes, rawsize, true); },
+			[&](bool failed) { if (failed) delete[] rawbytes; }
+		);
+		luax_pushtype(L, Data::type, data);
+		data->release();
+	}
+	else
+	{
+		lua_pushlstring(L, rawbytes, rawsize);
+		delete[] rawbytes;
+	}
+
+	return 1;
+}
+
+int w_BlockCompressedData_decompressBlock(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1);
+
+	ContainerType ctype = CONTAINER_STRING;
+
+	int startidx = 2;
+	if (lua_type(L, 2) == LUA_TSTRING)
+	{
+		ctype = luax_checkcontainertype(L, 2);
+		startidx = 3;
+	}
+
+	lua_Integer index = luaL_checkinteger(L, startidx) - 1;
+	if (index < 0 || (size_t) index >= t->getBlockCount())
+		return luaL_error(L, "Invalid block index: %d", (int) index + 1);
+
+	char *rawbytes = nullptr;
+	size_t rawsize = 0;
+	luax_catchexcept(L, [&](){ rawbytes = t->decompressBlock((size_t) index, rawsize); });
+
+	return pushDecompressed(L, ctype, rawbytes, rawsize);
+}
+
+int w_BlockCompressedData_decompress(lua_State *L)
+{
+	BlockCompressedData *t = luax_checkblockcompresseddata(L, 1);
+
+	ContainerType ctype = CONTAINER_STRING;
+	if (!lua_isnoneornil(L, 2))
+		ctype = luax_checkcontainertype(L, 2);
+
+	char *rawbytes = nullptr;
+	size_t rawsize = 0;
+	luax_catchexcept(L, [&](){ rawbytes = t->decompress(rawsize); });
+
+	return pushDecompressed(L, ctype, rawbytes, rawsize);
+}
+
+static const luaL_Reg w_BlockCompressedData_functions[] =
+{
+	{ "clone", w_BlockCompressedData_clone },
+	{ "getFormat", w_BlockCompressedData_getFormat },
+	{ "getBlockCount", w_BlockCompressedData_getBlockCount },
+	{ "getBlockSize", w_BlockCompressedData_getBlockSize },
+	{ "getDecompressedSize", w_BlockCompressedData_getDecompressedSize },
+	{ "decompressBlock", w_BlockCompressedData_decompressBlock },
+	{ "decompress", w_BlockCompressedData_decompress },
+	{ 0, 0 }
+};
+
+int luaopen_blockcompresseddata(lua_State *L)
+{
+	int ret = luax_register_type(L, &BlockCompressedData::type, w_Data_functions, w_BlockCompressedData_functions, nullptr);
+	love::data::luax_rundatawrapper(L, BlockCompressedData::type);
+	return ret;
+}
+
+} // data
+} // love
@@ -24,6 +24,9 @@
 #include "wrap_ByteData.h"
 #include "wrap_DataView.h"
 #include "wrap_CompressedData.h"
+#include "wrap_Hasher.h"
+#include "wrap_CompressionStream.h"
+#include "wrap_BlockCompressedData.h"
 #include "DataModule.h"
 #include "common/b64.h"
 
@@ -200,6 +203,90 @@ int w_decompress(lua_State *L)
 	return 1;
 }
 
+static Compressor::Format checkCompressorFormat(lua_State *L, int idx)
+{
+	const char *fstr = luaL_checkstring(L, idx);
+	Compressor::Format format = Compressor::FORMAT_LZ4;
+
+	if (!Compressor::getConstant(fstr, format))
+		luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+	return format;
+}
+
+int w_newCompressor(lua_State *L)
+{
+	Compressor::Format format = checkCompressorFormat(L, 1);
+	int level = (int) luaL_optinteger(L, 2, -1);
+
+	CompressionStream *s = nullptr;
+	luax_catchexcept(L, [&](){ s = instance()->newCompressionStream(CompressionStream::MODE_COMPRESS, format, level); });
+	luax_pushtype(L, s);
+	s->release();
+	return 1;
+}
+
+int w_newDecompressor(lua_State *L)
+{
+	Compressor::Format format = checkCompressorFormat(L, 1);
+
+	CompressionStream *s = nullptr;
+	luax_catchexcept(L, [&](){ s = instance()->newCompressionStream(CompressionStream::MODE_DECOMPRESS, format); });
+	luax_pushtype(L, s);
+	s->release();
+	return 1;
+}
+
+int w_compressBlocks(lua_State *L)
+{
+	Compressor::Format format = checkCompressorFormat(L, 1);
+
+	size_t rawsize = 0;
+	const char *rawbytes = nullptr;
+
+	if (lua_isstring(L, 2))
+		rawbytes = luaL_checklstring(L, 2, &rawsize);
+	else
+	{
+		Data *rawdata = luax_checktype<Data>(L, 2);
+		rawsize = rawdata->getSize();
+		rawbytes = (const char *) rawdata->getData();
+	}
+
+	int level = (int) luaL_optinteger(L, 3, -1);
+	lua_Integer blocksize = luaL_optinteger(L, 4, (lua_Integer) BlockCompressedData::DEFAULT_BLOCK_SIZE);
+
+	if (blocksize <= 0)
+		return luaL_error(L, "Block size must be greater than zero.");
+
+	BlockCompressedData *d = nullptr;
+	luax_catchexcept(L, [&](){ d = instance()->newBlockCompressedData(format, rawbytes, rawsize, level, (size_t) blocksize); });
+	luax_pushtype(L, d);
+	d->release();
+	return 1;
+}
+
+int w_newBlockCompressedData(lua_State *L)
+{
+	size_t size = 0;
+	const char *bytes = nullptr;
+
+	if (luax_istype(L, 1, Data::type))
+	{
+		Data *data = luax_checkdata(L, 1);
+		bytes = (const char *) data->getData();
+		size = data->getSize();
+	}
+	else
+		bytes = luaL_checklstring(L, 1, &size);
+
+	BlockCompressedData *d = nullptr;
+	luax_catchexcept(L, [&](){ d = instance()->newBlockCompressedData(bytes, size); });
+	luax_pushtype(L, d);
+	d->release();
+	return 1;
+}
+
 int w_encode(lua_State *L)
 {
 	ContainerType ctype = luax_checkcontainertype(L, 1);
@@ -324,6 +411,20 @@ int w_hash(lua_State *L)
 	return 1;
 }
 
+int w_newHasher(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	HashFunction::Function function;
+	if (!HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(function), fstr);
+
+	Hasher *h = nullptr;
+	luax_catchexcept(L, [&](){ h = instance()->newHasher(function); });
+	luax_pushtype(L, h);
+	h->release();
+	return 1;
+}
+
 int w_pack(lua_State *L)
 {
 	ContainerType ctype = luax_checkcontainertype(L, 1);
@@ -373,9 +474,14 @@ static const luaL_Reg functions[] =
 	{ "newByteData", w_newByteData },
 	{ "compress", w_compress },
 	{ "decompress", w_decompress },
+	{ "newCompressor", w_newCompressor },
+	{ "newDecompressor", w_newDecompressor },
+	{ "compressBlocks", w_compressBlocks },
+	{ "newBlockCompressedData", w_newBlockCompressedData },
 	{ "encode", w_encode },
 	{ "decode", w_decode },
 	{ "hash", w_hash },
+	{ "newHasher", w_newHasher },
 
 	{ "pack", w_pack },
 	{ "unpack", w_unpack },
@@ -390,6 +496,9 @@ static const lua_CFunction types[] =
 	luaopen_bytedata,
 	luaopen_dataview,
 	luaopen_compresseddata,
+	luaopen_hasher,
+	luaopen_compressionstream,
+	luaopen_blockcompresseddata,
 	nullptr
 };
 
@@ -19,10 +19,21 @@
  **/
 
 #include "FileData.h"
+#include "common/utf8.h"
 
 // C++
 #include <iostream>
 #include <limits>
+#include <cstring>
+
+#ifdef LOVE_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace love
 {
@@ -33,8 +44,9 @@ love::Type FileData::type("FileData", &Data::type);
 
 FileData::FileData(uint64 size, const std::string &filename)
 	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
 	, size((size_t) size)
-	, filename(filename)
 {
 	try
 	{
@@ -45,19 +57,22 @@ FileData::FileData(uint64 size, const std::string &filename)
 		throw love::Exception("Out of memory.");
 	}
 
-	size_t dotpos = filename.rfind('.');
+	setFilename(filename);
+}
 
-	if (dotpos != std::string::npos)
-	{
-		extension = filename.substr(dotpos + 1);
-		name = filename.substr(0, dotpos);
-	}
-	else
-		name = filename;
+FileData::FileData(const std::string &filename)
+	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
+	, size(0)
+{
+	setFilename(filename);
 }
 
 FileData::FileData(const FileData &c)
 	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
 	, size(c.size)
 	, filename(c.filename)
 	, extension(c.extension)
@@ -76,7 +91,112 @@ FileData::FileData(const FileData &c)
 
 FileData::~FileData()
 {
-	delete [] data;
+	if (mapping != nullptr)
+	{
+#ifdef LOVE_WINDOWS
+		UnmapViewOfFile(mapping);
+#else
+		munmap(mapping, mappingSize);
+#endif
+	}
+	else
+		delete [] data;
+}
+
+FileData *FileData::createMapped(const std::string &path, uint64 offset, uint64 size, const std::string &filename)
+{
+	// Empty mappings aren't allowed, and the region must be addressable.
+	if (size == 0 || size > (uint64) std::numeric_limits<size_t>::max())
+		return nullptr;
+
+	void *mapping = nullptr;
+	size_t mappingsize = 0;
+	uint64 mapoffset = 0;
+
+#ifdef LOVE_WINDOWS
+	// The offset of a view must be a multiple of the allocation granularity.
+	SYSTEM_INFO sysinfo = {};
+	GetSystemInfo(&sysinfo);
+	mapoffset = offset - (offset % (uint64) sysinfo.dwAllocationGranularity);
+
+	if (size + (offset - mapoffset) > (uint64) std::numeric_limits<size_t>::max())
+		return nullptr;
+
+	mappingsize = (size_t) (size + (offset - mapoffset));
+
+	std::wstring wpath = to_widestr(path);
+	HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	// The caller's idea of the file's size might be out of date.
+	LARGE_INTEGER filesize = {};
+	if (!GetFileSizeEx(file, &filesize) || offset + size > (uint64) filesize.QuadPart)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// PAGE_WRITECOPY lets code which writes to the Data modify its own
+	// private copy of the affected pages without touching the file.
+	HANDLE filemapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+
+	if (filemapping == nullptr)
+		return nullptr;
+
+	mapping = MapViewOfFile(filemapping, FILE_MAP_COPY, (DWORD) (mapoffset >> 32), (DWORD) (mapoffset & 0xFFFFFFFF), mappingsize);
+
+	// The view keeps its own reference to the mapping object.
+	CloseHandle(filemapping);
+
+	if (mapping == nullptr)
+		return nullptr;
+#else
+	// The offset of a mapping must be a multiple of the page size.
+	long pagesize = sysconf(_SC_PAGESIZE);
+	if (pagesize <= 0)
+		return nullptr;
+
+	mapoffset = offset - (offset % (uint64) pagesize);
+
+	if (size + (offset - mapoffset) > (uint64) std::numeric_limits<size_t>::max())
+		return nullptr;
+
+	mappingsize = (size_t) (size + (offset - mapoffset));
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	// Touching pages past the end of the file raises SIGBUS, and the caller's
+	// idea of the file's size might be out of date.
+	struct stat buf;
+	if (fstat(fd, &buf) != 0 || offset + size > (uint64) buf.st_size)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	// A private writable mapping lets code which writes to the Data modify
+	// its own copy of the affected pages without touching the file.
+	mapping = mmap(nullptr, mappingsize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t) mapoffset);
+
+	// The mapping keeps its own reference to the file.
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+#endif
+
+	FileData *filedata = new FileData(filename);
+
+	filedata->mapping = mapping;
+	filedata->mappingSize = mappingsize;
+	filedata->data = (char *) mapping + (size_t) (offset - mapoffset);
+	filedata->size = size;
+
+	return filedata;
 }
 
 FileData *FileData::clone() const
@@ -95,6 +215,26 @@ size_t FileData::getSize() const
 	return size > sizemax ? sizemax : (size_t) size;
 }
 
+bool FileData::isMapped() const
+{
+	return mapping != nullptr;
+}
+
+void FileData::setFilename(const std::string &filename)
+{
+	this->filename = filename;
+
+	size_t dotpos = filename.rfind('.');
+
+	if (dotpos != std::string::npos)
+	{
+		extension = filename.substr(dotpos + 1);
+		name = filename.substr(0, dotpos);
+	}
+	else
+		name = filename;
+}
+
 const std::string &FileData::getFilename() const
 {
 	return filename;
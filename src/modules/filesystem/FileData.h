@@ -42,6 +42,18 @@ class FileData : public Data
 	FileData(uint64 size, const std::string &filename);
 	FileData(const FileData &c);
 
+	/**
+	 * Creates a FileData whose contents are a copy-on-write memory mapping of
+	 * a region of a file on disk, rather than a heap copy. The mapping is
+	 * released when the FileData is destroyed. Returns null if the region
+	 * could not be mapped or extends past the end of the file.
+	 * @param path The (UTF-8) path of the file in the native filesystem.
+	 * @param offset The byte offset of the region within the file.
+	 * @param size The size of the region in bytes.
+	 * @param filename The filename reported by getFilename.
+	 **/
+	static FileData *createMapped(const std::string &path, uint64 offset, uint64 size, const std::string &filename);
+
 	virtual ~FileData();
 
 	// Implements Data.
@@ -53,11 +65,23 @@ class FileData : public Data
 	const std::string &getExtension() const;
 	const std::string &getName() const;
 
+	bool isMapped() const;
+
 private:
 
+	FileData(const std::string &filename);
+
+	void setFilename(const std::string &filename);
+
 	// The actual data.
 	char *data;
 
+	// The start of the memory mapping which contains the data, if any.
+	void *mapping;
+
+	// Size of the memory mapping.
+	size_t mappingSize;
+
 	// Size of the data.
 	uint64 size;
 
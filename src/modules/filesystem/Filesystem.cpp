@@ -45,11 +45,13 @@ namespace filesystem
 love::Type Filesystem::type("filesystem", &Module::type);
 
 Filesystem::Filesystem()
+	: ioPool(nullptr)
 {
 }
 
 Filesystem::~Filesystem()
 {
+	stopAsyncIO();
 }
 
 void Filesystem::setAndroidSaveExternal(bool useExternal)
@@ -69,6 +71,37 @@ FileData *Filesystem::newFileData(const void *data, size_t size, const char *fil
 	return fd;
 }
 
+uint64 Filesystem::readAsync(const char *filename, int priority, thread::Channel *channel)
+{
+	return getIOPool()->submit(IOPool::OPERATION_READ, filename, nullptr, priority, channel);
+}
+
+uint64 Filesystem::writeAsync(const char *filename, Data *data, bool append, int priority, thread::Channel *channel)
+{
+	IOPool::Operation operation = append ? IOPool::OPERATION_APPEND : IOPool::OPERATION_WRITE;
+	return getIOPool()->submit(operation, filename, data, priority, channel);
+}
+
+IOPool *Filesystem::getIOPool()
+{
+	thread::Lock lock(ioPoolMutex);
+
+	// File reads are mostly bound by the disk rather than the CPU, so a
+	// couple of threads is enough to keep it busy.
+	if (ioPool == nullptr)
+		ioPool = new IOPool(this, 2);
+
+	return ioPool;
+}
+
+void Filesystem::stopAsyncIO()
+{
+	thread::Lock lock(ioPoolMutex);
+
+	delete ioPool;
+	ioPool = nullptr;
+}
+
 bool Filesystem::isRealDirectory(const std::string &path) const
 {
 #ifdef LOVE_WINDOWS
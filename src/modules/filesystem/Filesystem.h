@@ -28,6 +28,7 @@
 #include "common/StringMap.h"
 #include "FileData.h"
 #include "File.h"
+#include "IOPool.h"
 
 // C++
 #include <string>
@@ -227,6 +228,27 @@ class Filesystem : public Module
 	 **/
 	virtual void append(const char *filename, const void *data, int64 size) const = 0;
 
+	/**
+	 * Queues a read of a whole file on the filesystem's I/O threads, and
+	 * returns the id of the request. The resulting FileData (or error) is
+	 * pushed to the given Channel, or to the event queue if it's null.
+	 * @param filename The name of the file to read from.
+	 * @param priority Requests with a higher priority are processed first.
+	 * @param channel The Channel which receives the result, or null.
+	 **/
+	uint64 readAsync(const char *filename, int priority, thread::Channel *channel);
+
+	/**
+	 * Queues a write or append of data to a file on the filesystem's I/O
+	 * threads, and returns the id of the request.
+	 * @param filename The name of the file to write to.
+	 * @param data The data to write. It's retained until the write is done.
+	 * @param append Whether to append to the file instead of replacing it.
+	 * @param priority Requests with a higher priority are processed first.
+	 * @param channel The Channel which receives the result, or null.
+	 **/
+	uint64 writeAsync(const char *filename, Data *data, bool append, int priority, thread::Channel *channel);
+
 	/**
 	 * This "native" method returns a table of all
 	 * files in a given directory.
@@ -267,11 +289,25 @@ class Filesystem : public Module
 	static bool getConstant(FileType in, const char *&out);
 	static std::vector<std::string> getConstants(FileType);
 
+protected:
+
+	/**
+	 * Waits for in-progress asynchronous requests and stops the I/O threads.
+	 * Implementations must call this before the filesystem becomes unusable.
+	 **/
+	void stopAsyncIO();
+
 private:
 
+	IOPool *getIOPool();
+
 	// Should we save external or internal for Android
 	bool useExternal;
 
+	// Created on the first asynchronous request.
+	IOPool *ioPool;
+	thread::MutexRef ioPoolMutex;
+
 	static StringMap<FileType, FILETYPE_MAX_ENUM>::Entry fileTypeEntries[];
 	static StringMap<FileType, FILETYPE_MAX_ENUM> fileTypes;
 
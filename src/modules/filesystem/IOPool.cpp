@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "IOPool.h"
+#include "Filesystem.h"
+#include "event/Event.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+IOPool::IOPool(Filesystem *filesystem, int threadcount)
+	: filesystem(filesystem)
+	, nextID(1)
+	, nextSequence(0)
+	, stopping(false)
+{
+	for (int i = 0; i < threadcount; i++)
+	{
+		Worker *worker = new Worker(this);
+		workers.push_back(worker);
+		worker->start();
+	}
+}
+
+IOPool::~IOPool()
+{
+	{
+		thread::Lock lock(mutex);
+		stopping = true;
+		cond->broadcast();
+	}
+
+	// Requests which haven't started yet are dropped.
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+uint64 IOPool::submit(Operation operation, const std::string &filename, Data *data, int priority, thread::Channel *channel)
+{
+	thread::Lock lock(mutex);
+
+	Request request;
+	request.id = nextID++;
+	request.operation = operation;
+	request.filename = filename;
+	request.data.set(data);
+	request.priority = priority;
+	request.channel.set(channel);
+	request.sequence = nextSequence++;
+
+	requests.push(request);
+	cond->signal();
+
+	return request.id;
+}
+
+bool IOPool::nextRequest(Request &request)
+{
+	thread::Lock lock(mutex);
+
+	while (!stopping && requests.empty())
+		cond->wait(mutex);
+
+	if (stopping)
+		return false;
+
+	request = requests.top();
+	requests.pop();
+
+	return true;
+}
+
+void IOPool::process(const Request &request)
+{
+	StrongRef<FileData> filedata;
+	std::string error;
+
+	try
+	{
+		switch (request.operation)
+		{
+		case OPERATION_READ:
+			filedata.set(filesystem->read(request.filename.c_str()), Acquire::NORETAIN);
+			break;
+		case OPERATION_WRITE:
+			filesystem->write(request.filename.c_str(), request.data->getData(), request.data->getSize());
+			break;
+		case OPERATION_APPEND:
+			filesystem->append(request.filename.c_str(), request.data->getData(), request.data->getSize());
+			break;
+		}
+	}
+	catch (std::exception &e)
+	{
+		// Anything else escaping would terminate the program, since this runs
+		// on an I/O thread (e.g. std::bad_alloc when reading a huge file.)
+		error = e.what();
+		if (error.empty())
+			error = "Unknown error.";
+		filedata.set(nullptr);
+	}
+
+	Variant result;
+	if (!error.empty())
+		result = Variant(false);
+	else if (request.operation == OPERATION_READ)
+		result = Variant(&FileData::type, filedata.get());
+	else
+		result = Variant(true);
+
+	Variant errorvar;
+	if (!error.empty())
+		errorvar = Variant(error);
+
+	if (request.channel.get() != nullptr)
+	{
+		auto table = new std::vector<std::pair<Variant, Variant>>();
+
+		table->emplace_back(Variant(std::string("id")), Variant((double) request.id));
+		table->emplace_back(Variant(std::string("filename")), Variant(request.filename));
+		table->emplace_back(Variant(std::string("result")), result);
+
+		if (!error.empty())
+			table->emplace_back(Variant(std::string("error")), errorvar);
+
+		request.channel->push(Variant(table));
+	}
+	else
+	{
+		auto eventmodule = Module::getInstance<event::Event>(Module::M_EVENT);
+		if (!eventmodule)
+			return;
+
+		std::vector<Variant> vargs = {
+			Variant((double) request.id),
+			Variant(request.filename),
+			result,
+			errorvar,
+		};
+
+		StrongRef<event::Message> msg(new event::Message("filesystemio", vargs), Acquire::NORETAIN);
+		eventmodule->push(msg);
+	}
+}
+
+IOPool::Worker::Worker(IOPool *pool)
+	: pool(pool)
+{
+	threadName = "IOWorker";
+}
+
+void IOPool::Worker::threadFunction()
+{
+	Request request;
+
+	while (pool->nextRequest(request))
+	{
+		pool->process(request);
+
+		// Don't keep the last request's references alive while waiting.
+		request.data.set(nullptr);
+		request.channel.set(nullptr);
+	}
+}
+
+} // filesystem
+} // love
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_IO_POOL_H
+#define LOVE_FILESYSTEM_IO_POOL_H
+
+// LOVE
+#include "common/Data.h"
+#include "common/int.h"
+#include "thread/threads.h"
+#include "thread/Channel.h"
+
+// C++
+#include <string>
+#include <vector>
+#include <queue>
+
+namespace love
+{
+namespace filesystem
+{
+
+class Filesystem;
+
+/**
+ * A small pool of threads which perform file reads and writes on behalf of
+ * love.filesystem's asynchronous functions. Each result is either pushed to a
+ * Channel, or to the event queue as a "filesystemio" event when no Channel is
+ * given.
+ **/
+class IOPool
+{
+public:
+
+	enum Operation
+	{
+		OPERATION_READ,
+		OPERATION_WRITE,
+		OPERATION_APPEND,
+	};
+
+	struct Request
+	{
+		uint64 id;
+		Operation operation;
+		std::string filename;
+		StrongRef<Data> data;
+		int priority;
+		StrongRef<thread::Channel> channel;
+
+		// Requests with the same priority complete in submission order.
+		uint64 sequence;
+	};
+
+	IOPool(Filesystem *filesystem, int threadcount);
+	~IOPool();
+
+	/**
+	 * Queues a request and returns its id. Requests with a higher priority are
+	 * processed first.
+	 **/
+	uint64 submit(Operation operation, const std::string &filename, Data *data, int priority, thread::Channel *channel);
+
+private:
+
+	class Worker : public thread::Threadable
+	{
+	public:
+
+		Worker(IOPool *pool);
+		virtual ~Worker() {}
+
+		// Implements Threadable.
+		void threadFunction() override;
+
+	private:
+
+		IOPool *pool;
+
+	}; // Worker
+
+	struct RequestCompare
+	{
+		bool operator () (const Request &a, const Request &b) const
+		{
+			if (a.priority != b.priority)
+				return a.priority < b.priority;
+			return a.sequence > b.sequence;
+		}
+	};
+
+	bool nextRequest(Request &request);
+	void process(const Request &request);
+
+	Filesystem *filesystem;
+
+	std::vector<Worker *> workers;
+
+	std::priority_queue<Request, std::vector<Request>, RequestCompare> requests;
+
+	thread::MutexRef mutex;
+	thread::ConditionalRef cond;
+
+	uint64 nextID;
+	uint64 nextSequence;
+
+	bool stopping;
+
+}; // IOPool
+
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_IO_POOL_H
@@ -22,10 +22,274 @@
 
 // STD
 #include <cstring>
+#include <cstdio>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
 
 // LOVE
 #include "Filesystem.h"
 #include "filesystem/FileData.h"
+#include "common/utf8.h"
+#include "thread/threads.h"
+
+// Assume POSIX or Visual Studio.
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace
+{
+
+bool isAbsolutePath(const std::string &path)
+{
+#ifdef LOVE_WINDOWS
+	if (path.length() >= 3 && path[1] == ':' && (path[2] == '/' || path[2] == '\\'))
+		return true;
+	return path.length() >= 2 && (path[0] == '/' || path[0] == '\\') && (path[1] == '/' || path[1] == '\\');
+#else
+	return !path.empty() && path[0] == '/';
+#endif
+}
+
+bool getNativeInfo(const std::string &path, bool &isdir, love::uint64 &size, love::int64 &modtime)
+{
+#ifdef LOVE_WINDOWS
+	std::wstring wpath = love::to_widestr(path);
+
+	struct _stat64 buf;
+	if (_wstat64(wpath.c_str(), &buf) != 0)
+		return false;
+
+	isdir = (buf.st_mode & _S_IFDIR) == _S_IFDIR;
+	if (!isdir && (buf.st_mode & _S_IFREG) != _S_IFREG)
+		return false;
+#else
+	struct stat buf;
+	if (stat(path.c_str(), &buf) != 0)
+		return false;
+
+	isdir = S_ISDIR(buf.st_mode) != 0;
+	if (!isdir && !S_ISREG(buf.st_mode))
+		return false;
+#endif
+
+	size = (love::uint64) buf.st_size;
+	modtime = (love::int64) buf.st_mtime;
+	return true;
+}
+
+love::uint32 readLE16(const unsigned char *p)
+{
+	return (love::uint32) p[0] | ((love::uint32) p[1] << 8);
+}
+
+love::uint32 readLE32(const unsigned char *p)
+{
+	return readLE16(p) | (readLE16(p + 2) << 16);
+}
+
+class NativeFile
+{
+public:
+
+	NativeFile(const std::string &path)
+	{
+#ifdef LOVE_WINDOWS
+		file = _wfopen(love::to_widestr(path).c_str(), L"rb");
+#else
+		file = fopen(path.c_str(), "rb");
+#endif
+	}
+
+	~NativeFile()
+	{
+		if (file != nullptr)
+			fclose(file);
+	}
+
+	bool read(love::int64 offset, void *dst, size_t size)
+	{
+		if (file == nullptr)
+			return false;
+#ifdef LOVE_WINDOWS
+		if (_fseeki64(file, offset, SEEK_SET) != 0)
+			return false;
+#else
+		if (fseeko(file, (off_t) offset, SEEK_SET) != 0)
+			return false;
+#endif
+		return fread(dst, 1, size, file) == size;
+	}
+
+private:
+
+	FILE *file;
+
+};
+
+const love::int64 ZIP_EOCD_SIZE = 22;
+const love::int64 ZIP_CENTRAL_HEADER_SIZE = 46;
+const love::int64 ZIP_LOCAL_HEADER_SIZE = 30;
+
+struct StoredZipEntry
+{
+	// Absolute offset of the entry's local header in the archive file.
+	love::uint64 headerOffset;
+
+	// Absolute offset of the entry's data, or 0 until the local header has
+	// been read.
+	love::uint64 dataOffset;
+
+	love::uint64 size;
+};
+
+struct ZipDirectory
+{
+	love::uint64 archiveSize;
+	love::int64 archiveModTime;
+
+	// Only unencrypted stored entries, since only those can be used as-is.
+	std::unordered_map<std::string, StoredZipEntry> storedEntries;
+};
+
+// Reads the central directory of a zip archive.
+bool readZipDirectory(NativeFile &file, love::uint64 archivesize, ZipDirectory &directory)
+{
+	if ((love::int64) archivesize < ZIP_EOCD_SIZE)
+		return false;
+
+	// The end of central directory record is followed by a comment of up to
+	// 64k bytes.
+	love::int64 tailsize = std::min((love::int64) archivesize, ZIP_EOCD_SIZE + 0xFFFF);
+	love::int64 tailstart = (love::int64) archivesize - tailsize;
+
+	std::vector<unsigned char> tail((size_t) tailsize);
+	if (!file.read(tailstart, tail.data(), tail.size()))
+		return false;
+
+	love::int64 eocdpos = -1;
+	for (love::int64 i = tailsize - ZIP_EOCD_SIZE; i >= 0; i--)
+	{
+		if (readLE32(&tail[(size_t) i]) == 0x06054b50)
+		{
+			eocdpos = i;
+			break;
+		}
+	}
+
+	if (eocdpos < 0)
+		return false;
+
+	const unsigned char *eocd = &tail[(size_t) eocdpos];
+	love::uint32 entrycount = readLE16(eocd + 10);
+	love::uint32 dirsize = readLE32(eocd + 12);
+	love::uint32 diroffset = readLE32(eocd + 16);
+
+	// Zip64 and multi-disk archives are left to PhysFS.
+	if (readLE16(eocd + 4) != 0 || entrycount == 0xFFFF || dirsize == 0xFFFFFFFF || diroffset == 0xFFFFFFFF)
+		return false;
+
+	// Offsets in the archive are relative to the start of the zip data, which
+	// might not be the start of the file (e.g. in fused executables.)
+	love::int64 datastart = tailstart + eocdpos - (love::int64) dirsize - (love::int64) diroffset;
+	if (datastart < 0)
+		return false;
+
+	std::vector<unsigned char> dir(dirsize);
+	if (!file.read(datastart + diroffset, dir.data(), dir.size()))
+		return false;
+
+	size_t pos = 0;
+	for (love::uint32 i = 0; i < entrycount; i++)
+	{
+		if (pos + ZIP_CENTRAL_HEADER_SIZE > dir.size() || readLE32(&dir[pos]) != 0x02014b50)
+			return false;
+
+		const unsigned char *header = &dir[pos];
+		love::uint32 namelen = readLE16(header + 28);
+		love::uint32 entrysize = ZIP_CENTRAL_HEADER_SIZE + namelen + readLE16(header + 30) + readLE16(header + 32);
+
+		if (pos + entrysize > dir.size())
+			return false;
+
+		love::uint32 flags = readLE16(header + 8);
+		love::uint32 method = readLE16(header + 10);
+		love::uint32 compressedsize = readLE32(header + 20);
+		love::uint32 uncompressedsize = readLE32(header + 24);
+		love::uint32 localoffset = readLE32(header + 42);
+
+		bool stored = (flags & 1) == 0 && method == 0 && compressedsize == uncompressedsize;
+
+		if (stored && uncompressedsize != 0xFFFFFFFF && localoffset != 0xFFFFFFFF)
+		{
+			std::string name((const char *) header + ZIP_CENTRAL_HEADER_SIZE, namelen);
+			StoredZipEntry entry = {(love::uint64) (datastart + localoffset), 0, uncompressedsize};
+			directory.storedEntries.emplace(name, entry);
+		}
+
+		pos += entrysize;
+	}
+
+	return true;
+}
+
+// Finds the data of an uncompressed (stored) entry in a zip archive. The
+// central directory of each archive is only parsed again if its size or
+// modification time changes.
+bool findStoredZipEntry(const std::string &archivepath, love::uint64 archivesize, love::int64 archivemodtime, const std::string &entryname, love::uint64 &offset, love::uint64 &size)
+{
+	static love::thread::MutexRef mutex;
+	static std::unordered_map<std::string, ZipDirectory> directories;
+
+	love::thread::Lock lock(mutex);
+
+	auto dirit = directories.find(archivepath);
+
+	if (dirit == directories.end() || dirit->second.archiveSize != archivesize || dirit->second.archiveModTime != archivemodtime)
+	{
+		ZipDirectory newdirectory;
+		newdirectory.archiveSize = archivesize;
+		newdirectory.archiveModTime = archivemodtime;
+
+		// Archives which can't be used are remembered as having no entries,
+		// so they aren't parsed on every open either.
+		NativeFile file(archivepath);
+		if (!readZipDirectory(file, archivesize, newdirectory))
+			newdirectory.storedEntries.clear();
+
+		directories[archivepath] = std::move(newdirectory);
+		dirit = directories.find(archivepath);
+	}
+
+	ZipDirectory &directory = dirit->second;
+
+	auto it = directory.storedEntries.find(entryname);
+	if (it == directory.storedEntries.end())
+		return false;
+
+	StoredZipEntry &entry = it->second;
+
+	if (entry.dataOffset == 0)
+	{
+		NativeFile file(archivepath);
+
+		unsigned char local[ZIP_LOCAL_HEADER_SIZE];
+		if (!file.read(entry.headerOffset, local, sizeof(local)) || readLE32(local) != 0x04034b50)
+			return false;
+
+		entry.dataOffset = entry.headerOffset + ZIP_LOCAL_HEADER_SIZE + readLE16(local + 26) + readLE16(local + 28);
+	}
+
+	// Never hand out a region past the end of the archive.
+	if (entry.dataOffset + entry.size > archivesize)
+		return false;
+
+	offset = entry.dataOffset;
+	size = entry.size;
+	return true;
+}
+
+} // anonymous namespace
 
 namespace love
 {
@@ -102,6 +366,9 @@ bool File::open(Mode mode)
 
 	this->mode = mode;
 
+	if (mode == MODE_APPEND || mode == MODE_WRITE)
+		invalidatePathIndex();
+
 	if (file != nullptr && !setBuffer(bufferMode, bufferSize))
 	{
 		// Revert to buffer defaults if we don't successfully set the buffer.
@@ -117,6 +384,9 @@ bool File::close()
 	if (file == nullptr || !PHYSFS_close(file))
 		return false;
 
+	if (mode == MODE_APPEND || mode == MODE_WRITE)
+		invalidatePathIndex();
+
 	mode = MODE_CLOSED;
 	file = nullptr;
 
@@ -158,6 +428,97 @@ int64 File::read(void *dst, int64 size)
 	return PHYSFS_readBytes(file, dst, (PHYSFS_uint64) size);
 }
 
+FileData *File::read(int64 size)
+{
+	bool isopen = isOpen();
+
+	// Only whole reads from the start of the file can be mapped.
+	if (!isopen || (mode == MODE_READ && tell() == 0))
+	{
+		FileData *data = readMapped(size);
+		if (data != nullptr)
+		{
+			if (isopen)
+				seek(data->getSize());
+			return data;
+		}
+	}
+
+	return love::filesystem::File::read(size);
+}
+
+FileData *File::readMapped(int64 size) const
+{
+#ifdef LOVE_ANDROID
+	// Game files are generally inside the apk, which we can't map.
+	LOVE_UNUSED(size);
+	return nullptr;
+#else
+	if (!PHYSFS_isInit() || (size < 0 && size != ALL))
+		return nullptr;
+
+	PHYSFS_Stat stat = {};
+	if (!PHYSFS_stat(filename.c_str(), &stat) || stat.filetype != PHYSFS_FILETYPE_REGULAR || stat.filesize < 0)
+		return nullptr;
+
+	uint64 mapsize = (size == ALL || size > stat.filesize) ? stat.filesize : size;
+	if ((int64) mapsize < MAPPED_READ_MIN_SIZE)
+		return nullptr;
+
+	const char *realdir = PHYSFS_getRealDir(filename.c_str());
+	if (realdir == nullptr || !isAbsolutePath(realdir))
+		return nullptr;
+
+	// Files in the save directory can be truncated while a mapping of them
+	// is still alive, so they're always copied.
+	auto fs = Module::getInstance<love::filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs != nullptr && strcmp(fs->getSaveDirectory(), realdir) == 0)
+		return nullptr;
+
+	const char *mountpoint = PHYSFS_getMountPoint(realdir);
+
+	std::string path;
+	std::string mountpath;
+	if (mountpoint == nullptr || !Filesystem::sanitizePath(filename, path) || !Filesystem::sanitizePath(mountpoint, mountpath))
+		return nullptr;
+
+	// Get the path relative to the root of the mounted directory or archive.
+	if (!mountpath.empty())
+	{
+		if (path.compare(0, mountpath.length(), mountpath) != 0 || path.length() <= mountpath.length() || path[mountpath.length()] != '/')
+			return nullptr;
+
+		path = path.substr(mountpath.length() + 1);
+	}
+
+	bool isdir = false;
+	uint64 nativesize = 0;
+	int64 modtime = 0;
+	if (!getNativeInfo(realdir, isdir, nativesize, modtime))
+		return nullptr;
+
+	if (isdir)
+	{
+		std::string nativepath = std::string(realdir) + "/" + path;
+
+		if (!getNativeInfo(nativepath, isdir, nativesize, modtime) || isdir || nativesize != (uint64) stat.filesize)
+			return nullptr;
+
+		return FileData::createMapped(nativepath, 0, mapsize, filename);
+	}
+	else
+	{
+		uint64 offset = 0;
+		uint64 entrysize = 0;
+
+		if (!findStoredZipEntry(realdir, nativesize, modtime, path, offset, entrysize) || entrysize != (uint64) stat.filesize)
+			return nullptr;
+
+		return FileData::createMapped(realdir, offset, mapsize, filename);
+	}
+#endif
+}
+
 bool File::write(const void *data, int64 size)
 {
 	if (!file || (mode != MODE_WRITE && mode != MODE_APPEND))
@@ -169,6 +530,8 @@ bool File::write(const void *data, int64 size)
 	// Try to write.
 	int64 written = PHYSFS_writeBytes(file, data, (PHYSFS_uint64) size);
 
+	invalidatePathIndex();
+
 	// Check that correct amount of data was written.
 	if (written != size)
 		return false;
@@ -188,7 +551,11 @@ bool File::flush()
 	if (!file || (mode != MODE_WRITE && mode != MODE_APPEND))
 		throw love::Exception("File is not opened for writing.");
 
-	return PHYSFS_flush(file) != 0;
+	bool success = PHYSFS_flush(file) != 0;
+
+	invalidatePathIndex();
+
+	return success;
 }
 
 #ifdef LOVE_WINDOWS
@@ -270,6 +637,14 @@ File::BufferMode File::getBuffer(int64 &size) const
 	return bufferMode;
 }
 
+void File::invalidatePathIndex() const
+{
+	// Cached file sizes and modification times are stale after a write.
+	auto fs = Module::getInstance<Filesystem>(Module::M_FILESYSTEM);
+	if (fs != nullptr)
+		fs->invalidatePathIndex(filename);
+}
+
 const std::string &File::getFilename() const
 {
 	return filename;
@@ -68,8 +68,23 @@ class File : public love::filesystem::File
 	Mode getMode() const override;
 	const std::string &getFilename() const override;
 
+	/**
+	 * Reads data from the file into a new FileData. When the file is stored
+	 * uncompressed in a real directory or zip archive, the FileData maps the
+	 * file's contents directly instead of copying them.
+	 **/
+	FileData *read(int64 size = ALL) override;
+
 private:
 
+	// Files smaller than this are always copied, since mapping them costs
+	// more than reading them.
+	static const int64 MAPPED_READ_MIN_SIZE = 128 * 1024;
+
+	FileData *readMapped(int64 size) const;
+
+	void invalidatePathIndex() const;
+
 	// filename
 	std::string filename;
 
@@ -102,6 +102,8 @@ namespace physfs
 Filesystem::Filesystem()
 	: fused(false)
 	, fusedSet(false)
+	, pathIndexEnabled(false)
+	, pathIndexGeneration(0)
 {
 	requirePath = {"?.lua", "?/init.lua"};
 	cRequirePath = {"??"};
@@ -109,6 +111,9 @@ Filesystem::Filesystem()
 
 Filesystem::~Filesystem()
 {
+	// The I/O threads use PhysFS.
+	stopAsyncIO();
+
 #ifdef LOVE_ANDROID
 	love::android::deinitializeVirtualArchive();
 #endif
@@ -133,6 +138,8 @@ void Filesystem::init(const char *arg0)
 
 	// Enable symlinks by default.
 	setSymlinksEnabled(true);
+
+	updatePathIndex();
 }
 
 void Filesystem::setFused(bool fused)
@@ -210,6 +217,8 @@ bool Filesystem::setIdentity(const char *ident, bool appendToPath)
 	// already called at least once before.
 	PHYSFS_setWriteDir(nullptr);
 
+	updatePathIndex();
+
 	return true;
 }
 
@@ -309,6 +318,7 @@ bool Filesystem::setSource(const char *source)
 			delete io;
 			return false;
 		}
+		updatePathIndex();
 		return true;
 	}
 #endif
@@ -316,6 +326,8 @@ bool Filesystem::setSource(const char *source)
 	// Save the game source.
 	game_source = new_search_path;
 
+	updatePathIndex();
+
 	return true;
 }
 
@@ -377,6 +389,8 @@ bool Filesystem::setupWriteDirectory()
 		return false;
 	}
 
+	updatePathIndex();
+
 	return true;
 }
 
@@ -423,7 +437,11 @@ bool Filesystem::mount(const char *archive, const char *mountpoint, bool appendT
 	if (realPath.length() == 0)
 		return false;
 
-	return PHYSFS_mount(realPath.c_str(), mountpoint, appendToPath) != 0;
+	if (PHYSFS_mount(realPath.c_str(), mountpoint, appendToPath) == 0)
+		return false;
+
+	updatePathIndex();
+	return true;
 }
 
 bool Filesystem::mount(Data *data, const char *archivename, const char *mountpoint, bool appendToPath)
@@ -434,6 +452,7 @@ bool Filesystem::mount(Data *data, const char *archivename, const char *mountpoi
 	if (PHYSFS_mountMemory(data->getData(), data->getSize(), nullptr, archivename, mountpoint, appendToPath) != 0)
 	{
 		mountedData[archivename] = data;
+		updatePathIndex();
 		return true;
 	}
 
@@ -450,6 +469,7 @@ bool Filesystem::unmount(const char *archive)
 	if (datait != mountedData.end() && PHYSFS_unmount(archive) != 0)
 	{
 		mountedData.erase(datait);
+		updatePathIndex();
 		return true;
 	}
 
@@ -486,7 +506,11 @@ bool Filesystem::unmount(const char *archive)
 	if (!mountPoint)
 		return false;
 
-	return PHYSFS_unmount(realPath.c_str()) != 0;
+	if (PHYSFS_unmount(realPath.c_str()) == 0)
+		return false;
+
+	updatePathIndex();
+	return true;
 }
 
 bool Filesystem::unmount(Data *data)
@@ -609,8 +633,35 @@ std::string Filesystem::getRealDirectory(const char *filename) const
 	if (!PHYSFS_isInit())
 		throw love::Exception("PhysFS is not initialized.");
 
+	std::string key;
+	bool indexed = sanitizePath(filename, key);
+	uint64 generation = 0;
+
+	if (indexed)
+	{
+		thread::Lock lock(pathIndexMutex);
+
+		indexed = pathIndexEnabled;
+		generation = pathIndexGeneration;
+		auto it = indexed ? realDirectoryIndex.find(key) : realDirectoryIndex.end();
+
+		if (it != realDirectoryIndex.end())
+		{
+			if (it->second.empty())
+				throw love::Exception("File does not exist on disk.");
+			return it->second;
+		}
+	}
+
 	const char *dir = PHYSFS_getRealDir(filename);
 
+	if (indexed)
+	{
+		thread::Lock lock(pathIndexMutex);
+		if (pathIndexEnabled && pathIndexGeneration == generation)
+			realDirectoryIndex[key] = dir != nullptr ? dir : "";
+	}
+
 	if (dir == nullptr)
 		throw love::Exception("File does not exist on disk.");
 
@@ -622,23 +673,56 @@ bool Filesystem::getInfo(const char *filepath, Info &info) const
 	if (!PHYSFS_isInit())
 		return false;
 
+	std::string key;
+	bool indexed = sanitizePath(filepath, key);
+	uint64 generation = 0;
+
+	if (indexed)
+	{
+		thread::Lock lock(pathIndexMutex);
+
+		indexed = pathIndexEnabled;
+		generation = pathIndexGeneration;
+		auto it = indexed ? infoIndex.find(key) : infoIndex.end();
+
+		if (it != infoIndex.end())
+		{
+			if (it->second.exists)
+				info = it->second.info;
+			return it->second.exists;
+		}
+	}
+
+	PathIndexEntry entry = {};
+
 	PHYSFS_Stat stat = {};
-	if (!PHYSFS_stat(filepath, &stat))
-		return false;
+	entry.exists = PHYSFS_stat(filepath, &stat) != 0;
 
-	info.size = (int64) stat.filesize;
-	info.modtime = (int64) stat.modtime;
+	if (entry.exists)
+	{
+		entry.info.size = (int64) stat.filesize;
+		entry.info.modtime = (int64) stat.modtime;
+
+		if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
+			entry.info.type = FILETYPE_FILE;
+		else if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
+			entry.info.type = FILETYPE_DIRECTORY;
+		else if (stat.filetype == PHYSFS_FILETYPE_SYMLINK)
+			entry.info.type = FILETYPE_SYMLINK;
+		else
+			entry.info.type = FILETYPE_OTHER;
 
-	if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
-		info.type = FILETYPE_FILE;
-	else if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
-		info.type = FILETYPE_DIRECTORY;
-	else if (stat.filetype == PHYSFS_FILETYPE_SYMLINK)
-		info.type = FILETYPE_SYMLINK;
-	else
-		info.type = FILETYPE_OTHER;
+		info = entry.info;
+	}
 
-	return true;
+	if (indexed)
+	{
+		thread::Lock lock(pathIndexMutex);
+		if (pathIndexEnabled && pathIndexGeneration == generation)
+			infoIndex[key] = entry;
+	}
+
+	return entry.exists;
 }
 
 bool Filesystem::createDirectory(const char *dir)
@@ -649,10 +733,12 @@ bool Filesystem::createDirectory(const char *dir)
 	if (PHYSFS_getWriteDir() == 0 && !setupWriteDirectory())
 		return false;
 
-	if (!PHYSFS_mkdir(dir))
-		return false;
+	bool success = PHYSFS_mkdir(dir) != 0;
 
-	return true;
+	// Parent directories may have been created even if this failed.
+	invalidatePathIndex();
+
+	return success;
 }
 
 bool Filesystem::remove(const char *file)
@@ -666,6 +752,8 @@ bool Filesystem::remove(const char *file)
 	if (!PHYSFS_delete(file))
 		return false;
 
+	invalidatePathIndex();
+
 	return true;
 }
 
@@ -706,15 +794,45 @@ void Filesystem::getDirectoryItems(const char *dir, std::vector<std::string> &it
 	if (!PHYSFS_isInit())
 		return;
 
+	std::string key;
+	bool indexed = sanitizePath(dir, key);
+	uint64 generation = 0;
+
+	if (indexed)
+	{
+		thread::Lock lock(pathIndexMutex);
+
+		indexed = pathIndexEnabled;
+		generation = pathIndexGeneration;
+		auto it = indexed ? directoryIndex.find(key) : directoryIndex.end();
+
+		if (it != directoryIndex.end())
+		{
+			items.insert(items.end(), it->second.begin(), it->second.end());
+			return;
+		}
+	}
+
 	char **rc = PHYSFS_enumerateFiles(dir);
 
 	if (rc == nullptr)
 		return;
 
+	std::vector<std::string> diritems;
+
 	for (char **i = rc; *i != 0; i++)
-		items.push_back(*i);
+		diritems.push_back(*i);
 
 	PHYSFS_freeList(rc);
+
+	items.insert(items.end(), diritems.begin(), diritems.end());
+
+	if (indexed)
+	{
+		thread::Lock lock(pathIndexMutex);
+		if (pathIndexEnabled && pathIndexGeneration == generation)
+			directoryIndex[key] = std::move(diritems);
+	}
 }
 
 void Filesystem::setSymlinksEnabled(bool enable)
@@ -723,6 +841,8 @@ void Filesystem::setSymlinksEnabled(bool enable)
 		return;
 
 	PHYSFS_permitSymbolicLinks(enable ? 1 : 0);
+
+	invalidatePathIndex();
 }
 
 bool Filesystem::areSymlinksEnabled() const
@@ -749,6 +869,108 @@ void Filesystem::allowMountingForPath(const std::string &path)
 		allowedMountPaths.push_back(path);
 }
 
+void Filesystem::invalidatePathIndex()
+{
+	thread::Lock lock(pathIndexMutex);
+
+	pathIndexGeneration++;
+
+	if (!infoIndex.empty())
+		infoIndex.clear();
+	if (!realDirectoryIndex.empty())
+		realDirectoryIndex.clear();
+	if (!directoryIndex.empty())
+		directoryIndex.clear();
+}
+
+void Filesystem::invalidatePathIndex(const std::string &path)
+{
+	std::string key;
+	if (!sanitizePath(path, key))
+	{
+		invalidatePathIndex();
+		return;
+	}
+
+	// Writing a file changes its own info and where it's found, and the
+	// listing and modification time of the directory it's in.
+	size_t slash = key.rfind('/');
+	std::string parent = slash != std::string::npos ? key.substr(0, slash) : std::string();
+
+	thread::Lock lock(pathIndexMutex);
+
+	pathIndexGeneration++;
+
+	infoIndex.erase(key);
+	realDirectoryIndex.erase(key);
+	directoryIndex.erase(key);
+
+	infoIndex.erase(parent);
+	realDirectoryIndex.erase(parent);
+	directoryIndex.erase(parent);
+}
+
+void Filesystem::updatePathIndex()
+{
+	bool enable = true;
+
+	char **searchpath = PHYSFS_getSearchPath();
+
+	if (searchpath != nullptr)
+	{
+		for (char **i = searchpath; *i != nullptr; i++)
+		{
+			// Archives can't change while they're mounted, and the contents of
+			// the save directory only change through love.filesystem.
+			if (save_path_full == *i || mountedData.count(*i) != 0)
+				continue;
+
+			if (isRealDirectory(*i))
+			{
+				enable = false;
+				break;
+			}
+		}
+
+		PHYSFS_freeList(searchpath);
+	}
+	else
+		enable = false;
+
+	invalidatePathIndex();
+
+	thread::Lock lock(pathIndexMutex);
+	pathIndexEnabled = enable;
+}
+
+bool Filesystem::sanitizePath(const std::string &path, std::string &out)
+{
+	out.clear();
+
+	size_t start = 0;
+	while (start <= path.length())
+	{
+		size_t end = path.find('/', start);
+		if (end == std::string::npos)
+			end = path.length();
+
+		std::string component = path.substr(start, end - start);
+		start = end + 1;
+
+		if (component.empty())
+			continue;
+
+		if (component == "." || component == ".." || component.find_first_of(":\\") != std::string::npos)
+			return false;
+
+		if (!out.empty())
+			out += '/';
+		out += component;
+	}
+
+	return true;
+}
+
 } // physfs
 } // filesystem
 } // love
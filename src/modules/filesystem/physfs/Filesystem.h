@@ -25,9 +25,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <unordered_map>
 
 // LOVE
 #include "filesystem/Filesystem.h"
+#include "thread/threads.h"
 
 namespace love
 {
@@ -96,8 +98,34 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	void allowMountingForPath(const std::string &path) override;
 
+	/**
+	 * Discards cached path lookups. Must be called when files are written,
+	 * since the save directory is part of the search path.
+	 **/
+	void invalidatePathIndex();
+
+	/**
+	 * Discards cached lookups of a single file which was written, and of its
+	 * parent directory.
+	 **/
+	void invalidatePathIndex(const std::string &path);
+
+	/**
+	 * Converts a path into the "a/b/c" form PhysFS uses internally. Returns
+	 * false if PhysFS would reject the path.
+	 **/
+	static bool sanitizePath(const std::string &path, std::string &out);
+
 private:
 
+	struct PathIndexEntry
+	{
+		bool exists;
+		Info info;
+	};
+
+	void updatePathIndex();
+
 	// Contains the current working directory (UTF8).
 	std::string cwd;
 
@@ -129,6 +157,21 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	std::map<std::string, StrongRef<Data>> mountedData;
 
+	// Cached results of getInfo, getRealDirectory and getDirectoryItems.
+	// They're only used while every entry in the search path is an archive
+	// or the save directory, since other real directories can change without
+	// going through love.filesystem.
+	bool pathIndexEnabled;
+	mutable std::unordered_map<std::string, PathIndexEntry> infoIndex;
+	mutable std::unordered_map<std::string, std::string> realDirectoryIndex;
+	std::unordered_map<std::string, std::vector<std::string>> directoryIndex;
+	thread::MutexRef pathIndexMutex;
+
+	// Incremented whenever cached lookups are discarded. Lookups are done
+	// without holding the lock, so their results are only stored if this
+	// hasn't changed in the meantime (e.g. an async write finished.)
+	uint64 pathIndexGeneration;
+
 }; // Filesystem
 
 } // physfs
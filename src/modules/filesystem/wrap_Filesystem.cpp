@@ -26,6 +26,7 @@
 #include "wrap_FileData.h"
 #include "data/wrap_Data.h"
 #include "data/wrap_DataModule.h"
+#include "thread/wrap_Channel.h"
 
 #include "physfs/Filesystem.h"
 
@@ -565,6 +566,146 @@ int w_append(lua_State *L)
 	return w_write_or_append(L, File::MODE_APPEND);
 }
 
+static const char *ASYNC_CALLBACKS_KEY = "_love_filesystem_asynccallbacks";
+
+// Stores the function or Channel at the given index as the destination of an
+// asynchronous request's result, and returns the Channel to pass along.
+static love::thread::Channel *luax_getasyncchannel(lua_State *L, int idx)
+{
+	if (lua_isfunction(L, idx))
+		return nullptr;
+	return love::thread::luax_checkchannel(L, idx);
+}
+
+static void luax_storeasynccallback(lua_State *L, int idx, uint64 id)
+{
+	if (!lua_isfunction(L, idx))
+		return;
+
+	lua_getfield(L, LUA_REGISTRYINDEX, ASYNC_CALLBACKS_KEY);
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, ASYNC_CALLBACKS_KEY);
+	}
+
+	lua_pushnumber(L, (lua_Number) id);
+	lua_pushvalue(L, idx);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
+}
+
+int w_readAsync(lua_State *L)
+{
+	bool istable = lua_istable(L, 1);
+	if (!istable)
+		luaL_checkstring(L, 1);
+
+	love::thread::Channel *channel = luax_getasyncchannel(L, 2);
+	int priority = (int) luaL_optinteger(L, 3, 0);
+
+	if (!istable)
+	{
+		uint64 id = instance()->readAsync(lua_tostring(L, 1), priority, channel);
+		luax_storeasynccallback(L, 2, id);
+		lua_pushnumber(L, (lua_Number) id);
+		return 1;
+	}
+
+	int count = (int) luax_objlen(L, 1);
+	std::vector<std::string> filenames;
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 1, i);
+		filenames.push_back(luaL_checkstring(L, -1));
+		lua_pop(L, 1);
+	}
+
+	lua_createtable(L, count, 0);
+
+	for (int i = 0; i < count; i++)
+	{
+		uint64 id = instance()->readAsync(filenames[i].c_str(), priority, channel);
+		luax_storeasynccallback(L, 2, id);
+		lua_pushnumber(L, (lua_Number) id);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+static int w_writeAsync_or_appendAsync(lua_State *L, bool append)
+{
+	const char *filename = luaL_checkstring(L, 1);
+
+	StrongRef<love::Data> data;
+
+	if (luax_istype(L, 2, love::Data::type))
+		data.set(luax_totype<love::Data>(L, 2));
+	else if (lua_isstring(L, 2))
+	{
+		size_t len = 0;
+		const char *str = lua_tolstring(L, 2, &len);
+		luax_catchexcept(L, [&]() { data.set(instance()->newFileData(str, len, filename), Acquire::NORETAIN); });
+	}
+	else
+		return luaL_argerror(L, 2, "string or Data expected");
+
+	love::thread::Channel *channel = luax_getasyncchannel(L, 3);
+	int priority = (int) luaL_optinteger(L, 4, 0);
+
+	uint64 id = instance()->writeAsync(filename, data, append, priority, channel);
+	luax_storeasynccallback(L, 3, id);
+
+	lua_pushnumber(L, (lua_Number) id);
+	return 1;
+}
+
+int w_writeAsync(lua_State *L)
+{
+	return w_writeAsync_or_appendAsync(L, false);
+}
+
+int w_appendAsync(lua_State *L)
+{
+	return w_writeAsync_or_appendAsync(L, true);
+}
+
+// Called by love.handlers.filesystemio to run the callback of a completed
+// asynchronous request.
+int w__dispatchAsync(lua_State *L)
+{
+	luaL_checknumber(L, 1);
+
+	lua_getfield(L, LUA_REGISTRYINDEX, ASYNC_CALLBACKS_KEY);
+	if (!lua_istable(L, -1))
+		return 0;
+
+	int callbacks = lua_gettop(L);
+
+	lua_pushvalue(L, 1);
+	lua_rawget(L, callbacks);
+
+	// The request may have been made from a different Lua state.
+	if (!lua_isfunction(L, -1))
+		return 0;
+
+	lua_pushvalue(L, 1);
+	lua_pushnil(L);
+	lua_rawset(L, callbacks);
+
+	// callback(filename, result, err)
+	lua_pushvalue(L, 2);
+	lua_pushvalue(L, 3);
+	lua_pushvalue(L, 4);
+	lua_call(L, 3, 0);
+
+	return 0;
+}
+
 int w_getDirectoryItems(lua_State *L)
 {
 	const char *dir = luaL_checkstring(L, 1);
@@ -975,6 +1116,10 @@ static const luaL_Reg functions[] =
 	{ "read", w_read },
 	{ "write", w_write },
 	{ "append", w_append },
+	{ "readAsync", w_readAsync },
+	{ "writeAsync", w_writeAsync },
+	{ "appendAsync", w_appendAsync },
+	{ "_dispatchAsync", w__dispatchAsync },
 	{ "getDirectoryItems", w_getDirectoryItems },
 	{ "lines", w_lines },
 	{ "load", w_load },
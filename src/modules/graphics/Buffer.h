@@ -45,6 +45,7 @@ class Buffer : public Resource
 	{
 		MAP_EXPLICIT_RANGE_MODIFY = (1 << 0), // see setMappedRangeModified.
 		MAP_READ = (1 << 1),
+		MAP_DISCARD_UNMODIFIED = (1 << 2), // data outside the modified ranges may be lost by unmap().
 	};
 
 	Buffer(size_t size, BufferType type, vertex::Usage usage, uint32 mapflags);
@@ -421,7 +421,7 @@ float Font::getHeight() const
 	return (float) floorf(height / dpiScale + 0.5f);
 }
 
-std::vector<Font::DrawCommand> Font::generateVertices(const ColoredCodepoints &codepoints, const Colorf &constantcolor, std::vector<GlyphVertex> &vertices, float extra_spacing, Vector2 offset, TextInfo *info)
+Font::DrawCommands Font::generateVertices(const ColoredCodepoints &codepoints, const Colorf &constantcolor, GlyphVertices &vertices, float extra_spacing, Vector2 offset, TextInfo *info)
 {
 	// Spacing counter and newline handling.
 	float dx = offset.x;
@@ -435,7 +435,7 @@ std::vector<Font::DrawCommand> Font::generateVertices(const ColoredCodepoints &c
 	int maxwidth = 0;
 
 	// Keeps track of when we need to switch textures in our vertex array.
-	std::vector<DrawCommand> commands;
+	DrawCommands commands(vertices.get_allocator());
 
 	// Pre-allocate space for the maximum possible number of vertices.
 	size_t vertstartsize = vertices.size();
@@ -565,13 +565,13 @@ std::vector<Font::DrawCommand> Font::generateVertices(const ColoredCodepoints &c
 	return commands;
 }
 
-std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const ColoredCodepoints &text, const Colorf &constantcolor, float wrap, AlignMode align, std::vector<GlyphVertex> &vertices, TextInfo *info)
+Font::DrawCommands Font::generateVerticesFormatted(const ColoredCodepoints &text, const Colorf &constantcolor, float wrap, AlignMode align, GlyphVertices &vertices, TextInfo *info)
 {
 	wrap = std::max(wrap, 0.0f);
 
 	uint32 cacheid = textureCacheID;
 
-	std::vector<DrawCommand> drawcommands;
+	DrawCommands drawcommands(vertices.get_allocator());
 	vertices.reserve(text.cps.size() * 4);
 
 	std::vector<int> widths;
@@ -614,7 +614,7 @@ std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const ColoredCode
 				break;
 		}
 
-		std::vector<DrawCommand> newcommands = generateVertices(line, constantcolor, vertices, extraspacing, offset);
+		DrawCommands newcommands = generateVertices(line, constantcolor, vertices, extraspacing, offset);
 
 		if (!newcommands.empty())
 		{
@@ -655,7 +655,7 @@ std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const ColoredCode
 	return drawcommands;
 }
 
-void Font::printv(graphics::Graphics *gfx, const Matrix4 &t, const std::vector<DrawCommand> &drawcommands, const std::vector<GlyphVertex> &vertices)
+void Font::printv(graphics::Graphics *gfx, const Matrix4 &t, const DrawCommands &drawcommands, const GlyphVertices &vertices)
 {
 	if (vertices.empty() || drawcommands.empty())
 		return;
@@ -683,8 +683,8 @@ void Font::print(graphics::Graphics *gfx, const std::vector<ColoredString> &text
 	ColoredCodepoints codepoints;
 	getCodepointsFromString(text, codepoints);
 
-	std::vector<GlyphVertex> vertices;
-	std::vector<DrawCommand> drawcommands = generateVertices(codepoints, constantcolor, vertices);
+	GlyphVertices vertices(FrameAllocator<GlyphVertex>(&gfx->getFrameArena()));
+	DrawCommands drawcommands = generateVertices(codepoints, constantcolor, vertices);
 
 	printv(gfx, m, drawcommands, vertices);
 }
@@ -694,52 +694,17 @@ void Font::printf(graphics::Graphics *gfx, const std::vector<ColoredString> &tex
 	ColoredCodepoints codepoints;
 	getCodepointsFromString(text, codepoints);
 
-	std::vector<GlyphVertex> vertices;
-	std::vector<DrawCommand> drawcommands = generateVerticesFormatted(codepoints, constantcolor, wrap, align, vertices);
+	GlyphVertices vertices(FrameAllocator<GlyphVertex>(&gfx->getFrameArena()));
+	DrawCommands drawcommands = generateVerticesFormatted(codepoints, constantcolor, wrap, align, vertices);
 
 	printv(gfx, m, drawcommands, vertices);
 }
 
 int Font::getWidth(const std::string &str)
 {
-	if (str.size() == 0) return 0;
-
-	std::istringstream iss(str);
-	std::string line;
-	int max_width = 0;
-
-	while (getline(iss, line, '\n'))
-	{
-		int width = 0;
-		uint32 prevglyph = 0;
-		try
-		{
-			utf8::iterator<std::string::const_iterator> i(line.begin(), line.begin(), line.end());
-			utf8::iterator<std::string::const_iterator> end(line.end(), line.begin(), line.end());
-
-			while (i != end)
-			{
-				uint32 c = *i++;
-
-				// Ignore carriage returns
-				if (c == '\r')
-					continue;
-
-				const Glyph &g = findGlyph(c);
-				width += g.spacing + getKerning(prevglyph, c);
-
-				prevglyph = c;
-			}
-		}
-		catch (utf8::exception &e)
-		{
-			throw love::Exception("UTF-8 decoding error: %s", e.what());
-		}
-
-		max_width = std::max(max_width, width);
-	}
-
-	return max_width;
+	return getWidth(str,
+		[this](uint32 glyph) { return findGlyph(glyph).spacing; },
+		[this](uint32 left, uint32 right) { return getKerning(left, right); });
 }
 
 int Font::getWidth(uint32 glyph)
@@ -24,6 +24,8 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <sstream>
+#include <algorithm>
 #include <stddef.h>
 
 // LOVE
@@ -31,6 +33,9 @@
 #include "common/Object.h"
 #include "common/Matrix.h"
 #include "common/Vector.h"
+#include "common/FrameArena.h"
+#include "common/Exception.h"
+#include "libraries/utf8/utf8.h"
 
 #include "font/Rasterizer.h"
 #include "Image.h"
@@ -96,15 +101,21 @@ class Font : public Object, public Volatile
 		int vertexcount;
 	};
 
+	// Temporary vertex arrays for text drawn immediately come from the
+	// graphics module's frame arena. The draw commands use the same allocator
+	// as the vertices they were generated for.
+	typedef std::vector<GlyphVertex, FrameAllocator<GlyphVertex>> GlyphVertices;
+	typedef std::vector<DrawCommand, FrameAllocator<DrawCommand>> DrawCommands;
+
 	Font(love::font::Rasterizer *r, const Texture::Filter &filter);
 
 	virtual ~Font();
 
-	std::vector<DrawCommand> generateVertices(const ColoredCodepoints &codepoints, const Colorf &constantColor, std::vector<GlyphVertex> &vertices,
-	                                          float extra_spacing = 0.0f, Vector2 offset = {}, TextInfo *info = nullptr);
+	DrawCommands generateVertices(const ColoredCodepoints &codepoints, const Colorf &constantColor, GlyphVertices &vertices,
+	                              float extra_spacing = 0.0f, Vector2 offset = {}, TextInfo *info = nullptr);
 
-	std::vector<DrawCommand> generateVerticesFormatted(const ColoredCodepoints &text, const Colorf &constantColor, float wrap, AlignMode align,
-	                                                   std::vector<GlyphVertex> &vertices, TextInfo *info = nullptr);
+	DrawCommands generateVerticesFormatted(const ColoredCodepoints &text, const Colorf &constantColor, float wrap, AlignMode align,
+	                                       GlyphVertices &vertices, TextInfo *info = nullptr);
 
 	static void getCodepointsFromString(const std::string &str, Codepoints &codepoints);
 	static void getCodepointsFromString(const std::vector<ColoredString> &strs, ColoredCodepoints &codepoints);
@@ -132,6 +143,14 @@ class Font : public Object, public Volatile
 	 **/
 	int getWidth(uint32 glyph);
 
+	/**
+	 * The layout done by getWidth, with the glyph spacing and kerning lookups
+	 * provided by the caller, so it can also be measured without a graphics
+	 * context.
+	 **/
+	template <typename SpacingFunc, typename KerningFunc>
+	static int getWidth(const std::string &str, SpacingFunc getspacing, KerningFunc getkerning);
+
 	/**
 	 * Returns the maximal width of a wrapped string
 	 * and optionally the number of lines
@@ -207,7 +226,7 @@ class Font : public Object, public Volatile
 	love::font::GlyphData *getRasterizerGlyphData(uint32 glyph, float &dpiscale);
 	const Glyph &addGlyph(uint32 glyph);
 	const Glyph &findGlyph(uint32 glyph);
-	void printv(Graphics *gfx, const Matrix4 &t, const std::vector<DrawCommand> &drawcommands, const std::vector<GlyphVertex> &vertices);
+	void printv(Graphics *gfx, const Matrix4 &t, const DrawCommands &drawcommands, const GlyphVertices &vertices);
 
 	std::vector<StrongRef<love::font::Rasterizer>> rasterizers;
 
@@ -252,5 +271,47 @@ class Font : public Object, public Volatile
 	
 }; // Font
 
+template <typename SpacingFunc, typename KerningFunc>
+int Font::getWidth(const std::string &str, SpacingFunc getspacing, KerningFunc getkerning)
+{
+	if (str.size() == 0) return 0;
+
+	std::istringstream iss(str);
+	std::string line;
+	int max_width = 0;
+
+	while (getline(iss, line, '\n'))
+	{
+		int width = 0;
+		uint32 prevglyph = 0;
+		try
+		{
+			utf8::iterator<std::string::const_iterator> i(line.begin(), line.begin(), line.end());
+			utf8::iterator<std::string::const_iterator> end(line.end(), line.begin(), line.end());
+
+			while (i != end)
+			{
+				uint32 c = *i++;
+
+				// Ignore carriage returns
+				if (c == '\r')
+					continue;
+
+				width += getspacing(c) + getkerning(prevglyph, c);
+
+				prevglyph = c;
+			}
+		}
+		catch (utf8::exception &e)
+		{
+			throw love::Exception("UTF-8 decoding error: %s", e.what());
+		}
+
+		max_width = std::max(max_width, width);
+	}
+
+	return max_width;
+}
+
 } // graphics
 } // love
@@ -31,11 +31,14 @@
 #include "Font.h"
 #include "Video.h"
 #include "Text.h"
+#include "LineMesh.h"
+#include "timer/Timer.h"
 #include "common/deprecation.h"
 
 // C++
 #include <algorithm>
 #include <stdlib.h>
+#include <stdio.h>
 
 namespace love
 {
@@ -43,6 +46,7 @@ namespace graphics
 {
 
 static bool gammaCorrect = false;
+static bool threadedRendering = false;
 static bool debugMode = false;
 static bool debugModeQueried = false;
 
@@ -73,6 +77,16 @@ Colorf gammaCorrectColor(const Colorf &c)
 	return r;
 }
 
+void setThreadedRendering(bool threaded)
+{
+	threadedRendering = threaded;
+}
+
+bool isThreadedRendering()
+{
+	return threadedRendering;
+}
+
 void unGammaCorrectColor(Colorf &c)
 {
 	if (isGammaCorrect())
@@ -120,7 +134,10 @@ Graphics::Graphics()
 	, drawCalls(0)
 	, drawCallsBatched(0)
 	, quadIndexBuffer(nullptr)
+	, quadCornerBuffer(nullptr)
 	, capabilities()
+	, profilingEnabled(false)
+	, canvasPassProfileZone(-1)
 	, cachedShaderStages()
 {
 	transformStack.reserve(16);
@@ -139,6 +156,7 @@ Graphics::Graphics()
 Graphics::~Graphics()
 {
 	delete quadIndexBuffer;
+	delete quadCornerBuffer;
 
 	// Clean up standard shaders before the active shader. If we do it after,
 	// the active shader may try to activate a standard shader when deactivating
@@ -179,6 +197,22 @@ void Graphics::createQuadIndexBuffer()
 	vertex::fillIndices(vertex::TriangleIndexMode::QUADS, 0, LOVE_UINT16_MAX, (uint16 *) map.get());
 }
 
+void Graphics::createQuadCornerBuffer()
+{
+	if (quadCornerBuffer != nullptr)
+		return;
+
+	// Same order as Quad's vertices, so it can be drawn as a triangle strip.
+	const Vector2 corners[] = {
+		Vector2(0.0f, 0.0f),
+		Vector2(0.0f, 1.0f),
+		Vector2(1.0f, 0.0f),
+		Vector2(1.0f, 1.0f),
+	};
+
+	quadCornerBuffer = newBuffer(sizeof(corners), corners, BUFFER_VERTEX, vertex::USAGE_STATIC, 0);
+}
+
 Quad *Graphics::newQuad(Quad::Viewport v, double sw, double sh)
 {
 	return new Quad(v, sw, sh);
@@ -204,9 +238,14 @@ Video *Graphics::newVideo(love::video::VideoStream *stream, float dpiscale)
 	return new Video(this, stream, dpiscale);
 }
 
-love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, vertex::Usage usage)
+StreamBuffer *Graphics::newPixelStreamBuffer(size_t size)
 {
-	return new SpriteBatch(this, texture, size, usage);
+	return newStreamBuffer(BUFFER_PIXEL_UNPACK, size);
+}
+
+love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, vertex::Usage usage, bool instanced)
+{
+	return new SpriteBatch(this, texture, size, usage, instanced);
 }
 
 love::graphics::ParticleSystem *Graphics::newParticleSystem(Texture *texture, int size)
@@ -285,6 +324,11 @@ love::graphics::Text *Graphics::newText(graphics::Font *font, const std::vector<
 	return new Text(font, text);
 }
 
+LineMesh *Graphics::newLineMesh(const std::vector<Vector2> &points)
+{
+	return new LineMesh(points, getLineWidth(), getLineJoin(), getLineStyle());
+}
+
 void Graphics::cleanupCachedShaderStage(ShaderStage::StageType type, const std::string &hashkey)
 {
 	cachedShaderStages[type].erase(hashkey);
@@ -365,6 +409,9 @@ void Graphics::reset()
 	stopDrawToStencilBuffer();
 	restoreState(s);
 	origin();
+
+	// An error may have been thrown between a beginProfileZone and its end.
+	endOpenProfileZones();
 }
 
 /**
@@ -686,6 +733,9 @@ void Graphics::setCanvas(const RenderTargets &rts)
 
 	flushStreamDraws();
 
+	// Code which only draws to Canvases might never present.
+	frameArena.rewind();
+
 	if (rts.depthStencil.canvas == nullptr && rts.temporaryRTFlags != 0)
 	{
 		bool wantsdepth   = (rts.temporaryRTFlags & TEMPORARY_RT_DEPTH) != 0;
@@ -725,6 +775,9 @@ void Graphics::setCanvas(const RenderTargets &rts)
 	std::swap(state.renderTargets, refs);
 
 	canvasSwitchCount++;
+
+	if (profilingEnabled)
+		beginCanvasPassProfileZone(true);
 }
 
 void Graphics::setCanvas()
@@ -735,10 +788,15 @@ void Graphics::setCanvas()
 		return;
 
 	flushStreamDraws();
+	frameArena.rewind();
+
 	setCanvasInternal(RenderTargets(), width, height, pixelWidth, pixelHeight, isGammaCorrect());
 
 	state.renderTargets = RenderTargetsStrongRef();
 	canvasSwitchCount++;
+
+	if (profilingEnabled)
+		beginCanvasPassProfileZone(false);
 }
 
 Graphics::RenderTargets Graphics::getCanvas() const
@@ -1198,6 +1256,58 @@ void Graphics::flushStreamDrawsGlobal()
 		instance->flushStreamDraws();
 }
 
+bool Graphics::canDrawInstancedQuads() const
+{
+	return capabilities.features[FEATURE_INSTANCING]
+		&& quadCornerBuffer != nullptr
+		&& Shader::standardShaders[Shader::STANDARD_INSTANCED_QUADS] != nullptr
+		&& Shader::isDefaultActive();
+}
+
+void Graphics::drawInstancedQuads(int start, int count, Buffer *instances, Texture *texture, bool colors)
+{
+	using namespace vertex;
+
+	Shader::attachDefault(Shader::STANDARD_INSTANCED_QUADS);
+
+	if (texture != nullptr)
+		Shader::current->checkMainTexture(texture);
+
+	Attributes attributes;
+	BufferBindings buffers;
+
+	// Per-vertex: the corners of the unit quad.
+	attributes.set(ATTRIB_POS, DATA_FLOAT, 2, 0, 0);
+	attributes.setBufferLayout(0, (uint16) sizeof(Vector2));
+	buffers.set(0, quadCornerBuffer, 0);
+
+	// Per-instance: everything else.
+	attributes.set(ATTRIB_TEXCOORD, DATA_FLOAT, 4, offsetof(QuadInstance, s0), 1);
+
+	// The color attribute is white when it's disabled.
+	if (colors)
+		attributes.set(ATTRIB_COLOR, DATA_UNORM8, 4, offsetof(QuadInstance, color), 1);
+
+	int index = Shader::current->getVertexAttributeIndex("InstanceTransformX");
+	if (index >= 0)
+		attributes.set(index, DATA_FLOAT, 3, offsetof(QuadInstance, transformX), 1);
+
+	index = Shader::current->getVertexAttributeIndex("InstanceTransformY");
+	if (index >= 0)
+		attributes.set(index, DATA_FLOAT, 3, offsetof(QuadInstance, transformY), 1);
+
+	attributes.setBufferLayout(1, (uint16) sizeof(QuadInstance), STEP_PER_INSTANCE);
+	buffers.set(1, instances, start * sizeof(QuadInstance));
+
+	DrawCommand cmd(&attributes, &buffers);
+	cmd.primitiveType = PRIMITIVE_TRIANGLE_STRIP;
+	cmd.vertexCount = 4;
+	cmd.instanceCount = count;
+	cmd.texture = texture;
+
+	draw(cmd);
+}
+
 /**
  * Drawing
  **/
@@ -1324,19 +1434,19 @@ void Graphics::polyline(const Vector2 *vertices, size_t count)
 
 	if (linejoin == LINE_JOIN_NONE)
 	{
-		NoneJoinPolyline line;
+		NoneJoinPolyline line(&frameArena);
 		line.render(vertices, count, halfwidth, pixelsize, linestyle == LINE_SMOOTH);
 		line.draw(this);
 	}
 	else if (linejoin == LINE_JOIN_BEVEL)
 	{
-		BevelJoinPolyline line;
+		BevelJoinPolyline line(&frameArena);
 		line.render(vertices, count, halfwidth, pixelsize, linestyle == LINE_SMOOTH);
 		line.draw(this);
 	}
 	else if (linejoin == LINE_JOIN_MITER)
 	{
-		MiterJoinPolyline line;
+		MiterJoinPolyline line(&frameArena);
 		line.render(vertices, count, halfwidth, pixelsize, linestyle == LINE_SMOOTH);
 		line.draw(this);
 	}
@@ -1600,10 +1710,202 @@ Graphics::Stats Graphics::getStats() const
 	stats.images = Image::imageCount;
 	stats.fonts = Font::fontCount;
 	stats.textureMemory = Texture::totalGraphicsMemory;
+	stats.transientAllocations = frameArena.getAllocationCount();
+	stats.transientMemory = frameArena.getAllocatedSize();
 	
 	return stats;
 }
 
+void Graphics::setProfilingEnabled(bool enable)
+{
+	if (enable == profilingEnabled)
+		return;
+
+	discardProfileFrames();
+	profilingEnabled = enable;
+
+	if (enable)
+		beginCanvasPassProfileZone(isCanvasActive());
+}
+
+bool Graphics::isProfilingEnabled() const
+{
+	return profilingEnabled;
+}
+
+void Graphics::beginProfileZone(const std::string &name)
+{
+	if (!profilingEnabled)
+		return;
+
+	if (profileZoneStack.size() == MAX_USER_STACK_DEPTH)
+		throw love::Exception("Maximum profile zone depth (%d) reached. (More begins than ends?)", (int) MAX_USER_STACK_DEPTH);
+
+	profileZoneStack.push_back(beginProfileZoneInternal(name, false));
+}
+
+void Graphics::endProfileZone()
+{
+	if (!profilingEnabled)
+		return;
+
+	if (profileZoneStack.empty())
+		throw love::Exception("endProfileZone called without a matching beginProfileZone.");
+
+	endProfileZoneInternal(profileZoneStack.back());
+	profileZoneStack.pop_back();
+}
+
+const std::vector<Graphics::ProfileZone> &Graphics::getProfileZones() const
+{
+	return profileZones;
+}
+
+int Graphics::beginProfileZoneInternal(const std::string &name, bool canvaspass)
+{
+	// Batched draws belong to whichever zone they were made in.
+	flushStreamDraws();
+
+	PendingProfileZone pending;
+	pending.zone.name = name;
+	pending.zone.depth = canvaspass ? 0 : (int) profileZoneStack.size();
+	pending.zone.canvasPass = canvaspass;
+	pending.zone.cpuTime = 0.0;
+	pending.zone.gpuTime = -1.0;
+	pending.cpuStart = timer::Timer::getTime();
+	pending.gpuStart = recordProfileTimestamp();
+	pending.gpuEnd = -1;
+
+	currentProfileFrame.zones.push_back(pending);
+	return (int) currentProfileFrame.zones.size() - 1;
+}
+
+void Graphics::endProfileZoneInternal(int zone)
+{
+	flushStreamDraws();
+
+	PendingProfileZone &pending = currentProfileFrame.zones[zone];
+	pending.zone.cpuTime = timer::Timer::getTime() - pending.cpuStart;
+	pending.gpuEnd = recordProfileTimestamp();
+}
+
+int Graphics::recordProfileTimestamp()
+{
+	if (!isCreated())
+		return -1;
+
+	int id = insertGPUTimestamp();
+	if (id < 0)
+		return -1;
+
+	currentProfileFrame.timestamps.push_back(id);
+	return (int) currentProfileFrame.timestamps.size() - 1;
+}
+
+void Graphics::beginCanvasPassProfileZone(bool canvas)
+{
+	if (canvasPassProfileZone >= 0)
+		endProfileZoneInternal(canvasPassProfileZone);
+
+	canvasPassProfileZone = beginProfileZoneInternal(canvas ? "canvas" : "screen", true);
+}
+
+void Graphics::releaseProfileFrame(ProfileFrame &frame)
+{
+	if (!frame.timestamps.empty())
+		releaseGPUTimestamps(frame.timestamps);
+
+	frame.zones.clear();
+	frame.timestamps.clear();
+}
+
+void Graphics::beginProfileFrame()
+{
+	if (profilingEnabled)
+		beginCanvasPassProfileZone(false);
+}
+
+void Graphics::endProfileFrame()
+{
+	if (!profilingEnabled)
+		return;
+
+	if (!profileZoneStack.empty())
+	{
+		// Throwing here would make every later present fail as well,
+		// including the one in the error handler.
+		::printf("Warning: %d profile zone(s) were not ended before love.graphics.present was called.\n", (int) profileZoneStack.size());
+		endOpenProfileZones();
+	}
+
+	if (canvasPassProfileZone >= 0)
+		endProfileZoneInternal(canvasPassProfileZone);
+
+	canvasPassProfileZone = -1;
+
+	pendingProfileFrames.push_back(std::move(currentProfileFrame));
+	currentProfileFrame = ProfileFrame();
+
+	// Publish the newest frame whose GPU results are ready, without waiting.
+	while (!pendingProfileFrames.empty())
+	{
+		ProfileFrame &frame = pendingProfileFrames.front();
+
+		bool disjoint = false;
+		if (!frame.timestamps.empty() && !getGPUTimestamps(frame.timestamps, profileTimestamps, disjoint))
+			break;
+
+		profileZones.clear();
+
+		for (const PendingProfileZone &pending : frame.zones)
+		{
+			ProfileZone zone = pending.zone;
+
+			if (!disjoint && pending.gpuStart >= 0 && pending.gpuEnd >= 0)
+			{
+				uint64 start = profileTimestamps[pending.gpuStart];
+				uint64 end = profileTimestamps[pending.gpuEnd];
+				if (end >= start)
+					zone.gpuTime = (double) (end - start) / 1000000000.0;
+			}
+
+			profileZones.push_back(zone);
+		}
+
+		releaseProfileFrame(frame);
+		pendingProfileFrames.pop_front();
+	}
+
+	// Drop the oldest frames if the GPU falls too far behind.
+	while (pendingProfileFrames.size() > MAX_PENDING_PROFILE_FRAMES)
+	{
+		releaseProfileFrame(pendingProfileFrames.front());
+		pendingProfileFrames.pop_front();
+	}
+}
+
+void Graphics::endOpenProfileZones()
+{
+	while (!profileZoneStack.empty())
+	{
+		endProfileZoneInternal(profileZoneStack.back());
+		profileZoneStack.pop_back();
+	}
+}
+
+void Graphics::discardProfileFrames()
+{
+	releaseProfileFrame(currentProfileFrame);
+
+	for (ProfileFrame &frame : pendingProfileFrames)
+		releaseProfileFrame(frame);
+
+	pendingProfileFrames.clear();
+	profileZoneStack.clear();
+	canvasPassProfileZone = -1;
+	profileZones.clear();
+}
+
 size_t Graphics::getStackDepth() const
 {
 	return stackTypeStack.size();
@@ -29,6 +29,7 @@
 #include "common/Optional.h"
 #include "common/int.h"
 #include "common/Color.h"
+#include "common/FrameArena.h"
 #include "StreamBuffer.h"
 #include "vertex.h"
 #include "Texture.h"
@@ -50,6 +51,7 @@
 // C++
 #include <string>
 #include <vector>
+#include <deque>
 
 namespace love
 {
@@ -60,6 +62,7 @@ namespace graphics
 class SpriteBatch;
 class ParticleSystem;
 class Text;
+class LineMesh;
 class Video;
 class Buffer;
 
@@ -95,6 +98,18 @@ void unGammaCorrectColor(Colorf &c);
 Colorf gammaCorrectColor(const Colorf &c);
 Colorf unGammaCorrectColor(const Colorf &c);
 
+/**
+ * Globally sets whether the OpenGL driver should record commands on the
+ * calling thread and execute them on a separate thread of its own, where the
+ * driver supports it. This must be set before the window is created.
+ **/
+void setThreadedRendering(bool threaded);
+
+/**
+ * Gets whether threaded rendering was requested.
+ **/
+bool isThreadedRendering();
+
 bool isDebugEnabled();
 
 class Graphics : public Module
@@ -225,6 +240,19 @@ class Graphics : public Module
 		int images;
 		int fonts;
 		int64 textureMemory;
+		int transientAllocations;
+		int64 transientMemory;
+	};
+
+	struct ProfileZone
+	{
+		std::string name;
+		int depth;
+		bool canvasPass;
+
+		// In seconds. gpuTime is negative if it couldn't be measured.
+		double cpuTime;
+		double gpuTime;
 	};
 
 	struct ColorMask
@@ -479,7 +507,13 @@ class Graphics : public Module
 	Font *newDefaultFont(int size, font::TrueTypeRasterizer::Hinting hinting, const Texture::Filter &filter = Texture::defaultFilter);
 	Video *newVideo(love::video::VideoStream *stream, float dpiscale);
 
-	SpriteBatch *newSpriteBatch(Texture *texture, int size, vertex::Usage usage);
+	/**
+	 * Creates a ring buffer for staging Image::replacePixels uploads. Uploads
+	 * sourced from it don't have to wait for the copy to finish.
+	 **/
+	StreamBuffer *newPixelStreamBuffer(size_t size);
+
+	SpriteBatch *newSpriteBatch(Texture *texture, int size, vertex::Usage usage, bool instanced = false);
 	ParticleSystem *newParticleSystem(Texture *texture, int size);
 
 	virtual Canvas *newCanvas(const Canvas::Settings &settings) = 0;
@@ -496,6 +530,11 @@ class Graphics : public Module
 
 	Text *newText(Font *font, const std::vector<Font::ColoredString> &text = {});
 
+	/**
+	 * Creates a LineMesh which uses the current line width, join and style.
+	 **/
+	LineMesh *newLineMesh(const std::vector<Vector2> &points);
+
 	bool validateShader(bool gles, const std::string &vertex, const std::string &pixel, std::string &err);
 
 	/**
@@ -849,6 +888,32 @@ class Graphics : public Module
 	 **/
 	Stats getStats() const;
 
+	/**
+	 * Memory for temporary data which is only needed while drawing, such as
+	 * text and line vertices. Everything allocated from it is freed when the
+	 * frame is presented or the active Canvas changes, so nothing may keep
+	 * it past the end of a draw call. At most FrameArena::MAX_RETAINED_SIZE
+	 * bytes stay allocated in between. Must only be used on the main thread.
+	 **/
+	FrameArena &getFrameArena() { return frameArena; }
+
+	/**
+	 * While profiling is enabled, user zones are recorded along with a zone
+	 * for each Canvas and screen pass.
+	 **/
+	void setProfilingEnabled(bool enable);
+	bool isProfilingEnabled() const;
+
+	void beginProfileZone(const std::string &name);
+	void endProfileZone();
+
+	/**
+	 * Returns the zones of the most recent frame whose GPU timings have been
+	 * read back. GPU results are never waited on, so they lag a few frames
+	 * behind the current one.
+	 **/
+	const std::vector<ProfileZone> &getProfileZones() const;
+
 	size_t getStackDepth() const;
 	void push(StackType type = STACK_TRANSFORM);
 	void pop();
@@ -872,6 +937,19 @@ class Graphics : public Module
 	virtual void draw(const DrawIndexedCommand &cmd) = 0;
 	virtual void drawQuads(int start, int count, const vertex::Attributes &attributes, const vertex::BufferBindings &buffers, Texture *texture) = 0;
 
+	/**
+	 * Whether drawInstancedQuads can currently be used: instancing must be
+	 * supported and the default shader must be active.
+	 **/
+	bool canDrawInstancedQuads() const;
+
+	/**
+	 * Draws count quads using the vertex::QuadInstance data in the given
+	 * buffer starting at instance index start, with one instance per quad.
+	 * If colors is false the per-instance colors are ignored.
+	 **/
+	void drawInstancedQuads(int start, int count, Buffer *instances, Texture *texture, bool colors);
+
 	void flushStreamDraws();
 	StreamVertexData requestStreamDraw(const StreamDrawCommand &command);
 
@@ -1016,7 +1094,27 @@ class Graphics : public Module
 	virtual void initCapabilities() = 0;
 	virtual void getAPIStats(int &shaderswitches) const = 0;
 
+	/**
+	 * Records a timestamp after all previously submitted GPU commands, and
+	 * returns its id or -1 if GPU timing isn't supported.
+	 **/
+	virtual int insertGPUTimestamp() = 0;
+
+	/**
+	 * Gets the results of the given timestamps in nanoseconds, without
+	 * stalling. Returns false if they aren't available yet. 'disjoint' is set
+	 * if the results are unreliable (e.g. the GPU's clock changed.)
+	 **/
+	virtual bool getGPUTimestamps(const std::vector<int> &ids, std::vector<uint64> &nanoseconds, bool &disjoint) = 0;
+	virtual void releaseGPUTimestamps(const std::vector<int> &ids) = 0;
+
+	void beginProfileFrame();
+	void endProfileFrame();
+	void endOpenProfileZones();
+	void discardProfileFrames();
+
 	void createQuadIndexBuffer();
+	void createQuadCornerBuffer();
 
 	Canvas *getTemporaryCanvas(PixelFormat format, int w, int h, int samples);
 
@@ -1057,17 +1155,53 @@ class Graphics : public Module
 	int drawCalls;
 	int drawCallsBatched;
 
+	FrameArena frameArena;
+
 	Buffer *quadIndexBuffer;
 
+	// The 4 corners of a unit quad, used for instanced quad drawing.
+	Buffer *quadCornerBuffer;
+
 	Capabilities capabilities;
 
 	Deprecations deprecations;
 
 	static const size_t MAX_USER_STACK_DEPTH = 128;
 	static const int MAX_TEMPORARY_CANVAS_UNUSED_FRAMES = 16;
+	static const size_t MAX_PENDING_PROFILE_FRAMES = 4;
 
 private:
 
+	struct PendingProfileZone
+	{
+		ProfileZone zone;
+		double cpuStart;
+
+		// Indices into the frame's GPU timestamps, or -1.
+		int gpuStart;
+		int gpuEnd;
+	};
+
+	struct ProfileFrame
+	{
+		std::vector<PendingProfileZone> zones;
+		std::vector<int> timestamps;
+	};
+
+	int beginProfileZoneInternal(const std::string &name, bool canvaspass);
+	void endProfileZoneInternal(int zone);
+	int recordProfileTimestamp();
+	void beginCanvasPassProfileZone(bool canvas);
+	void releaseProfileFrame(ProfileFrame &frame);
+
+	bool profilingEnabled;
+	ProfileFrame currentProfileFrame;
+	std::deque<ProfileFrame> pendingProfileFrames;
+	std::vector<int> profileZoneStack;
+	int canvasPassProfileZone;
+	std::vector<ProfileZone> profileZones;
+	std::vector<uint64> profileTimestamps;
+
 	void checkSetDefaultFont();
 	int calculateEllipsePoints(float rx, float ry) const;
 
@@ -187,6 +187,16 @@ void Image::replacePixels(const void *data, size_t size, int slice, int mipmap,
 		generateMipmaps();
 }
 
+void Image::replacePixels(StreamBuffer *source, size_t offset, size_t size, int slice, int mipmap, const Rect &rect, bool reloadmipmaps)
+{
+	Graphics::flushStreamDrawsGlobal();
+
+	uploadBufferData(source, offset, size, mipmap, slice, rect);
+
+	if (reloadmipmaps && mipmap == 0 && getMipmapCount() > 1)
+		generateMipmaps();
+}
+
 bool Image::isCompressed() const
 {
 	return isPixelFormatCompressed(format);
@@ -33,6 +33,8 @@ namespace love
 namespace graphics
 {
 
+class StreamBuffer;
+
 class Image : public Texture
 {
 public:
@@ -96,6 +98,12 @@ class Image : public Texture
 	void replacePixels(love::image::ImageDataBase *d, int slice, int mipmap, int x, int y, bool reloadmipmaps);
 	void replacePixels(const void *data, size_t size, int slice, int mipmap, const Rect &rect, bool reloadmipmaps);
 
+	/**
+	 * Uploads pixels which were written to the given StreamBuffer (created with
+	 * BUFFER_PIXEL_UNPACK) at the given offset.
+	 **/
+	void replacePixels(StreamBuffer *source, size_t offset, size_t size, int slice, int mipmap, const Rect &rect, bool reloadmipmaps);
+
 	bool isFormatLinear() const;
 	bool isCompressed() const;
 	MipmapsType getMipmapsType() const;
@@ -114,6 +122,7 @@ class Image : public Texture
 
 	void uploadImageData(love::image::ImageDataBase *d, int level, int slice, int x, int y);
 	virtual void uploadByteData(PixelFormat pixelformat, const void *data, size_t size, int level, int slice, const Rect &r) = 0;
+	virtual void uploadBufferData(StreamBuffer *source, size_t offset, size_t size, int level, int slice, const Rect &r) = 0;
 
 	virtual void generateMipmaps() = 0;
 
@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "LineMesh.h"
+#include "Polyline.h"
+#include "Shader.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+
+love::Type LineMesh::type("LineMesh", &Drawable::type);
+
+LineMesh::LineMesh(const std::vector<Vector2> &points, float width, Graphics::LineJoin join, Graphics::LineStyle style)
+	: lineWidth(width)
+	, lineJoin(join)
+	, lineStyle(style)
+	, vertexBuffer(nullptr)
+	, vertexCount(0)
+	, indexMode(vertex::TriangleIndexMode::STRIP)
+	, pixelSize(0.0f)
+	, dirty(true)
+{
+	vertexAttributes.setCommonFormat(vertex::CommonFormat::XYf, 0);
+	vertexAttributes.setCommonFormat(vertex::CommonFormat::RGBAub, 1);
+
+	setPoints(points);
+}
+
+LineMesh::~LineMesh()
+{
+	delete vertexBuffer;
+}
+
+void LineMesh::setPoints(const std::vector<Vector2> &points)
+{
+	if (points.size() < 2)
+		throw love::Exception("Need at least two points to draw a line.");
+
+	this->points = points;
+	dirty = true;
+}
+
+const std::vector<Vector2> &LineMesh::getPoints() const
+{
+	return points;
+}
+
+void LineMesh::setLineWidth(float width)
+{
+	if (width != lineWidth)
+		dirty = true;
+	lineWidth = width;
+}
+
+float LineMesh::getLineWidth() const
+{
+	return lineWidth;
+}
+
+void LineMesh::setLineJoin(Graphics::LineJoin join)
+{
+	if (join != lineJoin)
+		dirty = true;
+	lineJoin = join;
+}
+
+Graphics::LineJoin LineMesh::getLineJoin() const
+{
+	return lineJoin;
+}
+
+void LineMesh::setLineStyle(Graphics::LineStyle style)
+{
+	if (style != lineStyle)
+		dirty = true;
+	lineStyle = style;
+}
+
+Graphics::LineStyle LineMesh::getLineStyle() const
+{
+	return lineStyle;
+}
+
+void LineMesh::tessellate(Graphics *gfx, float pixelsize)
+{
+	float halfwidth = lineWidth * 0.5f;
+	bool smooth = lineStyle == Graphics::LINE_SMOOTH;
+
+	if (lineJoin == Graphics::LINE_JOIN_NONE)
+	{
+		NoneJoinPolyline line;
+		line.render(points.data(), points.size(), halfwidth, pixelsize, smooth);
+		upload(gfx, line);
+	}
+	else if (lineJoin == Graphics::LINE_JOIN_BEVEL)
+	{
+		BevelJoinPolyline line;
+		line.render(points.data(), points.size(), halfwidth, pixelsize, smooth);
+		upload(gfx, line);
+	}
+	else
+	{
+		MiterJoinPolyline line;
+		line.render(points.data(), points.size(), halfwidth, pixelsize, smooth);
+		upload(gfx, line);
+	}
+
+	pixelSize = pixelsize;
+	dirty = false;
+}
+
+void LineMesh::upload(Graphics *gfx, Polyline &line)
+{
+	size_t count = line.getVertexCount();
+	size_t positionsize = sizeof(Vector2) * count;
+	size_t datasize = positionsize + sizeof(Color32) * count;
+
+	vertexCount = 0;
+
+	if (count == 0)
+		return;
+
+	if (vertexBuffer == nullptr || datasize > vertexBuffer->getSize())
+	{
+		Buffer *newbuffer = gfx->newBuffer(datasize, nullptr, BUFFER_VERTEX, vertex::USAGE_STATIC, 0);
+		delete vertexBuffer;
+		vertexBuffer = newbuffer;
+	}
+
+	// Positions are followed by colors in the same buffer. The colors only
+	// hold the overdraw's alpha, the current color is applied when drawing.
+	uint8 *data = (uint8 *) vertexBuffer->map();
+	line.fill((Vector2 *) data, (Color32 *) (data + positionsize), Color32(255, 255, 255, 255));
+	// We unmap when we draw, to avoid unnecessary full map()/unmap() calls.
+
+	vertexBuffers.set(0, vertexBuffer, 0);
+	vertexBuffers.set(1, vertexBuffer, positionsize);
+
+	vertexCount = (int) count;
+	indexMode = line.getTriangleIndexMode();
+}
+
+void LineMesh::draw(Graphics *gfx, const Matrix4 &m)
+{
+	float sx, sy;
+	Matrix4(gfx->getTransform(), m).getApproximateScale(sx, sy);
+	float pixelsize = 1.0f / std::max((sx + sy) / 2.0f, 0.000001f);
+
+	if (lineStyle == Graphics::LINE_SMOOTH && pixelsize != pixelSize)
+		dirty = true;
+
+	if (dirty)
+		tessellate(gfx, pixelsize);
+
+	if (vertexCount == 0)
+		return;
+
+	gfx->flushStreamDraws();
+
+	if (Shader::isDefaultActive())
+		Shader::attachDefault(Shader::STANDARD_DEFAULT);
+
+	if (Shader::current)
+		Shader::current->checkMainTextureType(TEXTURE_2D, false);
+
+	vertexBuffer->unmap(); // Make sure all pending data is flushed to the GPU.
+
+	Graphics::TempTransform transform(gfx, m);
+
+	if (indexMode == vertex::TriangleIndexMode::QUADS)
+		gfx->drawQuads(0, vertexCount / 4, vertexAttributes, vertexBuffers, nullptr);
+	else
+	{
+		Graphics::DrawCommand cmd(&vertexAttributes, &vertexBuffers);
+		cmd.primitiveType = PRIMITIVE_TRIANGLE_STRIP;
+		cmd.vertexCount = vertexCount;
+		gfx->draw(cmd);
+	}
+}
+
+} // graphics
+} // love
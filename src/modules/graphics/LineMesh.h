@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/config.h"
+#include "common/Vector.h"
+#include "Drawable.h"
+#include "Graphics.h"
+#include "Buffer.h"
+#include "vertex.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+
+class Polyline;
+
+/**
+ * A line whose vertices are kept on the GPU. It's only re-tessellated when its
+ * points or line settings change, which makes it much cheaper to draw than
+ * love.graphics.line for lines that rarely change.
+ **/
+class LineMesh : public Drawable
+{
+public:
+
+	static love::Type type;
+
+	LineMesh(const std::vector<Vector2> &points, float width, Graphics::LineJoin join, Graphics::LineStyle style);
+	virtual ~LineMesh();
+
+	void setPoints(const std::vector<Vector2> &points);
+	const std::vector<Vector2> &getPoints() const;
+
+	void setLineWidth(float width);
+	float getLineWidth() const;
+
+	void setLineJoin(Graphics::LineJoin join);
+	Graphics::LineJoin getLineJoin() const;
+
+	void setLineStyle(Graphics::LineStyle style);
+	Graphics::LineStyle getLineStyle() const;
+
+	// Implements Drawable.
+	void draw(Graphics *gfx, const Matrix4 &m) override;
+
+private:
+
+	void tessellate(Graphics *gfx, float pixelsize);
+	void upload(Graphics *gfx, Polyline &line);
+
+	std::vector<Vector2> points;
+
+	float lineWidth;
+	Graphics::LineJoin lineJoin;
+	Graphics::LineStyle lineStyle;
+
+	vertex::Attributes vertexAttributes;
+	vertex::BufferBindings vertexBuffers;
+
+	Buffer *vertexBuffer;
+
+	int vertexCount;
+	vertex::TriangleIndexMode indexMode;
+
+	// Smooth lines depend on the size of a pixel, so they're re-tessellated if
+	// they're drawn at a different scale.
+	float pixelSize;
+
+	bool dirty;
+
+}; // LineMesh
+
+} // graphics
+} // love
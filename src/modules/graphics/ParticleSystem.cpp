@@ -187,11 +187,6 @@ void ParticleSystem::createBuffers(size_t size)
 	{
 		pFree = pMem = new Particle[size];
 		maxParticles = (uint32) size;
-
-		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
-
-		size_t bytes = sizeof(Vertex) * size * 4;
-		buffer = gfx->newBuffer(bytes, nullptr, BUFFER_VERTEX, vertex::USAGE_STREAM, 0);
 	}
 	catch (std::bad_alloc &)
 	{
@@ -1026,21 +1021,39 @@ void ParticleSystem::draw(Graphics *gfx, const Matrix4 &m)
 {
 	uint32 pCount = getCount();
 
-	if (pCount == 0 || texture.get() == nullptr || pMem == nullptr || buffer == nullptr)
+	if (pCount == 0 || texture.get() == nullptr || pMem == nullptr)
 		return;
 
+	// The vertex buffer is created on first draw, so particle systems can be
+	// updated without a graphics context (e.g. by love-bench).
+	if (buffer == nullptr)
+	{
+		size_t bytes = sizeof(Vertex) * maxParticles * 4;
+		uint32 mapflags = Buffer::MAP_EXPLICIT_RANGE_MODIFY | Buffer::MAP_DISCARD_UNMODIFIED;
+		buffer = gfx->newBuffer(bytes, nullptr, BUFFER_VERTEX, vertex::USAGE_STREAM, mapflags);
+	}
+
 	gfx->flushStreamDraws();
 
-	if (Shader::isDefaultActive())
-		Shader::attachDefault(Shader::STANDARD_DEFAULT);
+	// With instancing each particle only needs a single vertex::QuadInstance,
+	// which always fits in the space reserved for its 4 vertices.
+	static_assert(sizeof(vertex::QuadInstance) <= sizeof(Vertex) * 4, "QuadInstance is too big for the particle buffer");
+	bool instanced = texture->getTextureType() == TEXTURE_2D && gfx->canDrawInstancedQuads();
 
-	if (Shader::current && texture.get())
-		Shader::current->checkMainTexture(texture);
+	if (!instanced)
+	{
+		if (Shader::isDefaultActive())
+			Shader::attachDefault(Shader::STANDARD_DEFAULT);
+
+		if (Shader::current && texture.get())
+			Shader::current->checkMainTexture(texture);
+	}
 
 	const Vector2 *positions = texture->getQuad()->getVertexPositions();
 	const Vector2 *texcoords = texture->getQuad()->getVertexTexCoords();
 
 	Vertex *pVerts = (Vertex *) buffer->map();
+	vertex::QuadInstance *pInstances = (vertex::QuadInstance *) pVerts;
 	Particle *p = pHead;
 
 	bool useQuads = !quads.empty();
@@ -1058,12 +1071,21 @@ void ParticleSystem::draw(Graphics *gfx, const Matrix4 &m)
 
 		// particle vertices are image vertices transformed by particle info
 		t.setTransformation(p->position.x, p->position.y, p->angle, p->size, p->size, offset.x, offset.y, 0.0f, 0.0f);
-		t.transformXY(pVerts, positions, 4);
 
 		// Particle colors are stored as floats (0-1) but vertex colors are
 		// unsigned bytes (0-255).
 		Color32 c = toColor32(p->color);
 
+		if (instanced)
+		{
+			vertex::setQuadInstance(*pInstances, t, positions, texcoords, c);
+			pInstances++;
+			p = p->next;
+			continue;
+		}
+
+		t.transformXY(pVerts, positions, 4);
+
 		// set the texture coordinate and color data for particle vertices
 		for (int v = 0; v < 4; v++)
 		{
@@ -1076,10 +1098,23 @@ void ParticleSystem::draw(Graphics *gfx, const Matrix4 &m)
 		p = p->next;
 	}
 
+	// Only the data for the live particles is uploaded, which is a lot less
+	// than the whole buffer when instancing.
+	if (instanced)
+		buffer->setMappedRangeModified(0, sizeof(vertex::QuadInstance) * pCount);
+	else
+		buffer->setMappedRangeModified(0, sizeof(Vertex) * 4 * pCount);
+
 	buffer->unmap();
 
 	Graphics::TempTransform transform(gfx, m);
 
+	if (instanced)
+	{
+		gfx->drawInstancedQuads(0, pCount, buffer, texture, true);
+		return;
+	}
+
 	vertex::BufferBindings vertexbuffers;
 	vertexbuffers.set(0, buffer, 0);
 
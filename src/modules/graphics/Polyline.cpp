@@ -24,6 +24,15 @@
 
 // C++
 #include <algorithm>
+#include <string.h>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 // treat adjacent segments with angles between their directions <5 degree as straight
 static const float LINES_PARALLEL_EPS = 0.05f;
@@ -33,13 +42,94 @@ namespace love
 namespace graphics
 {
 
+// The sleeve of the most recently rendered line. These are reused, so drawing
+// a line doesn't need any allocations once they're big enough.
+static std::vector<Vector2> sleeveAnchors;
+static std::vector<Vector2> sleeveNormals;
+
+/**
+ * Writes pairs of sleeve vertices followed by the same vertices moved one pixel
+ * outward along their normals, which make up an overdraw strip. The sleeve is
+ * read starting at index 'first' and advancing by 'step'.
+ **/
+static void outsetSleeve(Vector2 *dst, const Vector2 *anchors, const Vector2 *normals, ptrdiff_t first, ptrdiff_t step, size_t count, float pixel_size)
+{
+	size_t i = 0;
+
+	// Two sleeve vertices are processed per iteration. The squared normal
+	// components are added to their swapped form to get [l0 l0 l1 l1], and the
+	// results are interleaved as [p0 o0] [p1 o1] when stored.
+#if defined(LOVE_SIMD_SSE)
+
+	const __m128 pixelsize = _mm_set1_ps(pixel_size);
+
+	for (; i + 2 <= count; i += 2)
+	{
+		const Vector2 *a0 = anchors + first + step * (ptrdiff_t) i;
+		const Vector2 *n0 = normals + first + step * (ptrdiff_t) i;
+
+		__m128 a = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) a0);
+		a = _mm_loadh_pi(a, (const __m64 *) (a0 + step));
+
+		__m128 n = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) n0);
+		n = _mm_loadh_pi(n, (const __m64 *) (n0 + step));
+
+		__m128 p = _mm_add_ps(a, n);
+
+		__m128 sq = _mm_mul_ps(n, n);
+		__m128 lensq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+		__m128 o = _mm_add_ps(p, _mm_mul_ps(n, _mm_div_ps(pixelsize, _mm_sqrt_ps(lensq))));
+
+		_mm_storeu_ps((float *) (dst + 2 * i + 0), _mm_movelh_ps(p, o));
+		_mm_storeu_ps((float *) (dst + 2 * i + 2), _mm_movehl_ps(o, p));
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	for (; i + 2 <= count; i += 2)
+	{
+		const Vector2 *a0 = anchors + first + step * (ptrdiff_t) i;
+		const Vector2 *n0 = normals + first + step * (ptrdiff_t) i;
+
+		float32x4_t a = vcombine_f32(vld1_f32((const float *) a0), vld1_f32((const float *) (a0 + step)));
+		float32x4_t n = vcombine_f32(vld1_f32((const float *) n0), vld1_f32((const float *) (n0 + step)));
+
+		float32x4_t p = vaddq_f32(a, n);
+
+		float32x4_t sq = vmulq_f32(n, n);
+		float32x4_t lensq = vaddq_f32(sq, vrev64q_f32(sq));
+
+		// Reciprocal square root estimate, refined with two Newton-Raphson steps.
+		float32x4_t rlen = vrsqrteq_f32(lensq);
+		rlen = vmulq_f32(rlen, vrsqrtsq_f32(vmulq_f32(lensq, rlen), rlen));
+		rlen = vmulq_f32(rlen, vrsqrtsq_f32(vmulq_f32(lensq, rlen), rlen));
+
+		float32x4_t o = vaddq_f32(p, vmulq_f32(n, vmulq_n_f32(rlen, pixel_size)));
+
+		float *d = (float *) (dst + 2 * i);
+		vst1q_f32(d + 0, vcombine_f32(vget_low_f32(p), vget_low_f32(o)));
+		vst1q_f32(d + 4, vcombine_f32(vget_high_f32(p), vget_high_f32(o)));
+	}
+
+#endif
+
+	for (; i < count; i++)
+	{
+		ptrdiff_t k = first + step * (ptrdiff_t) i;
+		Vector2 p = anchors[k] + normals[k];
+
+		dst[2 * i + 0] = p;
+		dst[2 * i + 1] = p + normals[k] * (pixel_size / normals[k].getLength());
+	}
+}
+
 void Polyline::render(const Vector2 *coords, size_t count, size_t size_hint, float halfwidth, float pixel_size, bool draw_overdraw)
 {
-	static std::vector<Vector2> anchors;
+	std::vector<Vector2> &anchors = sleeveAnchors;
 	anchors.clear();
 	anchors.reserve(size_hint);
 
-	static std::vector<Vector2> normals;
+	std::vector<Vector2> &normals = sleeveNormals;
 	normals.clear();
 	normals.reserve(size_hint);
 
@@ -70,11 +160,17 @@ void Polyline::render(const Vector2 *coords, size_t count, size_t size_hint, flo
 	pointB = is_looping ? coords[1] : pointB + segment;
 	renderEdge(anchors, normals, segment, segmentLength, segmentNormal, pointA, pointB, halfwidth);
 
-	vertex_count = normals.size();
+	this->pixel_size = pixel_size;
+	this->is_looping = is_looping;
 
-	size_t extra_vertices = 0;
+	vertex_count = 0;
+	if (normals.size() > 2 * sleeve_offset)
+		vertex_count = normals.size() - 2 * sleeve_offset;
 
-	if (draw_overdraw)
+	overdraw_vertex_count = 0;
+	extra_vertices = 0;
+
+	if (draw_overdraw && vertex_count > 0)
 	{
 		calc_overdraw_vertex_count(is_looping);
 
@@ -86,17 +182,30 @@ void Polyline::render(const Vector2 *coords, size_t count, size_t size_hint, flo
 			extra_vertices = 2;
 	}
 
+	overdraw_vertex_start = vertex_count + extra_vertices;
+}
+
+size_t Polyline::getVertexCount() const
+{
+	return overdraw_vertex_start + overdraw_vertex_count;
+}
+
+void Polyline::fill(Vector2 *positions, Color32 *colors, Color32 color)
+{
+	const Vector2 *anchors = sleeveAnchors.data() + sleeve_offset;
+	const Vector2 *normals = sleeveNormals.data() + sleeve_offset;
+
 	// Use a single linear array for both the regular and overdraw vertices.
-	vertices = new Vector2[vertex_count + extra_vertices + overdraw_vertex_count];
+	vertices = positions;
+	overdraw = nullptr;
 
 	for (size_t i = 0; i < vertex_count; ++i)
 		vertices[i] = anchors[i] + normals[i];
 
-	if (draw_overdraw)
+	if (overdraw_vertex_count > 0)
 	{
-		overdraw = vertices + vertex_count + extra_vertices;
-		overdraw_vertex_start = vertex_count + extra_vertices;
-		render_overdraw(normals, pixel_size, is_looping);
+		overdraw = vertices + overdraw_vertex_start;
+		render_overdraw(anchors, normals, pixel_size, is_looping);
 	}
 
 	// Add the degenerate triangle strip.
@@ -105,6 +214,16 @@ void Polyline::render(const Vector2 *coords, size_t count, size_t size_hint, flo
 		vertices[vertex_count + 0] = vertices[vertex_count - 1];
 		vertices[vertex_count + 1] = vertices[overdraw_vertex_start];
 	}
+
+	if (colors != nullptr)
+	{
+		// Constant vertex color up to the overdraw vertices.
+		for (size_t i = 0; i < overdraw_vertex_start; i++)
+			colors[i] = color;
+
+		if (overdraw_vertex_count > 0)
+			fill_color_array(color, colors + overdraw_vertex_start, (int) overdraw_vertex_count);
+	}
 }
 
 void NoneJoinPolyline::renderEdge(std::vector<Vector2> &anchors, std::vector<Vector2> &normals,
@@ -305,21 +424,13 @@ void Polyline::calc_overdraw_vertex_count(bool is_looping)
 	overdraw_vertex_count = 2 * vertex_count + (is_looping ? 0 : 2);
 }
 
-void Polyline::render_overdraw(const std::vector<Vector2> &normals, float pixel_size, bool is_looping)
+void Polyline::render_overdraw(const Vector2 *anchors, const Vector2 *normals, float pixel_size, bool is_looping)
 {
 	// upper segment
-	for (size_t i = 0; i + 1 < vertex_count; i += 2)
-	{
-		overdraw[i]   = vertices[i];
-		overdraw[i+1] = vertices[i] + normals[i] * (pixel_size / normals[i].getLength());
-	}
+	outsetSleeve(overdraw, anchors, normals, 0, 2, vertex_count / 2, pixel_size);
+
 	// lower segment
-	for (size_t i = 0; i + 1 < vertex_count; i += 2)
-	{
-		size_t k = vertex_count - i - 1;
-		overdraw[vertex_count + i]   = vertices[k];
-		overdraw[vertex_count + i+1] = vertices[k] + normals[k] * (pixel_size / normals[k].getLength());
-	}
+	outsetSleeve(overdraw + vertex_count, anchors, normals, (ptrdiff_t) vertex_count - 1, -2, vertex_count / 2, pixel_size);
 
 	// if not looping, the outer overdraw vertices need to be displaced
 	// to cover the line endings, i.e.:
@@ -351,81 +462,128 @@ void Polyline::render_overdraw(const std::vector<Vector2> &normals, float pixel_
 
 void NoneJoinPolyline::calc_overdraw_vertex_count(bool /*is_looping*/)
 {
-	overdraw_vertex_count = 4 * (vertex_count-2); // less than ideal
+	overdraw_vertex_count = 4 * vertex_count;
 }
 
-void NoneJoinPolyline::render_overdraw(const std::vector<Vector2> &/*normals*/, float pixel_size, bool /*is_looping*/)
+void NoneJoinPolyline::render_overdraw(const Vector2 *anchors, const Vector2 *normals, float pixel_size, bool /*is_looping*/)
 {
-	for (size_t i = 2; i + 3 < vertex_count; i += 4)
+	for (size_t i = 0; i + 3 < vertex_count; i += 4)
 	{
 		// v0-v2
 		// | / | <- main quad line
 		// v1-v3
 
-		Vector2 s = vertices[i+0] - vertices[i+2];
-		Vector2 t = vertices[i+0] - vertices[i+1];
+		const Vector2 v0 = anchors[i+0] + normals[i+0];
+		const Vector2 v1 = anchors[i+1] + normals[i+1];
+		const Vector2 v2 = anchors[i+2] + normals[i+2];
+		const Vector2 v3 = anchors[i+3] + normals[i+3];
+
+		Vector2 s = v0 - v2;
+		Vector2 t = v0 - v1;
 		s.normalize(pixel_size);
 		t.normalize(pixel_size);
 
-		const size_t k = 4 * (i - 2);
+		const size_t k = 4 * i;
 
-		overdraw[k+0] = vertices[i+0];
-		overdraw[k+1] = vertices[i+1];
-		overdraw[k+2] = vertices[i+0] + s + t;
-		overdraw[k+3] = vertices[i+1] + s - t;
+		overdraw[k+0] = v0;
+		overdraw[k+1] = v1;
+		overdraw[k+2] = v0 + s + t;
+		overdraw[k+3] = v1 + s - t;
 
-		overdraw[k+4] = vertices[i+1];
-		overdraw[k+5] = vertices[i+3];
-		overdraw[k+6] = vertices[i+1] + s - t;
-		overdraw[k+7] = vertices[i+3] - s - t;
+		overdraw[k+4] = v1;
+		overdraw[k+5] = v3;
+		overdraw[k+6] = v1 + s - t;
+		overdraw[k+7] = v3 - s - t;
 
-		overdraw[k+ 8] = vertices[i+3];
-		overdraw[k+ 9] = vertices[i+2];
-		overdraw[k+10] = vertices[i+3] - s - t;
-		overdraw[k+11] = vertices[i+2] - s + t;
+		overdraw[k+ 8] = v3;
+		overdraw[k+ 9] = v2;
+		overdraw[k+10] = v3 - s - t;
+		overdraw[k+11] = v2 - s + t;
 
-		overdraw[k+12] = vertices[i+2];
-		overdraw[k+13] = vertices[i+0];
-		overdraw[k+14] = vertices[i+2] - s + t;
-		overdraw[k+15] = vertices[i+0] + s + t;
+		overdraw[k+12] = v2;
+		overdraw[k+13] = v0;
+		overdraw[k+14] = v2 - s + t;
+		overdraw[k+15] = v0 + s + t;
 	}
 }
 
-Polyline::~Polyline()
-{
-	if (vertices)
-		delete[] vertices;
-}
-
 void Polyline::draw(love::graphics::Graphics *gfx)
 {
+	int total_vertex_count = (int) getVertexCount();
+	if (total_vertex_count == 0)
+		return;
+
 	const Matrix4 &t = gfx->getTransform();
 	bool is2D = t.isAffine2DTransform();
 	Color32 curcolor = toColor32(gfx->getColor());
 
-	int overdraw_start = (int) overdraw_vertex_start;
-	int overdraw_count = (int) overdraw_vertex_count;
-
-	int total_vertex_count = (int) vertex_count;
-	if (overdraw)
-		total_vertex_count = overdraw_start + overdraw_count;
-
 	// love's automatic batching can only deal with < 65k vertices per draw.
 	// uint16_max - 3 is evenly divisible by 6 (needed for quads mode).
 	int maxvertices = LOVE_UINT16_MAX - 3;
 
+	Graphics::StreamDrawCommand cmd;
+	cmd.formats[0] = vertex::getSinglePositionFormat(is2D);
+	cmd.formats[1] = vertex::CommonFormat::RGBAub;
+	cmd.indexMode = triangle_mode;
+
+	// Most lines fit in a single batch. Their colors are written directly into
+	// the batch's memory, but fill() reads back some of the positions it
+	// writes and batch memory may be write-only, so positions are generated in
+	// temporary memory and transformed on their way into the batch.
+	bool singledraw = total_vertex_count <= maxvertices;
+
+	size_t positionsize = sizeof(Vector2) * total_vertex_count;
+	size_t colorsize = singledraw ? 0 : sizeof(Color32) * total_vertex_count;
+
+	std::vector<uint8> heapdata;
+	Vector2 *positions = nullptr;
+	Color32 *colors = nullptr;
+
+	if (arena != nullptr)
+	{
+		positions = (Vector2 *) arena->allocate(positionsize);
+		if (colorsize > 0)
+			colors = (Color32 *) arena->allocate(colorsize);
+	}
+	else
+	{
+		heapdata.resize(positionsize + colorsize);
+		positions = (Vector2 *) heapdata.data();
+		colors = (Color32 *) (heapdata.data() + positionsize);
+	}
+
+	if (singledraw)
+	{
+		cmd.vertexCount = total_vertex_count;
+
+		Graphics::StreamVertexData data = gfx->requestStreamDraw(cmd);
+
+		fill(positions, (Color32 *) data.stream[1], curcolor);
+
+		if (is2D)
+			t.transformXY((Vector2 *) data.stream[0], positions, total_vertex_count);
+		else
+			t.transformXY0((Vector3 *) data.stream[0], positions, total_vertex_count);
+
+		// Gives the memory straight back, since it's the arena's most recent
+		// allocation. Otherwise every line in a frame would add to it.
+		if (arena != nullptr)
+			arena->deallocate(positions, positionsize);
+
+		return;
+	}
+
+	// Otherwise the line is split into several draws.
+	fill(positions, colors, curcolor);
+
 	int advance = maxvertices;
 	if (triangle_mode == vertex::TriangleIndexMode::STRIP)
 		advance -= 2;
 
 	for (int vertex_start = 0; vertex_start < total_vertex_count; vertex_start += advance)
 	{
-		const Vector2 *verts = vertices + vertex_start;
+		const Vector2 *verts = positions + vertex_start;
 
-		Graphics::StreamDrawCommand cmd;
-		cmd.formats[0] = vertex::getSinglePositionFormat(is2D);
-		cmd.formats[1] = vertex::CommonFormat::RGBAub;
-		cmd.indexMode = triangle_mode;
 		cmd.vertexCount = std::min(maxvertices, total_vertex_count - vertex_start);
 
 		Graphics::StreamVertexData data = gfx->requestStreamDraw(cmd);
@@ -435,31 +593,14 @@ void Polyline::draw(love::graphics::Graphics *gfx)
 		else
 			t.transformXY0((Vector3 *) data.stream[0], verts, cmd.vertexCount);
 
-		Color32 *colordata = (Color32 *) data.stream[1];
-
-		int draw_rough_count = std::min(cmd.vertexCount, (int) vertex_count - vertex_start);
-
-		// Constant vertex color up to the overdraw vertices.
-		for (int i = 0; i < draw_rough_count; i++)
-			colordata[i] = curcolor;
-
-		if (overdraw)
-		{
-			int draw_remaining_count = cmd.vertexCount - draw_rough_count;
-
-			int draw_overdraw_begin = overdraw_start - vertex_start;
-			int draw_overdraw_end = draw_overdraw_begin + overdraw_count;
-
-			draw_overdraw_begin = std::max(0, draw_overdraw_begin);
-
-			int draw_overdraw_count = std::min(draw_remaining_count, draw_overdraw_end - draw_overdraw_begin);
+		memcpy(data.stream[1], colors + vertex_start, sizeof(Color32) * cmd.vertexCount);
+	}
 
-			if (draw_overdraw_count > 0)
-			{
-				Color32 *colors = colordata + draw_overdraw_begin;
-				fill_color_array(curcolor, colors, draw_overdraw_count);
-			}
-		}
+	if (arena != nullptr)
+	{
+		if (colors != nullptr)
+			arena->deallocate(colors, colorsize);
+		arena->deallocate(positions, positionsize);
 	}
 }
 
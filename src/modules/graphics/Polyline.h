@@ -23,11 +23,12 @@
 // LOVE
 #include "common/config.h"
 #include "common/Vector.h"
+#include "common/Color.h"
+#include "common/FrameArena.h"
 #include "graphics/vertex.h"
 
 // C++
 #include <vector>
-#include <string.h>
 
 namespace love
 {
@@ -44,18 +45,32 @@ class Polyline
 {
 public:
 
-	Polyline(vertex::TriangleIndexMode mode = vertex::TriangleIndexMode::STRIP)
-		: vertices(nullptr)
+	/**
+	 * @param arena If not null, temporary vertices are allocated from it
+	 *              rather than the heap.
+	 **/
+	Polyline(FrameArena *arena, vertex::TriangleIndexMode mode = vertex::TriangleIndexMode::STRIP)
+		: arena(arena)
+		, vertices(nullptr)
 		, overdraw(nullptr)
 		, vertex_count(0)
 		, overdraw_vertex_count(0)
 		, triangle_mode(mode)
 		, overdraw_vertex_start(0)
+		, extra_vertices(0)
+		, sleeve_offset(0)
+		, pixel_size(1.0f)
+		, is_looping(false)
 	{}
 
-	virtual ~Polyline();
+	virtual ~Polyline() {}
 
 	/**
+	 * Computes the sleeve around the line. No vertices are generated until the
+	 * line is drawn or filled. The sleeve is stored in memory shared by all
+	 * Polylines, so this must be followed by draw() or fill() before another
+	 * Polyline is rendered.
+	 *
 	 * @param vertices      Vertices defining the core line segments
 	 * @param count         Number of vertices
 	 * @param size_hint     Expected number of vertices of the rendering sleeve around the core line.
@@ -65,6 +80,22 @@ class Polyline
 	 */
 	void render(const Vector2 *vertices, size_t count, size_t size_hint, float halfwidth, float pixel_size, bool draw_overdraw);
 
+	/**
+	 * Gets the total number of vertices of the rendered line, including the
+	 * overdraw vertices.
+	 **/
+	size_t getVertexCount() const;
+
+	vertex::TriangleIndexMode getTriangleIndexMode() const { return triangle_mode; }
+
+	/**
+	 * Writes the positions and colors of the rendered line's vertices. Both
+	 * arrays must have room for getVertexCount() elements. Some positions are
+	 * read back after being written, so they can't be in write-only memory
+	 * such as a mapped stream buffer. Colors are only written.
+	 **/
+	void fill(Vector2 *positions, Color32 *colors, Color32 color);
+
 	/** Draws the line on the screen
 	 */
 	void draw(love::graphics::Graphics *gfx);
@@ -72,7 +103,7 @@ class Polyline
 protected:
 
 	virtual void calc_overdraw_vertex_count(bool is_looping);
-	virtual void render_overdraw(const std::vector<Vector2> &normals, float pixel_size, bool is_looping);
+	virtual void render_overdraw(const Vector2 *anchors, const Vector2 *normals, float pixel_size, bool is_looping);
 	virtual void fill_color_array(Color32 constant_color, Color32 *colors, int count);
 
 	/** Calculate line boundary points.
@@ -90,12 +121,21 @@ class Polyline
 	                        Vector2 &segment, float &segmentLength, Vector2 &segmentNormal,
 	                        const Vector2 &pointA, const Vector2 &pointB, float halfWidth) = 0;
 
+	FrameArena *arena;
+
 	Vector2 *vertices;
 	Vector2 *overdraw;
 	size_t vertex_count;
 	size_t overdraw_vertex_count;
 	vertex::TriangleIndexMode triangle_mode;
 	size_t overdraw_vertex_start;
+	size_t extra_vertices;
+
+	// Number of redundant sleeve vertices at each end of the line.
+	size_t sleeve_offset;
+
+	float pixel_size;
+	bool is_looping;
 
 }; // Polyline
 
@@ -108,31 +148,22 @@ class NoneJoinPolyline : public Polyline
 {
 public:
 
-	NoneJoinPolyline()
-		: Polyline(vertex::TriangleIndexMode::QUADS)
-	{}
+	NoneJoinPolyline(FrameArena *arena = nullptr)
+		: Polyline(arena, vertex::TriangleIndexMode::QUADS)
+	{
+		// The first and last two sleeve vertices are redundant.
+		sleeve_offset = 2;
+	}
 
 	void render(const Vector2 *vertices, size_t count, float halfwidth, float pixel_size, bool draw_overdraw)
 	{
 		Polyline::render(vertices, count, 4 * count - 4, halfwidth, pixel_size, draw_overdraw);
-
-		// discard the first and last two vertices. (these are redundant)
-		for (size_t i = 0; i < vertex_count - 4; ++i)
-			this->vertices[i] = this->vertices[i+2];
-
-		// The last quad is now garbage, so zero it out to make sure it doesn't
-		// get rasterized. These vertices are in between the core line vertices
-		// and the overdraw vertices in the combined vertex array, so they still
-		// get "rendered" since we draw everything with one draw call.
-		memset(&this->vertices[vertex_count - 4], 0, sizeof(love::Vector2) * 4);
-
-		vertex_count -= 4;
 	}
 
 protected:
 
 	void calc_overdraw_vertex_count(bool is_looping) override;
-	void render_overdraw(const std::vector<Vector2> &normals, float pixel_size, bool is_looping) override;
+	void render_overdraw(const Vector2 *anchors, const Vector2 *normals, float pixel_size, bool is_looping) override;
 	void fill_color_array(Color32 constant_color, Color32 *colors, int count) override;
 	void renderEdge(std::vector<Vector2> &anchors, std::vector<Vector2> &normals,
 	                Vector2 &s, float &len_s, Vector2 &ns, const Vector2 &q,
@@ -149,6 +180,10 @@ class MiterJoinPolyline : public Polyline
 {
 public:
 
+	MiterJoinPolyline(FrameArena *arena = nullptr)
+		: Polyline(arena)
+	{}
+
 	void render(const Vector2 *vertices, size_t count, float halfwidth, float pixel_size, bool draw_overdraw)
 	{
 		Polyline::render(vertices, count, 2 * count, halfwidth, pixel_size, draw_overdraw);
@@ -171,6 +206,10 @@ class BevelJoinPolyline : public Polyline
 {
 public:
 
+	BevelJoinPolyline(FrameArena *arena = nullptr)
+		: Polyline(arena)
+	{}
+
 	void render(const Vector2 *vertices, size_t count, float halfwidth, float pixel_size, bool draw_overdraw)
 	{
 		Polyline::render(vertices, count, 4 * count - 4, halfwidth, pixel_size, draw_overdraw);
@@ -95,6 +95,7 @@ class Shader : public Object, public Resource
 		STANDARD_DEFAULT,
 		STANDARD_VIDEO,
 		STANDARD_ARRAY,
+		STANDARD_INSTANCED_QUADS,
 		STANDARD_MAX_ENUM
 	};
 
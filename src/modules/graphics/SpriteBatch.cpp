@@ -40,12 +40,13 @@ namespace graphics
 
 love::Type SpriteBatch::type("SpriteBatch", &Drawable::type);
 
-SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, vertex::Usage usage)
+SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, vertex::Usage usage, bool instanced)
 	: texture(texture)
 	, size(size)
 	, next(0)
 	, color(255, 255, 255, 255)
 	, color_active(false)
+	, instanced(instanced)
 	, array_buf(nullptr)
 	, range_start(-1)
 	, range_count(-1)
@@ -63,7 +64,17 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, vertex::Usag
 
 	vertex_stride = vertex::getFormatStride(vertex_format);
 
-	size_t vertex_size = vertex_stride * 4 * size;
+	if (instanced)
+	{
+		if (texture->getTextureType() != TEXTURE_2D)
+			throw love::Exception("Instanced SpriteBatches can only be used with 2D textures.");
+
+		sprite_stride = sizeof(vertex::QuadInstance);
+	}
+	else
+		sprite_stride = vertex_stride * 4;
+
+	size_t vertex_size = sprite_stride * size;
 	array_buf = gfx->newBuffer(vertex_size, nullptr, BUFFER_VERTEX, usage, Buffer::MAP_EXPLICIT_RANGE_MODIFY);
 }
 
@@ -94,19 +105,26 @@ int SpriteBatch::add(Quad *quad, const Matrix4 &m, int index /*= -1*/)
 	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
 
 	// Always keep the buffer mapped when adding data (it'll be unmapped on draw.)
-	size_t offset = (index == -1 ? next : index) * vertex_stride * 4;
-	auto verts = (XYf_STf_RGBAub *) ((uint8 *) array_buf->map() + offset);
-
-	m.transformXY(verts, quadpositions, 4);
+	size_t offset = (index == -1 ? next : index) * sprite_stride;
+	uint8 *data = (uint8 *) array_buf->map() + offset;
 
-	for (int i = 0; i < 4; i++)
+	if (instanced)
+		setQuadInstance(*(QuadInstance *) data, m, quadpositions, quadtexcoords, color);
+	else
 	{
-		verts[i].s = quadtexcoords[i].x;
-		verts[i].t = quadtexcoords[i].y;
-		verts[i].color = color;
+		auto verts = (XYf_STf_RGBAub *) data;
+
+		m.transformXY(verts, quadpositions, 4);
+
+		for (int i = 0; i < 4; i++)
+		{
+			verts[i].s = quadtexcoords[i].x;
+			verts[i].t = quadtexcoords[i].y;
+			verts[i].color = color;
+		}
 	}
 
-	array_buf->setMappedRangeModified(offset, vertex_stride * 4);
+	array_buf->setMappedRangeModified(offset, sprite_stride);
 
 	// Increment counter.
 	if (index == -1)
@@ -140,7 +158,7 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
 
 	// Always keep the buffer mapped when adding data (it'll be unmapped on draw.)
-	size_t offset = (index == -1 ? next : index) * vertex_stride * 4;
+	size_t offset = (index == -1 ? next : index) * sprite_stride;
 	auto verts = (XYf_STPf_RGBAub *) ((uint8 *) array_buf->map() + offset);
 
 	m.transformXY(verts, quadpositions, 4);
@@ -153,7 +171,7 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 		verts[i].color = color;
 	}
 
-	array_buf->setMappedRangeModified(offset, vertex_stride * 4);
+	array_buf->setMappedRangeModified(offset, sprite_stride);
 
 	// Increment counter.
 	if (index == -1)
@@ -224,7 +242,7 @@ void SpriteBatch::setBufferSize(int newsize)
 	if (newsize == size)
 		return;
 
-	size_t vertex_size = vertex_stride * 4 * newsize;
+	size_t vertex_size = sprite_stride * newsize;
 	love::graphics::Buffer *new_array_buf = nullptr;
 
 	int new_next = std::min(next, newsize);
@@ -235,7 +253,7 @@ void SpriteBatch::setBufferSize(int newsize)
 		new_array_buf = gfx->newBuffer(vertex_size, nullptr, array_buf->getType(), array_buf->getUsage(), array_buf->getMapFlags());
 
 		// Copy as much of the old data into the new GLBuffer as can fit.
-		size_t copy_size = vertex_stride * 4 * new_next;
+		size_t copy_size = sprite_stride * new_next;
 		array_buf->copyTo(0, copy_size, new_array_buf, 0);
 	}
 	catch (love::Exception &)
@@ -263,6 +281,9 @@ void SpriteBatch::attachAttribute(const std::string &name, Mesh *mesh)
 	AttachedAttribute oldattrib = {};
 	AttachedAttribute newattrib = {};
 
+	if (instanced)
+		throw love::Exception("Vertex attributes cannot be attached to an instanced SpriteBatch.");
+
 	if (mesh->getVertexCount() < (size_t) next * 4)
 		throw love::Exception("Mesh has too few vertices to be attached to this SpriteBatch (at least %d vertices are required)", next*4);
 
@@ -304,6 +325,11 @@ bool SpriteBatch::getDrawRange(int &start, int &count) const
 	return true;
 }
 
+bool SpriteBatch::isInstanced() const
+{
+	return instanced;
+}
+
 void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 {
 	using namespace vertex;
@@ -311,6 +337,36 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 	if (next == 0)
 		return;
 
+	int start = std::min(std::max(0, range_start), next - 1);
+
+	int count = next;
+	if (range_count > 0)
+		count = std::min(count, range_count);
+
+	count = std::min(count, next - start);
+
+	if (count <= 0)
+		return;
+
+	if (instanced)
+	{
+		if (!gfx->canDrawInstancedQuads())
+		{
+			drawExpanded(gfx, m, start, count);
+			return;
+		}
+
+		gfx->flushStreamDraws();
+
+		// Make sure the buffer isn't mapped when we draw (sends data to GPU if needed.)
+		array_buf->unmap();
+
+		Graphics::TempTransform transform(gfx, m);
+
+		gfx->drawInstancedQuads(start, count, array_buf, texture, color_active);
+		return;
+	}
+
 	gfx->flushStreamDraws();
 
 	if (texture.get())
@@ -385,16 +441,64 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 
 	Graphics::TempTransform transform(gfx, m);
 
-	int start = std::min(std::max(0, range_start), next - 1);
+	gfx->drawQuads(start, count, attributes, buffers, texture);
+}
 
-	int count = next;
-	if (range_count > 0)
-		count = std::min(count, range_count);
+void SpriteBatch::drawExpanded(Graphics *gfx, const Matrix4 &m, int start, int count)
+{
+	using namespace vertex;
 
-	count = std::min(count, next - start);
+	// The sprite data is still in the buffer's client-side copy.
+	const QuadInstance *instances = (const QuadInstance *) array_buf->map() + start;
 
-	if (count > 0)
-		gfx->drawQuads(start, count, attributes, buffers, texture);
+	const Matrix4 &tm = gfx->getTransform();
+	bool is2D = tm.isAffine2DTransform();
+
+	Matrix4 t(tm, m);
+
+	// Stream draws don't use the global color as a constant color, so it's
+	// baked into the vertices instead.
+	Colorf gcolor = gfx->getColor();
+
+	Graphics::StreamDrawCommand cmd;
+	cmd.formats[0] = getSinglePositionFormat(is2D);
+	cmd.formats[1] = CommonFormat::STf_RGBAub;
+	cmd.indexMode = TriangleIndexMode::QUADS;
+	cmd.texture = texture;
+
+	const int MAX_QUADS_PER_DRAW = LOVE_UINT16_MAX / 4;
+
+	for (int quadstart = 0; quadstart < count; quadstart += MAX_QUADS_PER_DRAW)
+	{
+		int quadcount = std::min(MAX_QUADS_PER_DRAW, count - quadstart);
+		cmd.vertexCount = quadcount * 4;
+
+		Graphics::StreamVertexData data = gfx->requestStreamDraw(cmd);
+		STf_RGBAub *attributedata = (STf_RGBAub *) data.stream[1];
+
+		for (int i = 0; i < quadcount; i++)
+		{
+			const QuadInstance &instance = instances[quadstart + i];
+
+			Vector2 positions[4];
+			Vector2 texcoords[4];
+			getQuadInstanceVertices(instance, positions, texcoords);
+
+			if (is2D)
+				t.transformXY((Vector2 *) data.stream[0] + i * 4, positions, 4);
+			else
+				t.transformXY0((Vector3 *) data.stream[0] + i * 4, positions, 4);
+
+			Color32 c = toColor32(color_active ? toColorf(instance.color) * gcolor : gcolor);
+
+			for (int v = 0; v < 4; v++)
+			{
+				attributedata[i * 4 + v].s = texcoords[v].x;
+				attributedata[i * 4 + v].t = texcoords[v].y;
+				attributedata[i * 4 + v].color = c;
+			}
+		}
+	}
 }
 
 } // graphics
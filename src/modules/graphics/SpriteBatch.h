@@ -51,7 +51,7 @@ class SpriteBatch : public Drawable
 
 	static love::Type type;
 
-	SpriteBatch(Graphics *gfx, Texture *texture, int size, vertex::Usage usage);
+	SpriteBatch(Graphics *gfx, Texture *texture, int size, vertex::Usage usage, bool instanced = false);
 	virtual ~SpriteBatch();
 
 	int add(const Matrix4 &m, int index = -1);
@@ -106,6 +106,12 @@ class SpriteBatch : public Drawable
 	void setDrawRange();
 	bool getDrawRange(int &start, int &count) const;
 
+	/**
+	 * Whether this SpriteBatch stores one vertex::QuadInstance per sprite
+	 * rather than 4 vertices, and draws them with instancing when possible.
+	 **/
+	bool isInstanced() const;
+
 	// Implements Drawable.
 	void draw(Graphics *gfx, const Matrix4 &m) override;
 
@@ -123,6 +129,12 @@ class SpriteBatch : public Drawable
 	 **/
 	void setBufferSize(int newsize);
 
+	/**
+	 * Draws the sprites of an instanced SpriteBatch as regular vertices, for
+	 * when instanced drawing can't be used (e.g. a custom Shader is active.)
+	 **/
+	void drawExpanded(Graphics *gfx, const Matrix4 &m, int start, int count);
+
 	StrongRef<Texture> texture;
 
 	// Max number of sprites in the batch.
@@ -138,6 +150,11 @@ class SpriteBatch : public Drawable
 
 	vertex::CommonFormat vertex_format;
 	size_t vertex_stride;
+
+	bool instanced;
+
+	// Size in bytes of a single sprite's data in the buffer.
+	size_t sprite_stride;
 	
 	love::graphics::Buffer *array_buf;
 
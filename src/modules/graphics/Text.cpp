@@ -45,7 +45,7 @@ Text::~Text()
 	delete vertex_buffer;
 }
 
-void Text::uploadVertices(const std::vector<Font::GlyphVertex> &vertices, size_t vertoffset)
+void Text::uploadVertices(const Font::GlyphVertices &vertices, size_t vertoffset)
 {
 	size_t offset = vertoffset * sizeof(Font::GlyphVertex);
 	size_t datasize = vertices.size() * sizeof(Font::GlyphVertex);
@@ -98,8 +98,8 @@ void Text::regenerateVertices()
 
 void Text::addTextData(const TextData &t)
 {
-	std::vector<Font::GlyphVertex> vertices;
-	std::vector<Font::DrawCommand> new_commands;
+	Font::GlyphVertices vertices;
+	Font::DrawCommands new_commands;
 
 	Font::TextInfo text_info;
 
@@ -79,7 +79,7 @@ class Text : public Drawable
 		Matrix4 matrix;
 	};
 
-	void uploadVertices(const std::vector<Font::GlyphVertex> &vertices, size_t vertoffset);
+	void uploadVertices(const Font::GlyphVertices &vertices, size_t vertoffset);
 	void regenerateVertices();
 	void addTextData(const TextData &s);
 
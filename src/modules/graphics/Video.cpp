@@ -23,6 +23,10 @@
 // LOVE
 #include "Shader.h"
 #include "Graphics.h"
+#include "StreamBuffer.h"
+
+// C
+#include <string.h>
 
 namespace love
 {
@@ -36,6 +40,7 @@ Video::Video(Graphics *gfx, love::video::VideoStream *stream, float dpiscale)
 	, width(stream->getWidth() / dpiscale)
 	, height(stream->getHeight() / dpiscale)
 	, filter(Texture::defaultFilter)
+	, uploadBuffer(nullptr)
 {
 	filter.mipmap = Texture::FILTER_NONE;
 
@@ -92,12 +97,28 @@ Video::Video(Graphics *gfx, love::video::VideoStream *stream, float dpiscale)
 
 		images[i].set(img, Acquire::NORETAIN);
 	}
+
+	imageVersions[0] = frame->yversion;
+	imageVersions[1] = frame->cbversion;
+	imageVersions[2] = frame->crversion;
+
+	// Only worth it if uploads can be sourced from a GPU buffer.
+	size_t framesize = getPixelFormatSize(PIXELFORMAT_R8) * (frame->yw * frame->yh + 2 * frame->cw * frame->ch);
+	uploadBuffer = gfx->newPixelStreamBuffer(framesize);
+
+	if (uploadBuffer->getHandle() == 0)
+	{
+		delete uploadBuffer;
+		uploadBuffer = nullptr;
+	}
 }
 
 Video::~Video()
 {
 	if (source)
 		source->stop();
+
+	delete uploadBuffer;
 }
 
 love::video::VideoStream *Video::getStream()
@@ -150,24 +171,83 @@ void Video::update()
 	bool bufferschanged = stream->swapBuffers();
 	stream->fillBackBuffer();
 
-	if (bufferschanged)
+	if (!bufferschanged)
+		return;
+
+	auto frame = (const love::video::VideoStream::Frame*) stream->getFrontBuffer();
+
+	int widths[3]  = {frame->yw, frame->cw, frame->cw};
+	int heights[3] = {frame->yh, frame->ch, frame->ch};
+
+	const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
+	uint64 versions[3] = {frame->yversion, frame->cbversion, frame->crversion};
+
+	size_t bpp = getPixelFormatSize(PIXELFORMAT_R8);
+	size_t sizes[3];
+	size_t totalsize = 0;
+
+	for (int i = 0; i < 3; i++)
 	{
-		auto frame = (const love::video::VideoStream::Frame*) stream->getFrontBuffer();
+		// Planes which haven't changed since the last upload are skipped.
+		if (versions[i] == imageVersions[i])
+			sizes[i] = 0;
+		else
+			sizes[i] = bpp * widths[i] * heights[i];
+
+		totalsize += sizes[i];
+	}
 
-		int widths[3]  = {frame->yw, frame->cw, frame->cw};
-		int heights[3] = {frame->yh, frame->ch, frame->ch};
+	if (totalsize == 0)
+		return;
 
-		const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
+	// Each upload gets its own fenced section of the staging ring, so the
+	// copy into it never waits on a texture the GPU is still reading.
+	StreamBuffer::MapInfo map;
+	if (uploadBuffer != nullptr)
+		map = uploadBuffer->map(totalsize);
+
+	if (map.size >= totalsize)
+	{
+		size_t offset = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			memcpy(map.data + offset, data[i], sizes[i]);
+			offset += sizes[i];
+		}
+
+		size_t bufferoffset = uploadBuffer->unmap(totalsize);
+
+		offset = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			if (sizes[i] == 0)
+				continue;
+
+			Rect rect = {0, 0, widths[i], heights[i]};
+			images[i]->replacePixels(uploadBuffer, bufferoffset + offset, sizes[i], 0, 0, rect, false);
+			offset += sizes[i];
+		}
+
+		uploadBuffer->markUsed(totalsize);
+		uploadBuffer->nextFrame();
+	}
+	else
+	{
+		if (uploadBuffer != nullptr)
+			uploadBuffer->unmap(0);
 
 		for (int i = 0; i < 3; i++)
 		{
-			size_t bpp = getPixelFormatSize(PIXELFORMAT_R8);
-			size_t size = bpp * widths[i] * heights[i];
+			if (sizes[i] == 0)
+				continue;
 
 			Rect rect = {0, 0, widths[i], heights[i]};
-			images[i]->replacePixels(data[i], size, 0, 0, rect, false);
+			images[i]->replacePixels(data[i], sizes[i], 0, 0, rect, false);
 		}
 	}
+
+	for (int i = 0; i < 3; i++)
+		imageVersions[i] = versions[i];
 }
 
 love::audio::Source *Video::getSource()
@@ -34,6 +34,7 @@ namespace graphics
 {
 
 class Graphics;
+class StreamBuffer;
 
 class Video : public Drawable
 {
@@ -75,6 +76,8 @@ class Video : public Drawable
 	Vertex vertices[4];
 
 	StrongRef<Image> images[3];
+	uint64 imageVersions[3];
+	StreamBuffer *uploadBuffer;
 	StrongRef<love::audio::Source> source;
 	
 }; // Video
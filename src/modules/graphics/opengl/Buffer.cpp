@@ -35,18 +35,29 @@ namespace graphics
 namespace opengl
 {
 
+// Needed because std::min takes it by reference.
+const size_t Buffer::MODIFIED_PAGE_SIZE;
+const size_t Buffer::MODIFIED_RANGE_MAX_GAP;
+const size_t Buffer::MAX_MODIFIED_RANGES;
+
 Buffer::Buffer(size_t size, const void *data, BufferType type, vertex::Usage usage, uint32 mapflags)
 	: love::graphics::Buffer(size, type, usage, mapflags)
 	, vbo(0)
 	, memory_map(nullptr)
-	, modified_start(std::numeric_limits<size_t>::max())
-	, modified_end(0)
+	, modified_page_first(std::numeric_limits<size_t>::max())
+	, modified_page_last(0)
 {
 	target = OpenGL::getGLBufferType(type);
 
 	try
 	{
 		memory_map = new char[size];
+
+		if ((mapflags & MAP_EXPLICIT_RANGE_MODIFY) != 0)
+		{
+			size_t pagecount = (size + MODIFIED_PAGE_SIZE - 1) / MODIFIED_PAGE_SIZE;
+			modified_pages.resize((pagecount + 63) / 64, 0);
+		}
 	}
 	catch (std::bad_alloc &)
 	{
@@ -78,8 +89,7 @@ void *Buffer::map()
 
 	is_mapped = true;
 
-	modified_start = std::numeric_limits<size_t>::max();
-	modified_end = 0;
+	clearModifiedPages();
 
 	return memory_map;
 }
@@ -94,7 +104,7 @@ void Buffer::unmapStatic(size_t offset, size_t size)
 	glBufferSubData(target, (GLintptr) offset, (GLsizeiptr) size, memory_map + offset);
 }
 
-void Buffer::unmapStream()
+void Buffer::unmapStream(size_t size)
 {
 	GLenum glusage = OpenGL::getGLBufferUsage(getUsage());
 
@@ -105,71 +115,138 @@ void Buffer::unmapStream()
 
 #if LOVE_WINDOWS
 	// TODO: Verify that this codepath is a useful optimization.
-	if (gl.getVendor() == OpenGL::VENDOR_INTEL)
+	if (gl.getVendor() == OpenGL::VENDOR_INTEL && size == getSize())
 		glBufferData(target, (GLsizeiptr) getSize(), memory_map, glusage);
 	else
 #endif
-		glBufferSubData(target, 0, (GLsizeiptr) getSize(), memory_map);
+		glBufferSubData(target, 0, (GLsizeiptr) size, memory_map);
 }
 
-void Buffer::unmap()
+void Buffer::clearModifiedPages()
 {
-	if (!is_mapped)
-		return;
+	if (modified_page_last >= modified_page_first)
+	{
+		size_t lastword = std::min(modified_page_last / 64, modified_pages.size() - 1);
+		for (size_t i = modified_page_first / 64; i <= lastword; i++)
+			modified_pages[i] = 0;
+	}
+
+	modified_page_first = std::numeric_limits<size_t>::max();
+	modified_page_last = 0;
+}
+
+size_t Buffer::getModifiedRanges()
+{
+	modified_ranges.clear();
+
+	if ((map_flags & MAP_EXPLICIT_RANGE_MODIFY) == 0)
+	{
+		modified_ranges.push_back({0, getSize()});
+		return getSize();
+	}
+
+	Range range = {0, 0};
 
-	if ((map_flags & MAP_EXPLICIT_RANGE_MODIFY) != 0)
+	for (size_t page = modified_page_first; page <= modified_page_last; page++)
 	{
-		if (modified_end >= modified_start)
+		if ((modified_pages[page / 64] & (1ull << (page % 64))) == 0)
+			continue;
+
+		size_t offset = page * MODIFIED_PAGE_SIZE;
+		size_t size = std::min(MODIFIED_PAGE_SIZE, getSize() - offset);
+
+		// Adjacent and nearby pages are coalesced into a single range. The
+		// unmodified pages in between still hold valid data, so uploading
+		// them again is harmless.
+		if (range.size > 0 && offset - (range.offset + range.size) <= MODIFIED_RANGE_MAX_GAP)
+			range.size = offset + size - range.offset;
+		else
 		{
-			modified_start = std::min(modified_start, getSize() - 1);
-			modified_end = std::min(modified_end, getSize() - 1);
+			if (range.size > 0)
+				modified_ranges.push_back(range);
+			range = {offset, size};
 		}
 	}
-	else
+
+	if (range.size > 0)
+		modified_ranges.push_back(range);
+
+	// Bound the number of separate uploads for widely scattered writes.
+	if (modified_ranges.size() > MAX_MODIFIED_RANGES)
 	{
-		modified_start = 0;
-		modified_end = getSize() - 1;
+		size_t first = modified_ranges.front().offset;
+		size_t end = modified_ranges.back().offset + modified_ranges.back().size;
+
+		modified_ranges.clear();
+		modified_ranges.push_back({first, end - first});
 	}
 
-	if (modified_end >= modified_start)
+	size_t totalsize = 0;
+	for (const Range &r : modified_ranges)
+		totalsize += r.size;
+
+	return totalsize;
+}
+
+void Buffer::unmap()
+{
+	if (!is_mapped)
+		return;
+
+	size_t modifiedsize = getModifiedRanges();
+
+	// Orphaning the buffer loses everything which isn't uploaded again, so
+	// normally all of it is.
+	size_t streamsize = getSize();
+	if ((map_flags & MAP_DISCARD_UNMODIFIED) != 0 && !modified_ranges.empty())
+		streamsize = modified_ranges.back().offset + modified_ranges.back().size;
+
+	if (modifiedsize > 0)
 	{
-		size_t modified_size = (modified_end - modified_start) + 1;
 		switch (getUsage())
 		{
 		case vertex::USAGE_STATIC:
-			unmapStatic(modified_start, modified_size);
+			for (const Range &range : modified_ranges)
+				unmapStatic(range.offset, range.size);
 			break;
 		case vertex::USAGE_STREAM:
-			unmapStream();
+			unmapStream(streamsize);
 			break;
 		case vertex::USAGE_DYNAMIC:
 		default:
 			// It's probably more efficient to treat it like a streaming buffer if
 			// at least a third of its contents have been modified during the map().
-			if (modified_size >= getSize() / 3)
-				unmapStream();
+			if (modifiedsize >= getSize() / 3)
+				unmapStream(streamsize);
 			else
-				unmapStatic(modified_start, modified_size);
+			{
+				for (const Range &range : modified_ranges)
+					unmapStatic(range.offset, range.size);
+			}
 			break;
 		}
 	}
 
-	modified_start = std::numeric_limits<size_t>::max();
-	modified_end = 0;
+	clearModifiedPages();
 
 	is_mapped = false;
 }
 
 void Buffer::setMappedRangeModified(size_t offset, size_t modifiedsize)
 {
-	if (!is_mapped || !(map_flags & MAP_EXPLICIT_RANGE_MODIFY))
+	if (!is_mapped || !(map_flags & MAP_EXPLICIT_RANGE_MODIFY) || modifiedsize == 0 || offset >= getSize())
 		return;
 
-	// We're being conservative right now by internally marking the whole range
-	// from the start of section a to the end of section b as modified if both
-	// a and b are marked as modified.
-	modified_start = std::min(modified_start, offset);
-	modified_end = std::max(modified_end, offset + modifiedsize - 1);
+	// Modified ranges are tracked per page, so sprite 0 and sprite 9999 of a
+	// SpriteBatch don't cause everything in between to be uploaded.
+	size_t first = offset / MODIFIED_PAGE_SIZE;
+	size_t last = (std::min(offset + modifiedsize, getSize()) - 1) / MODIFIED_PAGE_SIZE;
+
+	for (size_t page = first; page <= last; page++)
+		modified_pages[page / 64] |= 1ull << (page % 64);
+
+	modified_page_first = std::min(modified_page_first, first);
+	modified_page_last = std::max(modified_page_last, last);
 }
 
 void Buffer::fill(size_t offset, size_t size, const void *data)
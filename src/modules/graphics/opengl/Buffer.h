@@ -28,6 +28,9 @@
 // OpenGL
 #include "OpenGL.h"
 
+// C++
+#include <vector>
+
 namespace love
 {
 namespace graphics
@@ -56,11 +59,31 @@ class Buffer final : public love::graphics::Buffer, public Volatile
 
 private:
 
+	struct Range
+	{
+		size_t offset;
+		size_t size;
+	};
+
+	// Modified data is tracked in pages of this many bytes.
+	static const size_t MODIFIED_PAGE_SIZE = 4096;
+
+	// Modified ranges separated by at most this many unmodified bytes are
+	// uploaded as one, since a few extra pages cost less than another call.
+	static const size_t MODIFIED_RANGE_MAX_GAP = MODIFIED_PAGE_SIZE * 4;
+
+	// Past this many separate ranges, a single range covering all of them is
+	// uploaded instead.
+	static const size_t MAX_MODIFIED_RANGES = 16;
+
 	bool load(bool restore);
 	void unload();
 
 	void unmapStatic(size_t offset, size_t size);
-	void unmapStream();
+	void unmapStream(size_t size);
+
+	void clearModifiedPages();
+	size_t getModifiedRanges();
 
 	GLenum target;
 
@@ -70,8 +93,15 @@ class Buffer final : public love::graphics::Buffer, public Volatile
 	// A pointer to mapped memory.
 	char *memory_map;
 
-	size_t modified_start;
-	size_t modified_end;
+	// One bit per page of memory_map, set when the page is modified while
+	// mapped. The first and last modified pages bound the scan in unmap().
+	std::vector<uint64> modified_pages;
+	size_t modified_page_first;
+	size_t modified_page_last;
+
+	// Coalesced runs of modified pages, rebuilt in unmap(). They may include
+	// small unmodified gaps.
+	std::vector<Range> modified_ranges;
 
 }; // Buffer
 
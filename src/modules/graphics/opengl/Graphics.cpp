@@ -223,6 +223,7 @@ bool Graphics::setMode(int width, int height, int pixelwidth, int pixelheight, b
 		::printf("Could not reload all volatile objects.\n");
 
 	createQuadIndexBuffer();
+	createQuadCornerBuffer();
 
 	// Restore the graphics state.
 	restoreState(states.back());
@@ -236,6 +237,9 @@ bool Graphics::setMode(int width, int height, int pixelwidth, int pixelheight, b
 		if (i == Shader::STANDARD_ARRAY && !capabilities.textureTypes[TEXTURE_2D_ARRAY])
 			continue;
 
+		if (i == Shader::STANDARD_INSTANCED_QUADS && !capabilities.features[FEATURE_INSTANCING])
+			continue;
+
 		// Apparently some intel GMA drivers on windows fail to compile shaders
 		// which use array textures despite claiming support for the extension.
 		try
@@ -250,8 +254,11 @@ bool Graphics::setMode(int width, int height, int pixelwidth, int pixelheight, b
 		{
 			if (i == Shader::STANDARD_ARRAY)
 				capabilities.textureTypes[TEXTURE_2D_ARRAY] = false;
-			else
+			else if (i != Shader::STANDARD_INSTANCED_QUADS)
 				throw;
+
+			// Otherwise SpriteBatches and ParticleSystems just fall back to
+			// their non-instanced code paths.
 		}
 	}
 
@@ -283,6 +290,14 @@ void Graphics::unSetMode()
 	framebufferObjects.clear();
 	temporaryCanvases.clear();
 
+	discardProfileFrames();
+
+	if (!timestampQueries.empty())
+		glDeleteQueries((GLsizei) timestampQueries.size(), timestampQueries.data());
+
+	timestampQueries.clear();
+	freeTimestampQueries.clear();
+
 	if (mainVAO != 0)
 	{
 		glDeleteVertexArrays(1, &mainVAO);
@@ -376,11 +391,10 @@ void Graphics::drawQuads(int start, int count, const vertex::Attributes &attribu
 	gl.bindTextureToUnit(texture, 0, false);
 	gl.setCullMode(CULL_NONE);
 
-	gl.bindBuffer(BUFFER_INDEX, quadIndexBuffer->getHandle());
-
 	if (gl.isBaseVertexSupported())
 	{
 		gl.setVertexAttributes(attributes, buffers);
+		gl.bindBuffer(BUFFER_INDEX, quadIndexBuffer->getHandle());
 
 		int basevertex = start * 4;
 
@@ -403,6 +417,7 @@ void Graphics::drawQuads(int start, int count, const vertex::Attributes &attribu
 		for (int quadindex = 0; quadindex < count; quadindex += MAX_QUADS_PER_DRAW)
 		{
 			gl.setVertexAttributes(attributes, bufferscopy);
+			gl.bindBuffer(BUFFER_INDEX, quadIndexBuffer->getHandle());
 
 			int quadcount = std::min(MAX_QUADS_PER_DRAW, count - quadindex);
 
@@ -906,6 +921,8 @@ void Graphics::present(void *screenshotCallbackData)
 	flushStreamDraws();
 	endPass();
 
+	endProfileFrame();
+
 	gl.bindFramebuffer(OpenGL::FRAMEBUFFER_ALL, gl.getDefaultFBO());
 
 	if (!pendingScreenshotCallbacks.empty())
@@ -1020,6 +1037,9 @@ void Graphics::present(void *screenshotCallbackData)
 	canvasSwitchCount = 0;
 	drawCallsBatched = 0;
 
+	// Nothing drawn last frame should still be using transient memory.
+	frameArena.reset();
+
 	// This assumes temporary canvases will only be used within a render pass.
 	for (int i = (int) temporaryCanvases.size() - 1; i >= 0; i--)
 	{
@@ -1032,6 +1052,8 @@ void Graphics::present(void *screenshotCallbackData)
 		else
 			temporaryCanvases[i].framesSinceUse++;
 	}
+
+	beginProfileFrame();
 }
 
 void Graphics::setScissor(const Rect &rect)
@@ -1366,6 +1388,68 @@ Graphics::RendererInfo Graphics::getRendererInfo() const
 	return info;
 }
 
+int Graphics::insertGPUTimestamp()
+{
+	if (!gl.isTimerQuerySupported())
+		return -1;
+
+	int id = -1;
+
+	if (!freeTimestampQueries.empty())
+	{
+		id = freeTimestampQueries.back();
+		freeTimestampQueries.pop_back();
+	}
+	else
+	{
+		GLuint query = 0;
+		glGenQueries(1, &query);
+		id = (int) timestampQueries.size();
+		timestampQueries.push_back(query);
+	}
+
+	glQueryCounter(timestampQueries[id], GL_TIMESTAMP);
+	return id;
+}
+
+bool Graphics::getGPUTimestamps(const std::vector<int> &ids, std::vector<uint64> &nanoseconds, bool &disjoint)
+{
+	nanoseconds.resize(ids.size());
+	disjoint = false;
+
+	if (ids.empty())
+		return true;
+
+	// The GPU finishes queries in submission order, so the last one being
+	// available means reading the rest won't stall.
+	GLuint available = 0;
+	glGetQueryObjectuiv(timestampQueries[ids.back()], GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if (!available)
+		return false;
+
+	if (GLAD_EXT_disjoint_timer_query && !(GLAD_VERSION_3_3 || GLAD_ARB_timer_query))
+	{
+		GLint gpudisjoint = 0;
+		glGetIntegerv(GL_GPU_DISJOINT_EXT, &gpudisjoint);
+		disjoint = gpudisjoint != 0;
+	}
+
+	for (size_t i = 0; i < ids.size(); i++)
+	{
+		GLuint64 result = 0;
+		glGetQueryObjectui64v(timestampQueries[ids[i]], GL_QUERY_RESULT, &result);
+		nanoseconds[i] = (uint64) result;
+	}
+
+	return true;
+}
+
+void Graphics::releaseGPUTimestamps(const std::vector<int> &ids)
+{
+	freeTimestampQueries.insert(freeTimestampQueries.end(), ids.begin(), ids.end());
+}
+
 void Graphics::getAPIStats(int &shaderswitches) const
 {
 	shaderswitches = gl.stats.shaderSwitches;
@@ -142,6 +142,9 @@ class Graphics final : public love::graphics::Graphics
 	void setCanvasInternal(const RenderTargets &rts, int w, int h, int pixelw, int pixelh, bool hasSRGBcanvas) override;
 	void initCapabilities() override;
 	void getAPIStats(int &shaderswitches) const override;
+	int insertGPUTimestamp() override;
+	bool getGPUTimestamps(const std::vector<int> &ids, std::vector<uint64> &nanoseconds, bool &disjoint) override;
+	void releaseGPUTimestamps(const std::vector<int> &ids) override;
 
 	void endPass();
 	void bindCachedFBO(const RenderTargets &targets);
@@ -153,6 +156,9 @@ class Graphics final : public love::graphics::Graphics
 	bool windowHasStencil;
 	GLuint mainVAO;
 
+	std::vector<GLuint> timestampQueries;
+	std::vector<int> freeTimestampQueries;
+
 }; // Graphics
 
 } // opengl
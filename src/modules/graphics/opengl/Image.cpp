@@ -21,6 +21,7 @@
 #include "Image.h"
 
 #include "graphics/Graphics.h"
+#include "graphics/StreamBuffer.h"
 #include "common/int.h"
 
 // STD
@@ -176,6 +177,27 @@ void Image::uploadByteData(PixelFormat pixelformat, const void *data, size_t siz
 	}
 }
 
+void Image::uploadBufferData(love::graphics::StreamBuffer *source, size_t offset, size_t size, int level, int slice, const Rect &r)
+{
+	// While a pixel unpack buffer is bound, the data pointer given to texture
+	// uploads is an offset into it. Buffers without a GL object store client
+	// memory, whose address is returned as the offset instead.
+	gl.bindBuffer(BUFFER_PIXEL_UNPACK, (GLuint) source->getHandle());
+
+	try
+	{
+		uploadByteData(format, (const void *) offset, size, level, slice, r);
+	}
+	catch (love::Exception &)
+	{
+		gl.bindBuffer(BUFFER_PIXEL_UNPACK, 0);
+		throw;
+	}
+
+	// Every other upload reads from client memory.
+	gl.bindBuffer(BUFFER_PIXEL_UNPACK, 0);
+}
+
 bool Image::loadVolatile()
 {
 	if (texture != 0)
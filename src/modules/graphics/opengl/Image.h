@@ -59,6 +59,7 @@ class Image final : public love::graphics::Image, public Volatile
 private:
 
 	void uploadByteData(PixelFormat pixelformat, const void *data, size_t size, int level, int slice, const Rect &r) override;
+	void uploadBufferData(love::graphics::StreamBuffer *source, size_t offset, size_t size, int level, int slice, const Rect &r) override;
 	void generateMipmaps() override;
 
 	void loadDefaultTexture();
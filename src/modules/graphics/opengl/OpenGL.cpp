@@ -97,6 +97,10 @@ OpenGL::OpenGL()
 	, contextInitialized(false)
 	, pixelShaderHighpSupported(false)
 	, baseVertexSupported(false)
+	, vertexArrayObjectSupported(false)
+	, pixelBufferSupported(false)
+	, timerQuerySupported(false)
+	, currentVertexArray(nullptr)
 	, maxAnisotropy(1.0f)
 	, max2DTextureSize(0)
 	, max3DTextureSize(0)
@@ -251,7 +255,8 @@ void OpenGL::setupContext()
 	for (int i = 0; i < (int) BUFFER_MAX_ENUM; i++)
 	{
 		state.boundBuffers[i] = 0;
-		glBindBuffer(getGLBufferType((BufferType) i), 0);
+		if (i != BUFFER_PIXEL_UNPACK || pixelBufferSupported)
+			glBindBuffer(getGLBufferType((BufferType) i), 0);
 	}
 
 	// Initialize multiple texture unit support for shaders.
@@ -296,6 +301,8 @@ void OpenGL::deInitContext()
 	if (!contextInitialized)
 		return;
 
+	clearVertexArrays();
+
 	for (int i = 0; i < TEXTURE_MAX_ENUM; i++)
 	{
 		if (state.defaultTexture[i] != 0)
@@ -456,6 +463,19 @@ void OpenGL::initOpenGLFunctions()
 
 		}
 	}
+
+	if (!GLAD_VERSION_3_3 && !GLAD_ARB_timer_query && GLAD_EXT_disjoint_timer_query)
+	{
+		if (!GLAD_ES_VERSION_3_0)
+		{
+			fp_glGenQueries = fp_glGenQueriesEXT;
+			fp_glDeleteQueries = fp_glDeleteQueriesEXT;
+			fp_glGetQueryObjectuiv = fp_glGetQueryObjectuivEXT;
+		}
+
+		fp_glQueryCounter = fp_glQueryCounterEXT;
+		fp_glGetQueryObjectui64v = fp_glGetQueryObjectui64vEXT;
+	}
 }
 
 void OpenGL::initMaxValues()
@@ -473,6 +493,21 @@ void OpenGL::initMaxValues()
 	baseVertexSupported = GLAD_VERSION_3_2 || GLAD_ES_VERSION_3_2 || GLAD_ARB_draw_elements_base_vertex
 		|| GLAD_OES_draw_elements_base_vertex || GLAD_EXT_draw_elements_base_vertex;
 
+	// OpenGL ES 2 (and its OES_vertex_array_object) uses the uncached path.
+	vertexArrayObjectSupported = GLAD_VERSION_3_0 || GLAD_ARB_vertex_array_object || GLAD_ES_VERSION_3_0;
+
+	pixelBufferSupported = GLAD_VERSION_2_1 || GLAD_ARB_pixel_buffer_object || GLAD_ES_VERSION_3_0;
+
+	timerQuerySupported = GLAD_VERSION_3_3 || GLAD_ARB_timer_query;
+
+	// Some GLES drivers expose the extension with elapsed-time queries only.
+	if (!timerQuerySupported && GLAD_EXT_disjoint_timer_query)
+	{
+		GLint bits = 0;
+		fp_glGetQueryivEXT(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &bits);
+		timerQuerySupported = bits > 0;
+	}
+
 	// We'll need this value to clamp anisotropy.
 	if (GLAD_EXT_texture_filter_anisotropic)
 		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
@@ -626,6 +661,8 @@ GLenum OpenGL::getGLBufferType(BufferType type)
 		return GL_ARRAY_BUFFER;
 	case BUFFER_INDEX:
 		return GL_ELEMENT_ARRAY_BUFFER;
+	case BUFFER_PIXEL_UNPACK:
+		return GL_PIXEL_UNPACK_BUFFER;
 	case BUFFER_MAX_ENUM:
 		return GL_ZERO;
 	}
@@ -708,6 +745,9 @@ void OpenGL::bindBuffer(BufferType type, GLuint buffer)
 	{
 		glBindBuffer(getGLBufferType(type), buffer);
 		state.boundBuffers[type] = buffer;
+
+		if (type == BUFFER_INDEX && currentVertexArray != nullptr)
+			currentVertexArray->indexBuffer = buffer;
 	}
 }
 
@@ -720,9 +760,193 @@ void OpenGL::deleteBuffer(GLuint buffer)
 		if (state.boundBuffers[i] == buffer)
 			state.boundBuffers[i] = 0;
 	}
+
+	// VAOs which aren't bound keep deleted buffers alive, and the buffer's
+	// name may be reused by a new buffer. Evict every VAO which uses it.
+	for (auto it = vertexArrays.begin(); it != vertexArrays.end(); )
+	{
+		VertexArray &va = it->second;
+
+		bool usesbuffer = false;
+		for (size_t i = 0; i < va.key.size(); i += 2)
+			usesbuffer = usesbuffer || (GLuint) (va.key[i] >> 32) == buffer;
+
+		if (usesbuffer)
+		{
+			if (&va == currentVertexArray)
+			{
+				currentVertexArray = nullptr;
+				state.boundBuffers[BUFFER_INDEX] = std::numeric_limits<GLuint>::max();
+			}
+
+			glDeleteVertexArrays(1, &va.vao);
+			it = vertexArrays.erase(it);
+			continue;
+		}
+
+		// Force the next bindBuffer call to rebind the index buffer.
+		if (va.indexBuffer == buffer)
+			va.indexBuffer = std::numeric_limits<GLuint>::max();
+
+		++it;
+	}
 }
 
 void OpenGL::setVertexAttributes(const vertex::Attributes &attributes, const vertex::BufferBindings &buffers)
+{
+	uint32 enablediff = attributes.enableBits ^ state.enabledAttribArrays;
+
+	if (vertexArrayObjectSupported)
+		setVertexArray(attributes, buffers);
+	else
+		setVertexAttribArrays(attributes, buffers);
+
+	state.enabledAttribArrays = attributes.enableBits;
+
+	// glDisableVertexAttribArray will make the constant value for a vertex
+	// attribute undefined. We rely on the per-vertex color attribute being
+	// white when no per-vertex color is used, so we set it here.
+	// FIXME: Is there a better place to do this?
+	if ((enablediff & ATTRIBFLAG_COLOR) && !(attributes.enableBits & ATTRIBFLAG_COLOR))
+		glVertexAttrib4f(ATTRIB_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+void OpenGL::setVertexArray(const vertex::Attributes &attributes, const vertex::BufferBindings &buffers)
+{
+	// Each enabled attribute adds two words to the key: its buffer's handle,
+	// stride and offset within a vertex, and then its index, format and step.
+	// Buffer offsets aren't part of the key so stream buffers, whose offsets
+	// change every draw, don't create a new VAO each time.
+	vertexArrayKey.clear();
+	uint32 bufferbits = 0;
+
+	for (uint32 i = 0, allbits = attributes.enableBits; allbits != 0; i++, allbits >>= 1)
+	{
+		if ((allbits & 1) == 0)
+			continue;
+
+		const auto &attrib = attributes.attribs[i];
+		const auto &layout = attributes.bufferLayouts[attrib.bufferIndex];
+
+		uint32 bufferbit = 1u << attrib.bufferIndex;
+		uint64 handle = (uint64) (GLuint) buffers.info[attrib.bufferIndex].buffer->getHandle();
+		uint64 divisor = (attributes.instanceBits & bufferbit) != 0 ? 1 : 0;
+
+		vertexArrayKey.push_back((handle << 32) | ((uint64) layout.stride << 16) | (uint64) attrib.offsetFromVertex);
+		vertexArrayKey.push_back((uint64) i | ((uint64) attrib.type << 5) | ((uint64) attrib.components << 9) | (divisor << 13));
+
+		bufferbits |= bufferbit;
+	}
+
+	VertexArray *va = currentVertexArray;
+
+	if (va == nullptr || va->key != vertexArrayKey)
+	{
+		uint64 hash = 0;
+		for (uint64 word : vertexArrayKey)
+			hash ^= word + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+
+		auto it = vertexArrays.find(hash);
+
+		// Hash collisions are handled by replacing the old VAO.
+		if (it != vertexArrays.end() && it->second.key != vertexArrayKey)
+		{
+			if (&it->second == currentVertexArray)
+				currentVertexArray = nullptr;
+
+			glDeleteVertexArrays(1, &it->second.vao);
+			vertexArrays.erase(it);
+			it = vertexArrays.end();
+		}
+
+		if (it == vertexArrays.end())
+		{
+			if (vertexArrays.size() >= MAX_VERTEX_ARRAYS)
+				clearVertexArrays();
+
+			va = &vertexArrays[hash];
+			va->key = vertexArrayKey;
+			va->bufferBits = bufferbits;
+			va->indexBuffer = 0;
+
+			for (size_t &offset : va->bufferOffsets)
+				offset = std::numeric_limits<size_t>::max();
+
+			glGenVertexArrays(1, &va->vao);
+			glBindVertexArray(va->vao);
+
+			for (uint32 i = 0, allbits = attributes.enableBits; allbits != 0; i++, allbits >>= 1)
+			{
+				if ((allbits & 1) == 0)
+					continue;
+
+				glEnableVertexAttribArray(i);
+
+				if ((attributes.instanceBits & (1u << attributes.attribs[i].bufferIndex)) != 0)
+					glVertexAttribDivisor(i, 1);
+			}
+		}
+		else
+		{
+			va = &it->second;
+			glBindVertexArray(va->vao);
+		}
+
+		currentVertexArray = va;
+		state.boundBuffers[BUFFER_INDEX] = va->indexBuffer;
+	}
+
+	uint32 changedbuffers = 0;
+
+	for (uint32 i = 0, allbits = bufferbits; allbits != 0; i++, allbits >>= 1)
+	{
+		if ((allbits & 1) != 0 && va->bufferOffsets[i] != buffers.info[i].offset)
+		{
+			va->bufferOffsets[i] = buffers.info[i].offset;
+			changedbuffers |= 1u << i;
+		}
+	}
+
+	if (changedbuffers == 0)
+		return;
+
+	for (uint32 i = 0, allbits = attributes.enableBits; allbits != 0; i++, allbits >>= 1)
+	{
+		if ((allbits & 1) != 0 && (changedbuffers & (1u << attributes.attribs[i].bufferIndex)) != 0)
+			setVertexAttribPointer(i, attributes, buffers);
+	}
+}
+
+void OpenGL::setVertexAttribPointer(uint32 index, const vertex::Attributes &attributes, const vertex::BufferBindings &buffers)
+{
+	const auto &attrib = attributes.attribs[index];
+	const auto &layout = attributes.bufferLayouts[attrib.bufferIndex];
+	const auto &bufferinfo = buffers.info[attrib.bufferIndex];
+
+	GLboolean normalized = GL_FALSE;
+	GLenum gltype = getGLVertexDataType(attrib.type, normalized);
+
+	const void *offsetpointer = reinterpret_cast<void*>(bufferinfo.offset + attrib.offsetFromVertex);
+
+	bindBuffer(BUFFER_VERTEX, (GLuint) bufferinfo.buffer->getHandle());
+	glVertexAttribPointer(index, attrib.components, gltype, normalized, layout.stride, offsetpointer);
+}
+
+void OpenGL::clearVertexArrays()
+{
+	for (auto &va : vertexArrays)
+		glDeleteVertexArrays(1, &va.second.vao);
+
+	vertexArrays.clear();
+
+	if (currentVertexArray != nullptr)
+	{
+		currentVertexArray = nullptr;
+		state.boundBuffers[BUFFER_INDEX] = std::numeric_limits<GLuint>::max();
+	}
+}
+
+void OpenGL::setVertexAttribArrays(const vertex::Attributes &attributes, const vertex::BufferBindings &buffers)
 {
 	uint32 enablediff = attributes.enableBits ^ state.enabledAttribArrays;
 	uint32 instanceattribbits = 0;
@@ -744,8 +968,6 @@ void OpenGL::setVertexAttributes(const vertex::Attributes &attributes, const ver
 		if (attributes.enableBits & bit)
 		{
 			const auto &attrib = attributes.attribs[i];
-			const auto &layout = attributes.bufferLayouts[attrib.bufferIndex];
-			const auto &bufferinfo = buffers.info[attrib.bufferIndex];
 
 			uint32 bufferbit = 1u << attrib.bufferIndex;
 			uint32 divisor = (attributes.instanceBits & bufferbit) != 0 ? 1 : 0;
@@ -755,28 +977,14 @@ void OpenGL::setVertexAttributes(const vertex::Attributes &attributes, const ver
 			if ((state.instancedAttribArrays & bit) ^ divisorbit)
 				glVertexAttribDivisor(i, divisor);
 
-			GLboolean normalized = GL_FALSE;
-			GLenum gltype = getGLVertexDataType(attrib.type, normalized);
-
-			const void *offsetpointer = reinterpret_cast<void*>(bufferinfo.offset + attrib.offsetFromVertex);
-
-			bindBuffer(BUFFER_VERTEX, (GLuint) bufferinfo.buffer->getHandle());
-			glVertexAttribPointer(i, attrib.components, gltype, normalized, layout.stride, offsetpointer);
+			setVertexAttribPointer(i, attributes, buffers);
 		}
 
 		i++;
 		allbits >>= 1;
 	}
 
-	state.enabledAttribArrays = attributes.enableBits;
 	state.instancedAttribArrays = instanceattribbits | (state.instancedAttribArrays & (~attributes.enableBits));
-
-	// glDisableVertexAttribArray will make the constant value for a vertex
-	// attribute undefined. We rely on the per-vertex color attribute being
-	// white when no per-vertex color is used, so we set it here.
-	// FIXME: Is there a better place to do this?
-	if ((enablediff & ATTRIBFLAG_COLOR) && !(attributes.enableBits & ATTRIBFLAG_COLOR))
-		glVertexAttrib4f(ATTRIB_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
 }
 
 void OpenGL::setCullMode(CullMode mode)
@@ -1285,6 +1493,16 @@ bool OpenGL::isBaseVertexSupported() const
 	return baseVertexSupported;
 }
 
+bool OpenGL::isPixelBufferSupported() const
+{
+	return pixelBufferSupported;
+}
+
+bool OpenGL::isTimerQuerySupported() const
+{
+	return timerQuerySupported;
+}
+
 int OpenGL::getMax2DTextureSize() const
 {
 	return std::max(max2DTextureSize, 1);
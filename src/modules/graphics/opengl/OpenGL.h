@@ -37,6 +37,7 @@
 // C++
 #include <vector>
 #include <stack>
+#include <unordered_map>
 
 // The last argument to AttribPointer takes a buffer offset casted to a pointer.
 #define BUFFER_OFFSET(i) ((char *) NULL + (i))
@@ -237,9 +238,9 @@ class OpenGL
 	void prepareDraw();
 
 	/**
-	 * State-tracked glBindBuffer.
-	 * NOTE: This does not account for multiple VAOs being used! Index buffer
-	 * bindings are per-VAO in OpenGL, but this doesn't know about that.
+	 * State-tracked glBindBuffer. Index buffer bindings are per-VAO in OpenGL,
+	 * so they're tracked per cached VAO. The index buffer should be bound
+	 * after setVertexAttributes, which may switch VAOs.
 	 **/
 	void bindBuffer(BufferType type, GLuint buffer);
 
@@ -249,7 +250,10 @@ class OpenGL
 	void deleteBuffer(GLuint buffer);
 
 	/**
-	 * Set all vertex attribute state.
+	 * Set all vertex attribute state. When VAOs are supported, a VAO matching
+	 * the attributes and buffers is fetched from (or added to) a cache and
+	 * bound, and only the attribute pointers of buffers whose offsets changed
+	 * since the VAO's last use are re-specified.
 	 **/
 	void setVertexAttributes(const vertex::Attributes &attributes, const vertex::BufferBindings &buffers);
 
@@ -375,6 +379,8 @@ class OpenGL
 	bool isDepthCompareSampleSupported() const;
 	bool isSamplerLODBiasSupported() const;
 	bool isBaseVertexSupported() const;
+	bool isPixelBufferSupported() const;
+	bool isTimerQuerySupported() const;
 
 	/**
 	 * Returns the maximum supported width or height of a texture.
@@ -446,15 +452,44 @@ class OpenGL
 
 private:
 
+	struct VertexArray
+	{
+		GLuint vao;
+
+		// Packed attribute formats and buffer handles, see setVertexArray.
+		std::vector<uint64> key;
+
+		// The buffer offsets the attribute pointers were last specified with.
+		uint32 bufferBits;
+		size_t bufferOffsets[vertex::BufferBindings::MAX];
+
+		GLuint indexBuffer;
+	};
+
+	// Upper limit on the number of cached VAOs before the cache is flushed.
+	static const size_t MAX_VERTEX_ARRAYS = 1024;
+
 	void initVendor();
 	void initOpenGLFunctions();
 	void initMaxValues();
 	void createDefaultTexture();
 
+	void setVertexArray(const vertex::Attributes &attributes, const vertex::BufferBindings &buffers);
+	void setVertexAttribArrays(const vertex::Attributes &attributes, const vertex::BufferBindings &buffers);
+	void setVertexAttribPointer(uint32 index, const vertex::Attributes &attributes, const vertex::BufferBindings &buffers);
+	void clearVertexArrays();
+
 	bool contextInitialized;
 
 	bool pixelShaderHighpSupported;
 	bool baseVertexSupported;
+	bool vertexArrayObjectSupported;
+	bool pixelBufferSupported;
+	bool timerQuerySupported;
+
+	std::unordered_map<uint64, VertexArray> vertexArrays;
+	VertexArray *currentVertexArray;
+	std::vector<uint64> vertexArrayKey;
 
 	float maxAnisotropy;
 	float maxLODBias;
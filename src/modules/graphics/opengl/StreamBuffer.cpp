@@ -40,6 +40,15 @@ namespace opengl
 // so we add an extra frame to reduce the (small) chance of stalls.
 static const int BUFFER_FRAMES = 4;
 
+// While a pixel unpack buffer is bound, texture uploads from client memory
+// treat their pointer as an offset into the buffer instead, so pixel stream
+// buffers never leave themselves bound.
+static void unbindPixelUnpackBuffer(BufferType mode)
+{
+	if (mode == BUFFER_PIXEL_UNPACK)
+		gl.bindBuffer(BUFFER_PIXEL_UNPACK, 0);
+}
+
 class StreamBufferClientMemory final : public love::graphics::StreamBuffer
 {
 public:
@@ -119,6 +128,7 @@ class StreamBufferSubDataOrphan final : public love::graphics::StreamBuffer, pub
 			frameGPUReadOffset = 0;
 			gl.bindBuffer(mode, vbo);
 			glBufferData(glMode, bufferSize, nullptr, GL_STREAM_DRAW);
+			unbindPixelUnpackBuffer(mode);
 		}
 
 		return MapInfo(data, bufferSize - frameGPUReadOffset);
@@ -128,6 +138,7 @@ class StreamBufferSubDataOrphan final : public love::graphics::StreamBuffer, pub
 	{
 		gl.bindBuffer(mode, vbo);
 		glBufferSubData(glMode, frameGPUReadOffset, usedsize, data);
+		unbindPixelUnpackBuffer(mode);
 		return frameGPUReadOffset;
 	}
 
@@ -153,6 +164,7 @@ class StreamBufferSubDataOrphan final : public love::graphics::StreamBuffer, pub
 		glGenBuffers(1, &vbo);
 		gl.bindBuffer(mode, vbo);
 		glBufferData(glMode, bufferSize, nullptr, GL_STREAM_DRAW);
+		unbindPixelUnpackBuffer(mode);
 
 		frameGPUReadOffset = 0;
 		orphan = false;
@@ -248,6 +260,8 @@ class StreamBufferMapSync final : public StreamBufferSync, public Volatile
 		size_t mapoffset = (frameIndex * bufferSize) + frameGPUReadOffset;
 		info.data = (uint8 *) glMapBufferRange(glMode, mapoffset, info.size, flags);
 
+		unbindPixelUnpackBuffer(mode);
+
 		return info;
 	}
 
@@ -256,6 +270,7 @@ class StreamBufferMapSync final : public StreamBufferSync, public Volatile
 		gl.bindBuffer(mode, vbo);
 		glFlushMappedBufferRange(glMode, 0, usedsize);
 		glUnmapBuffer(glMode);
+		unbindPixelUnpackBuffer(mode);
 
 		return (frameIndex * bufferSize) + frameGPUReadOffset;
 	}
@@ -270,6 +285,7 @@ class StreamBufferMapSync final : public StreamBufferSync, public Volatile
 		glGenBuffers(1, &vbo);
 		gl.bindBuffer(mode, vbo);
 		glBufferData(glMode, bufferSize * BUFFER_FRAMES, nullptr, GL_STREAM_DRAW);
+		unbindPixelUnpackBuffer(mode);
 
 		frameGPUReadOffset = 0;
 		frameIndex = 0;
@@ -336,6 +352,7 @@ class StreamBufferPersistentMapSync final : public StreamBufferSync, public Vola
 		{
 			gl.bindBuffer(mode, vbo);
 			glFlushMappedBufferRange(glMode, offset, usedsize);
+			unbindPixelUnpackBuffer(mode);
 		}
 
 		return offset;
@@ -359,6 +376,7 @@ class StreamBufferPersistentMapSync final : public StreamBufferSync, public Vola
 
 		glBufferStorage(glMode, bufferSize * BUFFER_FRAMES, nullptr, storageflags);
 		data = (uint8 *) glMapBufferRange(glMode, 0, bufferSize * BUFFER_FRAMES, mapflags);
+		unbindPixelUnpackBuffer(mode);
 
 		frameGPUReadOffset = 0;
 		frameIndex = 0;
@@ -493,9 +511,18 @@ class StreamBufferPinnedMemory final : public StreamBufferSync, public Volatile
 
 love::graphics::StreamBuffer *CreateStreamBuffer(BufferType mode, size_t size)
 {
-	if (gl.isCoreProfile())
+	// Texture uploads read directly from client memory without PBOs.
+	if (mode == BUFFER_PIXEL_UNPACK && !gl.isPixelBufferSupported())
+		return new StreamBufferClientMemory(mode, size);
+
+	// Vertex and index data is faster in client memory outside of Core
+	// Profile, but pixel buffers are worth using wherever they exist
+	// (GL 2.1+ and ES 3), whatever the profile.
+	if (gl.isCoreProfile() || mode == BUFFER_PIXEL_UNPACK)
 	{
-		if (!gl.bugs.clientWaitSyncStalls)
+		bool syncsupported = GLAD_VERSION_3_2 || GLAD_ARB_sync || GLAD_ES_VERSION_3_0;
+
+		if (!gl.bugs.clientWaitSyncStalls && syncsupported)
 		{
 			// AMD's pinned memory seems to be faster than persistent mapping,
 			// on AMD GPUs.
@@ -525,7 +552,8 @@ love::graphics::StreamBuffer *CreateStreamBuffer(BufferType mode, size_t size)
 			// is opt-in via an API, and we don't do it, so we can use this
 			// instead of the (potentially slower) SubData approach.
 #ifdef LOVE_MACOSX
-			return new StreamBufferMapSync(mode, size);
+			if (GLAD_VERSION_3_0 || GLAD_ARB_map_buffer_range)
+				return new StreamBufferMapSync(mode, size);
 #endif
 		}
 
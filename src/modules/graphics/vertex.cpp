@@ -20,6 +20,8 @@
 
 #include "vertex.h"
 #include "common/StringMap.h"
+#include "common/Matrix.h"
+#include "common/Vector.h"
 
 namespace love
 {
@@ -36,6 +38,7 @@ static_assert(sizeof(XYf_STPf) == sizeof(float)*2 + sizeof(float)*3, "sizeof(XYf
 static_assert(sizeof(XYf_STf_RGBAub) == sizeof(float)*2 + sizeof(float)*2 + sizeof(Color32), "sizeof(XYf_STf_RGBAub) incorrect!");
 static_assert(sizeof(XYf_STus_RGBAub) == sizeof(float)*2 + sizeof(uint16)*2 + sizeof(Color32), "sizeof(XYf_STus_RGBAub) incorrect!");
 static_assert(sizeof(XYf_STPf_RGBAub) == sizeof(float)*2 + sizeof(float)*3 + sizeof(Color32), "sizeof(XYf_STPf_RGBAub) incorrect!");
+static_assert(sizeof(QuadInstance) == sizeof(float)*6 + sizeof(float)*4 + sizeof(Color32), "sizeof(QuadInstance) incorrect!");
 
 size_t getFormatStride(CommonFormat format)
 {
@@ -226,6 +229,63 @@ void fillIndices(TriangleIndexMode mode, uint32 vertexStart, uint32 vertexCount,
 	fillIndicesT(mode, vertexStart, vertexCount, indices);
 }
 
+// Takes the 2D affine part of a matrix, | a c tx |
+//                                       | b d ty |
+static void setQuadInstance(QuadInstance &instance, float a, float b, float c, float d, float tx, float ty, const Vector2 *positions, const Vector2 *texcoords, Color32 color)
+{
+	// Quad vertices 0 and 3 are opposite corners of an axis-aligned rectangle.
+	float x0 = positions[0].x;
+	float y0 = positions[0].y;
+	float w = positions[3].x - x0;
+	float h = positions[3].y - y0;
+
+	instance.transformX[0] = a * w;
+	instance.transformX[1] = c * h;
+	instance.transformX[2] = a * x0 + c * y0 + tx;
+
+	instance.transformY[0] = b * w;
+	instance.transformY[1] = d * h;
+	instance.transformY[2] = b * x0 + d * y0 + ty;
+
+	instance.s0 = texcoords[0].x;
+	instance.t0 = texcoords[0].y;
+	instance.s1 = texcoords[3].x;
+	instance.t1 = texcoords[3].y;
+
+	instance.color = color;
+}
+
+void setQuadInstance(QuadInstance &instance, const Matrix4 &m, const Vector2 *positions, const Vector2 *texcoords, Color32 color)
+{
+	const float *e = m.getElements();
+	setQuadInstance(instance, e[0], e[1], e[4], e[5], e[12], e[13], positions, texcoords, color);
+}
+
+void setQuadInstance(QuadInstance &instance, const Matrix3 &m, const Vector2 *positions, const Vector2 *texcoords, Color32 color)
+{
+	const float *e = m.getElements();
+	setQuadInstance(instance, e[0], e[1], e[3], e[4], e[6], e[7], positions, texcoords, color);
+}
+
+void getQuadInstanceVertices(const QuadInstance &instance, Vector2 *positions, Vector2 *texcoords)
+{
+	const float *tx = instance.transformX;
+	const float *ty = instance.transformY;
+
+	for (int i = 0; i < 4; i++)
+	{
+		// Same corner order as Quad: (0,0), (0,1), (1,0), (1,1).
+		float u = (float) (i >> 1);
+		float v = (float) (i & 1);
+
+		positions[i].x = tx[0] * u + tx[1] * v + tx[2];
+		positions[i].y = ty[0] * u + ty[1] * v + ty[2];
+
+		texcoords[i].x = u == 0.0f ? instance.s0 : instance.s1;
+		texcoords[i].y = v == 0.0f ? instance.t0 : instance.t1;
+	}
+}
+
 void Attributes::setCommonFormat(CommonFormat format, uint8 bufferindex)
 {
 	setBufferLayout(bufferindex, (uint16) getFormatStride(format));
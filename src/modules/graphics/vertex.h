@@ -31,6 +31,11 @@
 
 namespace love
 {
+
+class Matrix3;
+class Matrix4;
+struct Vector2;
+
 namespace graphics
 {
 
@@ -59,6 +64,7 @@ enum BufferType
 {
 	BUFFER_VERTEX = 0,
 	BUFFER_INDEX,
+	BUFFER_PIXEL_UNPACK,
 	BUFFER_MAX_ENUM
 };
 
@@ -189,6 +195,21 @@ struct XYf_STPf_RGBAub
 	Color32 color;
 };
 
+/**
+ * Per-instance data for drawing textured quads with instancing. Each instance
+ * is a unit quad whose corners (u, v) are mapped to local space via
+ *   x = dot(transformX, (u, v, 1)), y = dot(transformY, (u, v, 1))
+ * so the quad's size, origin and the sprite's full affine transform are all
+ * folded into two rows.
+ **/
+struct QuadInstance
+{
+	float transformX[3];
+	float transformY[3];
+	float s0, t0, s1, t1;
+	Color32 color;
+};
+
 struct BufferBindings
 {
 	static const uint32 MAX = 32;
@@ -306,6 +327,19 @@ int getIndexCount(TriangleIndexMode mode, int vertexCount);
 void fillIndices(TriangleIndexMode mode, uint16 vertexStart, uint16 vertexCount, uint16 *indices);
 void fillIndices(TriangleIndexMode mode, uint32 vertexStart, uint32 vertexCount, uint32 *indices);
 
+/**
+ * Sets up a QuadInstance from a quad's 4 vertex positions and texture
+ * coordinates (in the vertex order used by Quad), transformed by m.
+ **/
+void setQuadInstance(QuadInstance &instance, const Matrix4 &m, const Vector2 *positions, const Vector2 *texcoords, Color32 color);
+void setQuadInstance(QuadInstance &instance, const Matrix3 &m, const Vector2 *positions, const Vector2 *texcoords, Color32 color);
+
+/**
+ * Computes the local-space corner positions and texture coordinates of a
+ * QuadInstance, in the vertex order used by Quad.
+ **/
+void getQuadInstanceVertices(const QuadInstance &instance, Vector2 *positions, Vector2 *texcoords);
+
 bool getConstant(const char *in, BuiltinVertexAttribute &out);
 bool getConstant(BuiltinVertexAttribute in, const char *&out);
 
@@ -1148,16 +1148,18 @@ int w_newSpriteBatch(lua_State *L)
 	Texture *texture = luax_checktexture(L, 1);
 	int size = (int) luaL_optinteger(L, 2, 1000);
 	vertex::Usage usage = vertex::USAGE_DYNAMIC;
-	if (lua_gettop(L) > 2)
+	if (!lua_isnoneornil(L, 3))
 	{
 		const char *usagestr = luaL_checkstring(L, 3);
 		if (!vertex::getConstant(usagestr, usage))
 			return luax_enumerror(L, "usage hint", vertex::getConstants(usage), usagestr);
 	}
 
+	bool instanced = luax_optboolean(L, 4, false);
+
 	SpriteBatch *t = nullptr;
 	luax_catchexcept(L,
-		[&](){ t = instance()->newSpriteBatch(texture, size, usage); }
+		[&](){ t = instance()->newSpriteBatch(texture, size, usage, instanced); }
 	);
 
 	luax_pushtype(L, t);
@@ -1661,6 +1663,21 @@ int w_newText(lua_State *L)
 	return 1;
 }
 
+int w_newLineMesh(lua_State *L)
+{
+	luax_checkgraphicscreated(L);
+
+	std::vector<Vector2> points;
+	luax_checklinepoints(L, 1, points);
+
+	LineMesh *mesh = nullptr;
+	luax_catchexcept(L, [&](){ mesh = instance()->newLineMesh(points); });
+
+	luax_pushtype(L, mesh);
+	mesh->release();
+	return 1;
+}
+
 int w_newVideo(lua_State *L)
 {
 	luax_checkgraphicscreated(L);
@@ -2116,13 +2133,15 @@ int w_setDefaultShaderCode(lua_State *L)
 			lua_getfield(L, -2, "pixel");
 			lua_getfield(L, -3, "videopixel");
 			lua_getfield(L, -4, "arraypixel");
+			lua_getfield(L, -5, "instancedvertex");
 
-			std::string vertex = luax_checkstring(L, -4);
-			std::string pixel = luax_checkstring(L, -3);
-			std::string videopixel = luax_checkstring(L, -2);
-			std::string arraypixel = luax_checkstring(L, -1);
+			std::string vertex = luax_checkstring(L, -5);
+			std::string pixel = luax_checkstring(L, -4);
+			std::string videopixel = luax_checkstring(L, -3);
+			std::string arraypixel = luax_checkstring(L, -2);
+			std::string instancedvertex = luax_checkstring(L, -1);
 
-			lua_pop(L, 5);
+			lua_pop(L, 6);
 
 			Graphics::defaultShaderCode[Shader::STANDARD_DEFAULT][lang][i].source[ShaderStage::STAGE_VERTEX] = vertex;
 			Graphics::defaultShaderCode[Shader::STANDARD_DEFAULT][lang][i].source[ShaderStage::STAGE_PIXEL] = pixel;
@@ -2132,6 +2151,9 @@ int w_setDefaultShaderCode(lua_State *L)
 
 			Graphics::defaultShaderCode[Shader::STANDARD_ARRAY][lang][i].source[ShaderStage::STAGE_VERTEX] = vertex;
 			Graphics::defaultShaderCode[Shader::STANDARD_ARRAY][lang][i].source[ShaderStage::STAGE_PIXEL] = arraypixel;
+
+			Graphics::defaultShaderCode[Shader::STANDARD_INSTANCED_QUADS][lang][i].source[ShaderStage::STAGE_VERTEX] = instancedvertex;
+			Graphics::defaultShaderCode[Shader::STANDARD_INSTANCED_QUADS][lang][i].source[ShaderStage::STAGE_PIXEL] = pixel;
 		}
 	}
 
@@ -2300,7 +2322,7 @@ int w_getStats(lua_State *L)
 	if (lua_istable(L, 1))
 		lua_pushvalue(L, 1);
 	else
-		lua_createtable(L, 0, 7);
+		lua_createtable(L, 0, 10);
 
 	lua_pushinteger(L, stats.drawCalls);
 	lua_setfield(L, -2, "drawcalls");
@@ -2326,6 +2348,74 @@ int w_getStats(lua_State *L)
 	lua_pushinteger(L, stats.textureMemory);
 	lua_setfield(L, -2, "texturememory");
 
+	lua_pushinteger(L, stats.transientAllocations);
+	lua_setfield(L, -2, "transientallocations");
+
+	lua_pushinteger(L, stats.transientMemory);
+	lua_setfield(L, -2, "transientmemory");
+
+	return 1;
+}
+
+int w_setProfilingEnabled(lua_State *L)
+{
+	bool enable = luax_checkboolean(L, 1);
+	luax_catchexcept(L, [&]() { instance()->setProfilingEnabled(enable); });
+	return 0;
+}
+
+int w_isProfilingEnabled(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isProfilingEnabled());
+	return 1;
+}
+
+int w_beginProfileZone(lua_State *L)
+{
+	std::string name = luax_checkstring(L, 1);
+	luax_catchexcept(L, [&]() { instance()->beginProfileZone(name); });
+	return 0;
+}
+
+int w_endProfileZone(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->endProfileZone(); });
+	return 0;
+}
+
+int w_getProfileZones(lua_State *L)
+{
+	const auto &zones = instance()->getProfileZones();
+
+	lua_createtable(L, (int) zones.size(), 0);
+
+	for (int i = 0; i < (int) zones.size(); i++)
+	{
+		const Graphics::ProfileZone &zone = zones[i];
+
+		lua_createtable(L, 0, 5);
+
+		luax_pushstring(L, zone.name);
+		lua_setfield(L, -2, "name");
+
+		lua_pushinteger(L, zone.depth);
+		lua_setfield(L, -2, "depth");
+
+		luax_pushboolean(L, zone.canvasPass);
+		lua_setfield(L, -2, "pass");
+
+		lua_pushnumber(L, zone.cpuTime);
+		lua_setfield(L, -2, "cputime");
+
+		if (zone.gpuTime >= 0.0)
+		{
+			lua_pushnumber(L, zone.gpuTime);
+			lua_setfield(L, -2, "gputime");
+		}
+
+		lua_rawseti(L, -2, i + 1);
+	}
+
 	return 1;
 }
 
@@ -2582,45 +2672,10 @@ int w_points(lua_State *L)
 
 int w_line(lua_State *L)
 {
-	int args = lua_gettop(L);
-	int arg1type = lua_type(L, 1);
-	bool is_table = false;
-
-	if (args == 1 && arg1type == LUA_TTABLE)
-	{
-		args = (int) luax_objlen(L, 1);
-		is_table = true;
-	}
-
-	if (arg1type != LUA_TTABLE && arg1type != LUA_TNUMBER)
-		return luax_typerror(L, 1, "table or number");
-	else if (args % 2 != 0)
-		return luaL_error(L, "Number of vertex components must be a multiple of two.");
-	else if (args < 4)
-		return luaL_error(L, "Need at least two vertices to draw a line.");
-
-	int numvertices = args / 2;
+	int numvertices = luax_checklinepointcount(L, 1);
 
 	Vector2 *coords = instance()->getScratchBuffer<Vector2>(numvertices);
-	if (is_table)
-	{
-		for (int i = 0; i < numvertices; ++i)
-		{
-			lua_rawgeti(L, 1, (i * 2) + 1);
-			lua_rawgeti(L, 1, (i * 2) + 2);
-			coords[i].x = luax_checkfloat(L, -2);
-			coords[i].y = luax_checkfloat(L, -1);
-			lua_pop(L, 2);
-		}
-	}
-	else
-	{
-		for (int i = 0; i < numvertices; ++i)
-		{
-			coords[i].x = luax_checkfloat(L, (i * 2) + 1);
-			coords[i].y = luax_checkfloat(L, (i * 2) + 2);
-		}
-	}
+	luax_checklinepoints(L, 1, coords, numvertices);
 
 	luax_catchexcept(L,
 		[&](){ instance()->polyline(coords, numvertices); }
@@ -2905,6 +2960,55 @@ int w_inverseTransformPoint(lua_State *L)
 }
 
 
+// C functions in a struct, necessary for the FFI versions of Graphics
+// functions.
+struct FFI_Graphics
+{
+	// Returns false if the arguments are invalid or drawing failed. The Lua
+	// side then falls back to the regular function to raise the error.
+	bool (*draw)(Proxy *drawablep, Proxy *quadp, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+};
+
+static FFI_Graphics ffifuncs =
+{
+	[](Proxy *drawablep, Proxy *quadp, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky) -> bool // draw
+	{
+		Graphics *graphics = instance();
+		if (graphics == nullptr)
+			return false;
+
+		Drawable *drawable = nullptr;
+		Texture *texture = nullptr;
+		Quad *quad = nullptr;
+
+		if (quadp != nullptr)
+		{
+			texture = luax_ffi_checktype<Texture>(drawablep);
+			quad = luax_ffi_checktype<Quad>(quadp);
+			if (texture == nullptr || quad == nullptr)
+				return false;
+		}
+		else if ((drawable = luax_ffi_checktype<Drawable>(drawablep)) == nullptr)
+			return false;
+
+		// Exceptions can't propagate through LuaJIT's FFI.
+		try
+		{
+			Matrix4 m(x, y, a, sx, sy, ox, oy, kx, ky);
+			if (texture && quad)
+				graphics->draw(texture, quad, m);
+			else
+				graphics->draw(drawable, m);
+		}
+		catch (std::exception &)
+		{
+			return false;
+		}
+
+		return true;
+	},
+};
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -2926,6 +3030,7 @@ static const luaL_Reg functions[] =
 	{ "newShader", w_newShader },
 	{ "newMesh", w_newMesh },
 	{ "newText", w_newText },
+	{ "newLineMesh", w_newLineMesh },
 	{ "_newVideo", w_newVideo },
 
 	{ "validateShader", w_validateShader },
@@ -2978,6 +3083,11 @@ static const luaL_Reg functions[] =
 	{ "getSystemLimits", w_getSystemLimits },
 	{ "getTextureTypes", w_getTextureTypes },
 	{ "getStats", w_getStats },
+	{ "setProfilingEnabled", w_setProfilingEnabled },
+	{ "isProfilingEnabled", w_isProfilingEnabled },
+	{ "beginProfileZone", w_beginProfileZone },
+	{ "endProfileZone", w_endProfileZone },
+	{ "getProfileZones", w_getProfileZones },
 
 	{ "captureScreenshot", w_captureScreenshot },
 
@@ -3052,6 +3162,7 @@ static const lua_CFunction types[] =
 	luaopen_shader,
 	luaopen_mesh,
 	luaopen_text,
+	luaopen_linemesh,
 	luaopen_video,
 	0
 };
@@ -3075,8 +3186,14 @@ extern "C" int luaopen_love_graphics(lua_State *L)
 
 	int n = luax_register_module(L, w);
 
+	// Execute wrap_Graphics.lua, sending the graphics table and ffifuncs
+	// pointer as args.
 	if (luaL_loadbuffer(L, (const char *)graphics_lua, sizeof(graphics_lua), "=[love \"wrap_Graphics.lua\"]") == 0)
-		lua_call(L, 0, 0);
+	{
+		lua_pushvalue(L, -2);
+		luax_pushpointerasstring(L, &ffifuncs);
+		lua_call(L, 2, 0);
+	}
 	else
 		lua_error(L);
 
@@ -22,6 +22,10 @@ misrepresented as being the original software.
 3. This notice may not be removed or altered from any source distribution.
 --]]
 
+local love_graphics, ffifuncspointer_str = ...
+
+local type = type
+
 function love.graphics.newVideo(file, settings)
 	settings = settings == nil and {} or settings
 	if type(settings) ~= "table" then error("bad argument #2 to newVideo (expected table)", 2) end
@@ -47,5 +51,66 @@ function love.graphics.newVideo(file, settings)
 	return video
 end
 
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular functions when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+-- Matches the struct declaration in wrap_Graphics.cpp.
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_Graphics
+{
+	bool (*draw)(Proxy *drawablep, Proxy *quadp, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+} FFI_Graphics;
+]])
+
+local ffifuncs = ffi.cast("FFI_Graphics **", ffifuncspointer_str)[0]
+
+-- The regular function handles Transform and non-number arguments (and raises
+-- the appropriate errors) when the FFI version can't be used.
+local _draw = love_graphics.draw
+
+local function draw(drawable, quad, x, y, r, sx, sy, ox, oy, kx, ky)
+	if x == nil then x = 0 end
+	if y == nil then y = 0 end
+	if r == nil then r = 0 end
+	if sx == nil then sx = 1 end
+	if sy == nil then sy = sx end
+	if ox == nil then ox = 0 end
+	if oy == nil then oy = 0 end
+	if kx == nil then kx = 0 end
+	if ky == nil then ky = 0 end
+
+	if type(x) ~= "number" or type(y) ~= "number" or type(r) ~= "number"
+		or type(sx) ~= "number" or type(sy) ~= "number" or type(ox) ~= "number"
+		or type(oy) ~= "number" or type(kx) ~= "number" or type(ky) ~= "number" then
+		return false
+	end
+
+	return ffifuncs.draw(drawable, quad, x, y, r, sx, sy, ox, oy, kx, ky)
+end
+
+
+-- Overwrite some regular love.graphics functions with FFI implementations.
+
+function love_graphics.draw(drawable, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+	if type(drawable) == "userdata" then
+		local drawn
+		if type(a1) == "userdata" then
+			drawn = draw(drawable, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+		else
+			drawn = draw(drawable, nil, a1, a2, a3, a4, a5, a6, a7, a8, a9)
+		end
+		if drawn then return end
+	end
+	return _draw(drawable, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+end
+
 -- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
 --)luastring"--"
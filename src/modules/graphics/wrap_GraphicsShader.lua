@@ -234,6 +234,18 @@ void main() {
 	setPointSize();
 	love_Position = position(ClipSpaceFromLocal, VertexPosition);
 }]],
+
+	MAIN_CUSTOM = [[
+attribute vec4 ConstantColor;
+
+varying vec4 VaryingTexCoord;
+varying vec4 VaryingColor;
+
+void vertexmain();
+
+void main() {
+	vertexmain();
+}]],
 }
 
 GLSL.PIXEL = {
@@ -463,6 +475,25 @@ void effect() {
 uniform ArrayImage MainTex;
 void effect() {
 	love_PixelColor = Texel(MainTex, VaryingTexCoord.xyz) * VaryingColor;
+}]],
+	-- Used by SpriteBatches and ParticleSystems when instancing is supported.
+	-- VertexPosition is a corner of the unit quad, and everything else comes
+	-- from the per-instance data (see vertex::QuadInstance.) VertexTexCoord
+	-- holds the top-left and bottom-right texture coordinates of the quad.
+	instancedvertex = [[
+attribute vec4 VertexPosition;
+attribute vec4 VertexTexCoord;
+attribute vec4 VertexColor;
+attribute vec3 InstanceTransformX;
+attribute vec3 InstanceTransformY;
+
+void vertexmain() {
+	vec3 corner = vec3(VertexPosition.xy, 1.0);
+	vec4 localpos = vec4(dot(InstanceTransformX, corner), dot(InstanceTransformY, corner), 0.0, 1.0);
+	VaryingTexCoord = vec4(mix(VertexTexCoord.xy, VertexTexCoord.zw, VertexPosition.xy), 0.0, 0.0);
+	VaryingColor = gammaCorrectColor(VertexColor) * ConstantColor;
+	setPointSize();
+	love_Position = ClipSpaceFromLocal * localpos;
 }]],
 }
 
@@ -481,6 +512,7 @@ for lang, info in pairs(langs) do
 		local t = gammacorrect and defaults_gammacorrect or defaults
 		t[lang] = {
 			vertex = createShaderStageCode("VERTEX", defaultcode.vertex, info.target, info.gles, false, gammacorrect),
+			instancedvertex = createShaderStageCode("VERTEX", defaultcode.instancedvertex, info.target, info.gles, false, gammacorrect, true),
 			pixel = createShaderStageCode("PIXEL", defaultcode.pixel, info.target, info.gles, false, gammacorrect, false),
 			videopixel = createShaderStageCode("PIXEL", defaultcode.videopixel, info.target, info.gles, false, gammacorrect, true),
 			arraypixel = createShaderStageCode("PIXEL", defaultcode.arraypixel, info.target, info.gles, false, gammacorrect, true),
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_LineMesh.h"
+
+namespace love
+{
+namespace graphics
+{
+
+LineMesh *luax_checklinemesh(lua_State *L, int idx)
+{
+	return luax_checktype<LineMesh>(L, idx);
+}
+
+void luax_checklinepoints(lua_State *L, int startidx, std::vector<Vector2> &points)
+{
+	int numpoints = luax_checklinepointcount(L, startidx);
+	points.resize(numpoints);
+	luax_checklinepoints(L, startidx, points.data(), numpoints);
+}
+
+int luax_checklinepointcount(lua_State *L, int startidx)
+{
+	int args = lua_gettop(L) - startidx + 1;
+	int argtype = lua_type(L, startidx);
+
+	if (args == 1 && argtype == LUA_TTABLE)
+		args = (int) luax_objlen(L, startidx);
+
+	if (argtype != LUA_TTABLE && argtype != LUA_TNUMBER)
+		luax_typerror(L, startidx, "table or number");
+	else if (args % 2 != 0)
+		luaL_error(L, "Number of vertex components must be a multiple of two.");
+	else if (args < 4)
+		luaL_error(L, "Need at least two vertices to draw a line.");
+
+	return args / 2;
+}
+
+void luax_checklinepoints(lua_State *L, int startidx, Vector2 *points, int numpoints)
+{
+	if (lua_istable(L, startidx))
+	{
+		for (int i = 0; i < numpoints; i++)
+		{
+			lua_rawgeti(L, startidx, (i * 2) + 1);
+			lua_rawgeti(L, startidx, (i * 2) + 2);
+			points[i].x = luax_checkfloat(L, -2);
+			points[i].y = luax_checkfloat(L, -1);
+			lua_pop(L, 2);
+		}
+	}
+	else
+	{
+		for (int i = 0; i < numpoints; i++)
+		{
+			points[i].x = luax_checkfloat(L, startidx + (i * 2));
+			points[i].y = luax_checkfloat(L, startidx + (i * 2) + 1);
+		}
+	}
+}
+
+int w_LineMesh_setPoints(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+
+	std::vector<Vector2> points;
+	luax_checklinepoints(L, 2, points);
+
+	luax_catchexcept(L, [&](){ mesh->setPoints(points); });
+	return 0;
+}
+
+int w_LineMesh_getPoints(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+	const std::vector<Vector2> &points = mesh->getPoints();
+
+	lua_createtable(L, (int) points.size() * 2, 0);
+
+	for (int i = 0; i < (int) points.size(); i++)
+	{
+		lua_pushnumber(L, points[i].x);
+		lua_rawseti(L, -2, (i * 2) + 1);
+		lua_pushnumber(L, points[i].y);
+		lua_rawseti(L, -2, (i * 2) + 2);
+	}
+
+	return 1;
+}
+
+int w_LineMesh_getPointCount(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+	lua_pushinteger(L, (lua_Integer) mesh->getPoints().size());
+	return 1;
+}
+
+int w_LineMesh_setLineWidth(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+	mesh->setLineWidth(luax_checkfloat(L, 2));
+	return 0;
+}
+
+int w_LineMesh_getLineWidth(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+	lua_pushnumber(L, mesh->getLineWidth());
+	return 1;
+}
+
+int w_LineMesh_setLineJoin(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+
+	Graphics::LineJoin join;
+	const char *str = luaL_checkstring(L, 2);
+	if (!Graphics::getConstant(str, join))
+		return luax_enumerror(L, "line join", Graphics::getConstants(join), str);
+
+	mesh->setLineJoin(join);
+	return 0;
+}
+
+int w_LineMesh_getLineJoin(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+
+	const char *str;
+	if (!Graphics::getConstant(mesh->getLineJoin(), str))
+		return luaL_error(L, "Unknown line join");
+
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_LineMesh_setLineStyle(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+
+	Graphics::LineStyle style;
+	const char *str = luaL_checkstring(L, 2);
+	if (!Graphics::getConstant(str, style))
+		return luax_enumerror(L, "line style", Graphics::getConstants(style), str);
+
+	mesh->setLineStyle(style);
+	return 0;
+}
+
+int w_LineMesh_getLineStyle(lua_State *L)
+{
+	LineMesh *mesh = luax_checklinemesh(L, 1);
+
+	const char *str;
+	if (!Graphics::getConstant(mesh->getLineStyle(), str))
+		return luaL_error(L, "Unknown line style");
+
+	lua_pushstring(L, str);
+	return 1;
+}
+
+static const luaL_Reg w_LineMesh_functions[] =
+{
+	{ "setPoints", w_LineMesh_setPoints },
+	{ "getPoints", w_LineMesh_getPoints },
+	{ "getPointCount", w_LineMesh_getPointCount },
+	{ "setLineWidth", w_LineMesh_setLineWidth },
+	{ "getLineWidth", w_LineMesh_getLineWidth },
+	{ "setLineJoin", w_LineMesh_setLineJoin },
+	{ "getLineJoin", w_LineMesh_getLineJoin },
+	{ "setLineStyle", w_LineMesh_setLineStyle },
+	{ "getLineStyle", w_LineMesh_getLineStyle },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_linemesh(lua_State *L)
+{
+	return luax_register_type(L, &LineMesh::type, w_LineMesh_functions, nullptr);
+}
+
+} // graphics
+} // love
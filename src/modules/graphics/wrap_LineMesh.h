@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "LineMesh.h"
+#include "common/runtime.h"
+
+namespace love
+{
+namespace graphics
+{
+
+LineMesh *luax_checklinemesh(lua_State *L, int idx);
+
+/**
+ * Gets a list of points, either from a flat table of coordinates at startidx or
+ * from all numbers from startidx onward.
+ **/
+void luax_checklinepoints(lua_State *L, int startidx, std::vector<Vector2> &points);
+
+/**
+ * Same as above, but in two steps so the caller can provide the memory. The
+ * count must come from luax_checklinepointcount with the same startidx.
+ **/
+int luax_checklinepointcount(lua_State *L, int startidx);
+void luax_checklinepoints(lua_State *L, int startidx, Vector2 *points, int count);
+
+extern "C" int luaopen_linemesh(lua_State *L);
+
+} // graphics
+} // love
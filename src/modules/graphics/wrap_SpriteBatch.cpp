@@ -24,6 +24,11 @@
 #include "Canvas.h"
 #include "wrap_Texture.h"
 
+// Put the Lua code directly into a raw string literal.
+static const char spritebatch_lua[] =
+#include "wrap_SpriteBatch.lua"
+;
+
 namespace love
 {
 namespace graphics
@@ -273,6 +278,47 @@ int w_SpriteBatch_getDrawRange(lua_State *L)
 	return 2;
 }
 
+int w_SpriteBatch_isInstanced(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	luax_pushboolean(L, t->isInstanced());
+	return 1;
+}
+
+// C functions in a struct, necessary for the FFI versions of SpriteBatch
+// functions.
+struct FFI_SpriteBatch
+{
+	// Returns the sprite's index, or -1 if it couldn't be added. The Lua side
+	// then falls back to the regular method to raise the error.
+	int (*add)(Proxy *p, Proxy *quadp, int index, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+};
+
+static FFI_SpriteBatch ffifuncs =
+{
+	[](Proxy *p, Proxy *quadp, int index, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky) -> int // add
+	{
+		SpriteBatch *t = luax_ffi_checktype<SpriteBatch>(p);
+		if (t == nullptr)
+			return -1;
+
+		Quad *quad = nullptr;
+		if (quadp != nullptr && (quad = luax_ffi_checktype<Quad>(quadp)) == nullptr)
+			return -1;
+
+		// Exceptions can't propagate through LuaJIT's FFI.
+		try
+		{
+			Matrix4 m(x, y, a, sx, sy, ox, oy, kx, ky);
+			return quad != nullptr ? t->add(quad, m, index) : t->add(m, index);
+		}
+		catch (std::exception &)
+		{
+			return -1;
+		}
+	},
+};
+
 static const luaL_Reg w_SpriteBatch_functions[] =
 {
 	{ "add", w_SpriteBatch_add },
@@ -290,12 +336,17 @@ static const luaL_Reg w_SpriteBatch_functions[] =
 	{ "attachAttribute", w_SpriteBatch_attachAttribute },
 	{ "setDrawRange", w_SpriteBatch_setDrawRange },
 	{ "getDrawRange", w_SpriteBatch_getDrawRange },
+	{ "isInstanced", w_SpriteBatch_isInstanced },
 	{ 0, 0 }
 };
 
 extern "C" int luaopen_spritebatch(lua_State *L)
 {
-	return luax_register_type(L, &SpriteBatch::type, w_SpriteBatch_functions, nullptr);
+	int n = luax_register_type(L, &SpriteBatch::type, w_SpriteBatch_functions, nullptr);
+
+	luax_runwrapper(L, spritebatch_lua, sizeof(spritebatch_lua), "SpriteBatch.lua", SpriteBatch::type, &ffifuncs);
+
+	return n;
 }
 
 } // graphics
@@ -0,0 +1,111 @@
+R"luastring"--(
+-- DO NOT REMOVE THE ABOVE LINE. It is used to load this file as a C++ string.
+-- There is a matching delimiter at the bottom of the file.
+
+--[[
+Copyright (c) 2006-2023 LOVE Development Team
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+claim that you wrote the original software. If you use this software
+in a product, an acknowledgment in the product documentation would be
+appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+--]]
+
+
+local SpriteBatch_mt, ffifuncspointer_str = ...
+local SpriteBatch = SpriteBatch_mt.__index
+
+local type = type
+
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+-- Matches the struct declaration in wrap_SpriteBatch.cpp.
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_SpriteBatch
+{
+	int (*add)(Proxy *p, Proxy *quadp, int index, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+} FFI_SpriteBatch;
+]])
+
+local ffifuncs = ffi.cast("FFI_SpriteBatch **", ffifuncspointer_str)[0]
+
+-- The regular methods handle Transform and non-number arguments (and raise the
+-- appropriate errors) when the FFI versions can't be used.
+local _add = SpriteBatch.add
+local _set = SpriteBatch.set
+
+-- Returns the 0-based index of the sprite, or -1 if the FFI can't be used.
+local function add(self, quad, index, x, y, r, sx, sy, ox, oy, kx, ky)
+	if x == nil then x = 0 end
+	if y == nil then y = 0 end
+	if r == nil then r = 0 end
+	if sx == nil then sx = 1 end
+	if sy == nil then sy = sx end
+	if ox == nil then ox = 0 end
+	if oy == nil then oy = 0 end
+	if kx == nil then kx = 0 end
+	if ky == nil then ky = 0 end
+
+	if type(x) ~= "number" or type(y) ~= "number" or type(r) ~= "number"
+		or type(sx) ~= "number" or type(sy) ~= "number" or type(ox) ~= "number"
+		or type(oy) ~= "number" or type(kx) ~= "number" or type(ky) ~= "number" then
+		return -1
+	end
+
+	return ffifuncs.add(self, quad, index, x, y, r, sx, sy, ox, oy, kx, ky)
+end
+
+
+-- Overwrite some regular SpriteBatch methods with FFI implementations.
+
+function SpriteBatch:add(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+	local index
+	if type(a1) == "userdata" then
+		index = add(self, a1, -1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+	else
+		index = add(self, nil, -1, a1, a2, a3, a4, a5, a6, a7, a8, a9)
+	end
+
+	if index >= 0 then
+		return index + 1
+	end
+	return _add(self, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+end
+
+function SpriteBatch:set(i, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+	local index = -1
+	if type(i) == "number" then
+		if type(a1) == "userdata" then
+			index = add(self, a1, i - 1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+		else
+			index = add(self, nil, i - 1, a1, a2, a3, a4, a5, a6, a7, a8, a9)
+		end
+	end
+
+	if index < 0 then
+		_set(self, i, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+	end
+end
+
+-- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
+--)luastring"--"
@@ -43,6 +43,7 @@ class FormatHandler : public love::Object
 	{
 		ENCODED_TGA,
 		ENCODED_PNG,
+		ENCODED_TILED,
 		ENCODED_MAX_ENUM
 	};
 
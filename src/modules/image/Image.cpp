@@ -31,6 +31,7 @@
 #include "magpie/KTXHandler.h"
 #include "magpie/PKMHandler.h"
 #include "magpie/ASTCHandler.h"
+#include "magpie/TiledHandler.h"
 
 namespace love
 {
@@ -54,6 +55,7 @@ Image::Image()
 		new KTXHandler,
 		new PKMHandler,
 		new ASTCHandler,
+		new TiledHandler,
 	};
 }
 
@@ -75,6 +77,46 @@ love::image::ImageData *Image::newImageData(Data *data)
 	return new ImageData(data);
 }
 
+class DecodeJob : public thread::Job
+{
+public:
+
+	DecodeJob(Image *image, Data *data)
+		: image(image)
+		, data(data)
+	{
+	}
+
+	void run() override
+	{
+		StrongRef<ImageData> imagedata(image->newImageData(data), Acquire::NORETAIN);
+		result = Variant(&ImageData::type, imagedata.get());
+	}
+
+private:
+
+	StrongRef<Image> image;
+	StrongRef<Data> data;
+
+}; // DecodeJob
+
+thread::Job *Image::newImageDataAsync(Data *data)
+{
+	thread::Job *job = new DecodeJob(this, data);
+
+	try
+	{
+		thread::JobSystem::getInstance()->schedule(job);
+	}
+	catch (love::Exception &)
+	{
+		job->release();
+		throw;
+	}
+
+	return job;
+}
+
 love::image::ImageData *Image::newImageData(int width, int height, PixelFormat format)
 {
 	return new ImageData(width, height, format);
@@ -101,6 +143,16 @@ bool Image::isCompressed(Data *data)
 	return false;
 }
 
+love::image::ImageSource *Image::newImageSource(love::filesystem::File *file, int cachetiles)
+{
+	return new ImageSource(file, cachetiles);
+}
+
+love::image::ImageSource *Image::newImageSource(Data *data, int cachetiles)
+{
+	return new ImageSource(data, cachetiles);
+}
+
 const std::list<FormatHandler *> &Image::getFormatHandlers() const
 {
 	return formatHandlers;
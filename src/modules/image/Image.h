@@ -27,6 +27,8 @@
 #include "filesystem/File.h"
 #include "ImageData.h"
 #include "CompressedImageData.h"
+#include "ImageSource.h"
+#include "thread/JobSystem.h"
 
 // C++
 #include <list>
@@ -63,6 +65,14 @@ class Image : public Module
 	 **/
 	ImageData *newImageData(Data *data);
 
+	/**
+	 * Decodes FileData into new ImageData on the JobSystem. The Job's result
+	 * is the ImageData.
+	 * @param data The FileData containing the encoded image data.
+	 * @return The scheduled Job, which the caller must release.
+	 **/
+	thread::Job *newImageDataAsync(Data *data);
+
 	/**
 	 * Creates empty ImageData with the given size.
 	 * @param width The width of the ImageData.
@@ -95,6 +105,16 @@ class Image : public Module
 	 **/
 	bool isCompressed(Data *data);
 
+	/**
+	 * Creates a new ImageSource, which decodes regions of a large image on
+	 * demand.
+	 * @param file An open File containing the encoded image.
+	 * @param cachetiles The number of decoded tiles to keep cached.
+	 * @return The new ImageSource.
+	 **/
+	ImageSource *newImageSource(love::filesystem::File *file, int cachetiles);
+	ImageSource *newImageSource(Data *data, int cachetiles);
+
 	std::vector<StrongRef<ImageData>> newCubeFaces(ImageData *src);
 	std::vector<StrongRef<ImageData>> newVolumeLayers(ImageData *src);
 
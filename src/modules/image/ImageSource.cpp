@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ImageSource.h"
+
+// C++
+#include <algorithm>
+
+// C
+#include <cstring>
+
+namespace love
+{
+namespace image
+{
+
+using magpie::TiledHandler;
+
+love::Type ImageSource::type("ImageSource", &Object::type);
+
+ImageSource::ImageSource(filesystem::File *file, int cachetiles)
+	: cacheLimit(std::max(cachetiles, 0))
+{
+	unsigned char fixedheader[TiledHandler::FIXED_HEADER_SIZE];
+
+	int64 filesize = file->getSize();
+	int64 headersize = 0;
+
+	if (file->seek(0))
+		headersize = file->read(fixedheader, sizeof(fixedheader));
+
+	if (filesize > 0 && TiledHandler::isTiledImage(fixedheader, (size_t) std::max(headersize, (int64) 0)))
+	{
+		TiledHandler::Header h = TiledHandler::parseHeader(fixedheader, sizeof(fixedheader));
+
+		// The tile table's size comes from the header, so make sure the file
+		// could actually contain it before allocating anything.
+		if ((uint64) filesize < (uint64) h.size)
+			throw love::Exception("Invalid tiled image tile table.");
+
+		std::vector<unsigned char> table(h.size);
+		memcpy(table.data(), fixedheader, sizeof(fixedheader));
+
+		int64 tablesize = (int64) (h.size - sizeof(fixedheader));
+		if (file->read(table.data() + sizeof(fixedheader), tablesize) != tablesize)
+			throw love::Exception("Could not read tiled image tile table.");
+
+		initTiled(table.data(), table.size(), (uint64) filesize);
+		this->file.set(file);
+	}
+	else
+	{
+		// Not a tiled image, so decode the whole thing with the regular
+		// ImageData path and stop referencing the file.
+		if (!file->seek(0))
+			throw love::Exception("Could not read image file.");
+
+		StrongRef<Data> filedata(file->read(), Acquire::NORETAIN);
+		fullImage.set(new ImageData(filedata), Acquire::NORETAIN);
+	}
+}
+
+ImageSource::ImageSource(Data *data, int cachetiles)
+	: cacheLimit(std::max(cachetiles, 0))
+{
+	if (TiledHandler::isTiledImage(data->getData(), data->getSize()))
+	{
+		initTiled(data->getData(), data->getSize(), data->getSize());
+		this->data.set(data);
+	}
+	else
+		fullImage.set(new ImageData(data), Acquire::NORETAIN);
+}
+
+ImageSource::~ImageSource()
+{
+}
+
+void ImageSource::initTiled(const void *headerdata, size_t size, uint64 filesize)
+{
+	header = TiledHandler::parseHeader(headerdata, size);
+
+	if (size < header.size)
+		throw love::Exception("Invalid tiled image tile table.");
+
+	const unsigned char *table = (const unsigned char *) headerdata + TiledHandler::FIXED_HEADER_SIZE;
+	offsets = TiledHandler::parseOffsets(header, table, filesize);
+
+	if (!ImageData::validPixelFormat(header.format))
+		throw love::Exception("Unsupported pixel format for ImageData");
+}
+
+int ImageSource::getWidth() const
+{
+	return fullImage.get() ? fullImage->getWidth() : header.width;
+}
+
+int ImageSource::getHeight() const
+{
+	return fullImage.get() ? fullImage->getHeight() : header.height;
+}
+
+PixelFormat ImageSource::getFormat() const
+{
+	return fullImage.get() ? fullImage->getFormat() : header.format;
+}
+
+bool ImageSource::isTiled() const
+{
+	return fullImage.get() == nullptr;
+}
+
+int ImageSource::getTileSize() const
+{
+	return isTiled() ? header.tileSize : 0;
+}
+
+void ImageSource::setCacheLimit(int tiles)
+{
+	thread::Lock lock(mutex);
+	cacheLimit = std::max(tiles, 0);
+	trimCache();
+}
+
+int ImageSource::getCacheLimit() const
+{
+	return cacheLimit;
+}
+
+const ImageSource::CachedTile &ImageSource::getTile(int tx, int ty)
+{
+	size_t index = (size_t) ty * header.tilesX + tx;
+
+	auto it = tileCache.find(index);
+	if (it != tileCache.end())
+	{
+		lru.splice(lru.begin(), lru, it->second.lruPosition);
+		return it->second;
+	}
+
+	uint64 offset = offsets[index];
+	size_t compressedsize = (size_t) (offsets[index + 1] - offset);
+	const void *src = nullptr;
+
+	if (data.get())
+		src = (const unsigned char *) data->getData() + offset;
+	else
+	{
+		readBuffer.resize(compressedsize);
+
+		if (!file->seek(offset) || file->read(readBuffer.data(), (int64) compressedsize) != (int64) compressedsize)
+			throw love::Exception("Could not read tile %d,%d from tiled image.", tx, ty);
+
+		src = readBuffer.data();
+	}
+
+	int w = 0;
+	int h = 0;
+	TiledHandler::getTileSize(header, tx, ty, w, h);
+
+	size_t rowsize = (size_t) w * getPixelFormatSize(header.format);
+
+	CachedTile tile;
+	tile.pixels.resize(rowsize * h);
+
+	TiledHandler::decodeTile(header, tx, ty, src, compressedsize, tile.pixels.data(), rowsize);
+
+	lru.push_front(index);
+	tile.lruPosition = lru.begin();
+
+	return tileCache.emplace(index, std::move(tile)).first->second;
+}
+
+void ImageSource::trimCache()
+{
+	while (tileCache.size() > (size_t) cacheLimit)
+	{
+		tileCache.erase(lru.back());
+		lru.pop_back();
+	}
+}
+
+ImageData *ImageSource::getRegion(int x, int y, int w, int h)
+{
+	int width = getWidth();
+	int height = getHeight();
+
+	if (w <= 0 || h <= 0)
+		throw love::Exception("Invalid region size.");
+
+	if (x < 0 || y < 0 || x > width - w || y > height - h)
+		throw love::Exception("The region (%d, %d, %d, %d) is outside of the image's bounds.", x, y, w, h);
+
+	PixelFormat format = getFormat();
+	size_t pixelsize = getPixelFormatSize(format);
+
+	StrongRef<ImageData> region(new ImageData(w, h, format), Acquire::NORETAIN);
+
+	unsigned char *dst = (unsigned char *) region->getData();
+	size_t dststride = (size_t) w * pixelsize;
+
+	if (fullImage.get())
+	{
+		const unsigned char *src = (const unsigned char *) fullImage->getData();
+		size_t srcstride = (size_t) width * pixelsize;
+
+		for (int row = 0; row < h; row++)
+			memcpy(dst + row * dststride, src + (size_t) (y + row) * srcstride + (size_t) x * pixelsize, dststride);
+
+		region->retain();
+		return region;
+	}
+
+	thread::Lock lock(mutex);
+
+	int tilesize = header.tileSize;
+
+	for (int ty = y / tilesize; ty <= (y + h - 1) / tilesize; ty++)
+	{
+		for (int tx = x / tilesize; tx <= (x + w - 1) / tilesize; tx++)
+		{
+			const CachedTile &tile = getTile(tx, ty);
+
+			int tw = 0;
+			int th = 0;
+			TiledHandler::getTileSize(header, tx, ty, tw, th);
+
+			// Intersection of the tile and the region, in image coordinates.
+			int left = std::max(x, tx * tilesize);
+			int top = std::max(y, ty * tilesize);
+			int right = std::min(x + w, tx * tilesize + tw);
+			int bottom = std::min(y + h, ty * tilesize + th);
+
+			size_t tilestride = (size_t) tw * pixelsize;
+			size_t rowsize = (size_t) (right - left) * pixelsize;
+
+			for (int row = top; row < bottom; row++)
+			{
+				const unsigned char *src = tile.pixels.data() + (size_t) (row - ty * tilesize) * tilestride + (size_t) (left - tx * tilesize) * pixelsize;
+				memcpy(dst + (size_t) (row - y) * dststride + (size_t) (left - x) * pixelsize, src, rowsize);
+			}
+		}
+	}
+
+	trimCache();
+
+	region->retain();
+	return region;
+}
+
+} // image
+} // love
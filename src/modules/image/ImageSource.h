@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/Data.h"
+#include "common/int.h"
+#include "filesystem/File.h"
+#include "thread/threads.h"
+#include "ImageData.h"
+#include "magpie/TiledHandler.h"
+
+// C++
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * A large image which is decoded lazily, one region at a time. Images in the
+ * tiled container (see ImageData:encode("tiled")) only have the tiles which
+ * overlap a requested region decompressed, and when the source is a File the
+ * tiles are read from disk on demand. Recently used tiles are kept in a small
+ * LRU cache. Any other format is decoded in full when the source is created.
+ **/
+class ImageSource : public Object
+{
+public:
+
+	static love::Type type;
+
+	static const int DEFAULT_CACHE_TILES = 64;
+
+	/**
+	 * The File must be open for reading. It stays open for as long as the
+	 * ImageSource exists.
+	 **/
+	ImageSource(filesystem::File *file, int cachetiles = DEFAULT_CACHE_TILES);
+	ImageSource(Data *data, int cachetiles = DEFAULT_CACHE_TILES);
+	virtual ~ImageSource();
+
+	int getWidth() const;
+	int getHeight() const;
+	PixelFormat getFormat() const;
+
+	bool isTiled() const;
+
+	/**
+	 * Gets the size of the tiles in the source, or 0 if it isn't tiled.
+	 **/
+	int getTileSize() const;
+
+	/**
+	 * Decodes a region of the image into a new ImageData.
+	 **/
+	ImageData *getRegion(int x, int y, int w, int h);
+
+	/**
+	 * Sets the maximum number of decoded tiles to keep around between calls
+	 * to getRegion.
+	 **/
+	void setCacheLimit(int tiles);
+	int getCacheLimit() const;
+
+private:
+
+	struct CachedTile
+	{
+		std::vector<unsigned char> pixels;
+		std::list<size_t>::iterator lruPosition;
+	};
+
+	void initTiled(const void *header, size_t size, uint64 filesize);
+
+	const CachedTile &getTile(int tx, int ty);
+	void trimCache();
+
+	StrongRef<filesystem::File> file;
+	StrongRef<Data> data;
+
+	// Used instead of tiles when the source isn't in the tiled container.
+	StrongRef<ImageData> fullImage;
+
+	magpie::TiledHandler::Header header;
+	std::vector<uint64> offsets;
+
+	// Scratch space for compressed tiles read from the File.
+	std::vector<unsigned char> readBuffer;
+
+	std::unordered_map<size_t, CachedTile> tileCache;
+
+	// Most recently used tiles are at the front.
+	std::list<size_t> lru;
+
+	int cacheLimit;
+
+	love::thread::MutexRef mutex;
+
+}; // ImageSource
+
+} // image
+} // love
@@ -0,0 +1,353 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "TiledHandler.h"
+
+// LOVE
+#include "common/Exception.h"
+#include "data/Compressor.h"
+
+// C++
+#include <algorithm>
+#include <limits>
+
+// C
+#include <cstring>
+
+namespace love
+{
+namespace image
+{
+namespace magpie
+{
+
+// Layout, with all values little-endian:
+//   0  char[4]  magic ("LTIL")
+//   4  uint32   version
+//   8  char[16] pixel format name, zero-padded
+//   24 uint32   width
+//   28 uint32   height
+//   32 uint32   tile size
+//   36 uint32   reserved
+//   40 uint64   tile offsets[tiles + 1], left to right then top to bottom
+//      ...      tiles, each compressed with love.data's "lz4" format
+
+static const char MAGIC[4] = {'L', 'T', 'I', 'L'};
+static const uint32 VERSION = 1;
+static const size_t FORMAT_NAME_SIZE = 16;
+
+static const int MAX_DIMENSION = 1 << 20;
+static const int MAX_TILE_SIZE = 1 << 14;
+
+static void writeLE(unsigned char *dst, uint64 v, int bytes)
+{
+	for (int i = 0; i < bytes; i++)
+		dst[i] = (unsigned char) ((v >> (i * 8)) & 0xFF);
+}
+
+static uint64 readLE(const unsigned char *src, int bytes)
+{
+	uint64 v = 0;
+	for (int i = 0; i < bytes; i++)
+		v |= (uint64) src[i] << (i * 8);
+	return v;
+}
+
+bool TiledHandler::isTiledImage(const void *data, size_t size)
+{
+	return size >= FIXED_HEADER_SIZE && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+TiledHandler::Header TiledHandler::parseHeader(const void *data, size_t size)
+{
+	const unsigned char *bytes = (const unsigned char *) data;
+
+	if (!isTiledImage(data, size))
+		throw love::Exception("Invalid tiled image header.");
+
+	uint32 version = (uint32) readLE(bytes + 4, 4);
+	if (version != VERSION)
+		throw love::Exception("Unsupported tiled image version: %d", (int) version);
+
+	char formatname[FORMAT_NAME_SIZE + 1] = {};
+	memcpy(formatname, bytes + 8, FORMAT_NAME_SIZE);
+
+	Header header;
+
+	if (!getConstant(formatname, header.format) || isPixelFormatCompressed(header.format))
+		throw love::Exception("Unsupported tiled image pixel format: %s", formatname);
+
+	uint64 width = readLE(bytes + 24, 4);
+	uint64 height = readLE(bytes + 28, 4);
+	uint64 tilesize = readLE(bytes + 32, 4);
+
+	if (width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION)
+		throw love::Exception("Invalid tiled image dimensions.");
+
+	if (tilesize == 0 || tilesize > MAX_TILE_SIZE)
+		throw love::Exception("Invalid tiled image tile size.");
+
+	header.width = (int) width;
+	header.height = (int) height;
+	header.tileSize = (int) tilesize;
+	header.tilesX = (header.width + header.tileSize - 1) / header.tileSize;
+	header.tilesY = (header.height + header.tileSize - 1) / header.tileSize;
+
+	uint64 tilecount = (uint64) header.tilesX * (uint64) header.tilesY;
+	uint64 headersize = FIXED_HEADER_SIZE + (tilecount + 1) * sizeof(uint64);
+
+	if (headersize > (uint64) std::numeric_limits<size_t>::max())
+		throw love::Exception("Invalid tiled image tile size.");
+
+	header.size = (size_t) headersize;
+
+	return header;
+}
+
+std::vector<uint64> TiledHandler::parseOffsets(const Header &header, const void *table, uint64 filesize)
+{
+	const unsigned char *bytes = (const unsigned char *) table;
+	size_t count = (size_t) header.tilesX * (size_t) header.tilesY + 1;
+
+	std::vector<uint64> offsets(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		offsets[i] = readLE(bytes + i * sizeof(uint64), 8);
+
+		bool valid = offsets[i] <= filesize;
+		if (i == 0)
+			valid = valid && offsets[i] >= header.size;
+		else
+			valid = valid && offsets[i] >= offsets[i - 1];
+
+		if (!valid)
+			throw love::Exception("Invalid tiled image tile table.");
+	}
+
+	return offsets;
+}
+
+void TiledHandler::getTileSize(const Header &header, int tx, int ty, int &w, int &h)
+{
+	w = std::min(header.tileSize, header.width - tx * header.tileSize);
+	h = std::min(header.tileSize, header.height - ty * header.tileSize);
+}
+
+void TiledHandler::decodeTile(const Header &header, int tx, int ty, const void *src, size_t srcsize, unsigned char *dst, size_t dststride)
+{
+	int w = 0;
+	int h = 0;
+	getTileSize(header, tx, ty, w, h);
+
+	size_t rowsize = (size_t) w * getPixelFormatSize(header.format);
+
+	data::Compressor *compressor = data::Compressor::getCompressor(data::Compressor::FORMAT_LZ4);
+	if (compressor == nullptr)
+		throw love::Exception("Could not decode tiled image: LZ4 is not supported.");
+
+	// Leave the size unknown, so LZ4 checks its bounds while decompressing.
+	size_t rawsize = 0;
+	char *raw = compressor->decompress(data::Compressor::FORMAT_LZ4, (const char *) src, srcsize, rawsize);
+
+	if (rawsize != rowsize * h)
+	{
+		delete[] raw;
+		throw love::Exception("Could not decode tiled image: tile %d,%d has the wrong size.", tx, ty);
+	}
+
+	for (int y = 0; y < h; y++)
+		memcpy(dst + y * dststride, raw + y * rowsize, rowsize);
+
+	delete[] raw;
+}
+
+bool TiledHandler::canDecode(Data *data)
+{
+	return isTiledImage(data->getData(), data->getSize());
+}
+
+bool TiledHandler::canEncode(PixelFormat rawFormat, EncodedFormat encodedFormat)
+{
+	return encodedFormat == ENCODED_TILED && !isPixelFormatCompressed(rawFormat);
+}
+
+FormatHandler::DecodedImage TiledHandler::decode(Data *data)
+{
+	const unsigned char *bytes = (const unsigned char *) data->getData();
+	size_t size = data->getSize();
+
+	Header header = parseHeader(bytes, size);
+
+	if (size < header.size)
+		throw love::Exception("Invalid tiled image tile table.");
+
+	std::vector<uint64> offsets = parseOffsets(header, bytes + FIXED_HEADER_SIZE, size);
+
+	size_t pixelsize = getPixelFormatSize(header.format);
+	size_t stride = (size_t) header.width * pixelsize;
+
+	DecodedImage img;
+	img.format = header.format;
+	img.width = header.width;
+	img.height = header.height;
+	img.size = stride * header.height;
+
+	try
+	{
+		img.data = new unsigned char[img.size];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	try
+	{
+		for (int ty = 0; ty < header.tilesY; ty++)
+		{
+			for (int tx = 0; tx < header.tilesX; tx++)
+			{
+				size_t index = (size_t) ty * header.tilesX + tx;
+				unsigned char *dst = img.data + (size_t) ty * header.tileSize * stride + (size_t) tx * header.tileSize * pixelsize;
+
+				decodeTile(header, tx, ty, bytes + offsets[index], (size_t) (offsets[index + 1] - offsets[index]), dst, stride);
+			}
+		}
+	}
+	catch (love::Exception &)
+	{
+		delete[] img.data;
+		throw;
+	}
+
+	return img;
+}
+
+FormatHandler::EncodedImage TiledHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat)
+{
+	if (!canEncode(img.format, encodedFormat))
+		throw love::Exception("Invalid format.");
+
+	const char *formatname = nullptr;
+	if (!getConstant(img.format, formatname) || strlen(formatname) > FORMAT_NAME_SIZE)
+		throw love::Exception("Invalid format.");
+
+	data::Compressor *compressor = data::Compressor::getCompressor(data::Compressor::FORMAT_LZ4);
+	if (compressor == nullptr)
+		throw love::Exception("Could not encode tiled image: LZ4 is not supported.");
+
+	Header header;
+	header.format = img.format;
+	header.width = img.width;
+	header.height = img.height;
+	header.tileSize = DEFAULT_TILE_SIZE;
+	header.tilesX = (img.width + header.tileSize - 1) / header.tileSize;
+	header.tilesY = (img.height + header.tileSize - 1) / header.tileSize;
+
+	size_t tilecount = (size_t) header.tilesX * header.tilesY;
+	header.size = FIXED_HEADER_SIZE + (tilecount + 1) * sizeof(uint64);
+
+	size_t pixelsize = getPixelFormatSize(img.format);
+	size_t stride = (size_t) img.width * pixelsize;
+
+	std::vector<char *> tiles(tilecount, nullptr);
+	std::vector<size_t> tilesizes(tilecount, 0);
+
+	EncodedImage encimg;
+
+	try
+	{
+		std::vector<unsigned char> tilepixels((size_t) header.tileSize * header.tileSize * pixelsize);
+
+		for (int ty = 0; ty < header.tilesY; ty++)
+		{
+			for (int tx = 0; tx < header.tilesX; tx++)
+			{
+				int w = 0;
+				int h = 0;
+				getTileSize(header, tx, ty, w, h);
+
+				size_t rowsize = (size_t) w * pixelsize;
+				const unsigned char *src = img.data + (size_t) ty * header.tileSize * stride + (size_t) tx * header.tileSize * pixelsize;
+
+				for (int y = 0; y < h; y++)
+					memcpy(&tilepixels[y * rowsize], src + y * stride, rowsize);
+
+				size_t index = (size_t) ty * header.tilesX + tx;
+				tiles[index] = compressor->compress(data::Compressor::FORMAT_LZ4, (const char *) tilepixels.data(), rowsize * h, -1, tilesizes[index]);
+			}
+		}
+
+		encimg.size = header.size;
+		for (size_t size : tilesizes)
+			encimg.size += size;
+
+		encimg.data = new unsigned char[encimg.size];
+	}
+	catch (std::bad_alloc &)
+	{
+		for (char *tile : tiles)
+			delete[] tile;
+		throw love::Exception("Out of memory.");
+	}
+	catch (love::Exception &)
+	{
+		for (char *tile : tiles)
+			delete[] tile;
+		throw;
+	}
+
+	unsigned char *bytes = encimg.data;
+
+	memset(bytes, 0, FIXED_HEADER_SIZE);
+	memcpy(bytes, MAGIC, sizeof(MAGIC));
+	writeLE(bytes + 4, VERSION, 4);
+	memcpy(bytes + 8, formatname, strlen(formatname));
+	writeLE(bytes + 24, (uint64) img.width, 4);
+	writeLE(bytes + 28, (uint64) img.height, 4);
+	writeLE(bytes + 32, (uint64) header.tileSize, 4);
+
+	unsigned char *table = bytes + FIXED_HEADER_SIZE;
+	uint64 offset = header.size;
+
+	for (size_t i = 0; i < tilecount; i++)
+	{
+		writeLE(table + i * sizeof(uint64), offset, 8);
+
+		memcpy(bytes + offset, tiles[i], tilesizes[i]);
+		offset += tilesizes[i];
+
+		delete[] tiles[i];
+	}
+
+	writeLE(table + tilecount * sizeof(uint64), offset, 8);
+
+	return encimg;
+}
+
+void TiledHandler::freeRawPixels(unsigned char *mem)
+{
+	delete[] mem;
+}
+
+} // magpie
+} // image
+} // love
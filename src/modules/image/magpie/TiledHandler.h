@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "image/FormatHandler.h"
+#include "common/int.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace image
+{
+namespace magpie
+{
+
+/**
+ * LOVE's own tiled image container. The image is split into square tiles
+ * which are LZ4-compressed separately, with a table of where each one starts,
+ * so any region can be decoded without touching the rest of the image.
+ **/
+class TiledHandler final : public FormatHandler
+{
+public:
+
+	static const int DEFAULT_TILE_SIZE = 256;
+
+	struct Header
+	{
+		PixelFormat format = PIXELFORMAT_UNKNOWN;
+		int width = 0;
+		int height = 0;
+		int tileSize = 0;
+		int tilesX = 0;
+		int tilesY = 0;
+
+		// Size of the header, including the tile offset table.
+		size_t size = 0;
+	};
+
+	/**
+	 * Size of the fixed part of the header, which comes before the offset
+	 * table.
+	 **/
+	static const size_t FIXED_HEADER_SIZE = 40;
+
+	/**
+	 * Checks for the magic bytes at the start of the container.
+	 **/
+	static bool isTiledImage(const void *data, size_t size);
+
+	/**
+	 * Parses the fixed part of the header.
+	 **/
+	static Header parseHeader(const void *data, size_t size);
+
+	/**
+	 * Parses the tile offset table, which starts FIXED_HEADER_SIZE bytes into
+	 * the file. Offsets are from the start of the file. The last one is the
+	 * end of the final tile.
+	 **/
+	static std::vector<uint64> parseOffsets(const Header &header, const void *table, uint64 filesize);
+
+	/**
+	 * Decompresses one tile into dst, whose rows are dststride bytes apart.
+	 **/
+	static void decodeTile(const Header &header, int tx, int ty, const void *src, size_t srcsize, unsigned char *dst, size_t dststride);
+
+	static void getTileSize(const Header &header, int tx, int ty, int &w, int &h);
+
+	// Implements FormatHandler.
+
+	bool canDecode(Data *data) override;
+	bool canEncode(PixelFormat rawFormat, EncodedFormat encodedFormat) override;
+
+	DecodedImage decode(Data *data) override;
+	EncodedImage encode(const DecodedImage &img, EncodedFormat format) override;
+
+	void freeRawPixels(unsigned char *mem) override;
+
+}; // TiledHandler
+
+} // magpie
+} // image
+} // love
@@ -26,6 +26,7 @@
 #include "Image.h"
 
 #include "filesystem/wrap_Filesystem.h"
+#include "thread/wrap_Job.h"
 
 namespace love
 {
@@ -103,6 +104,21 @@ int w_newImageData(lua_State *L)
 	}
 }
 
+int w_newImageDataAsync(lua_State *L)
+{
+	Data *data = love::filesystem::luax_getdata(L, 1);
+
+	thread::Job *t = nullptr;
+	luax_catchexcept(L,
+		[&]() { t = instance()->newImageDataAsync(data); },
+		[&](bool) { data->release(); }
+	);
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
 int w_newCompressedData(lua_State *L)
 {
 	Data *data = love::filesystem::luax_getdata(L, 1);
@@ -128,6 +144,37 @@ int w_isCompressed(lua_State *L)
 	return 1;
 }
 
+int w_newImageSource(lua_State *L)
+{
+	int cachetiles = (int) luaL_optinteger(L, 2, ImageSource::DEFAULT_CACHE_TILES);
+
+	ImageSource *t = nullptr;
+
+	if (luax_istype(L, 1, Data::type))
+	{
+		Data *data = data::luax_checkdata(L, 1);
+		luax_catchexcept(L, [&]() { t = instance()->newImageSource(data, cachetiles); });
+	}
+	else
+	{
+		love::filesystem::File *file = love::filesystem::luax_getfile(L, 1);
+
+		luax_catchexcept(L,
+			[&]() {
+				if (!file->isOpen() && !file->open(love::filesystem::File::MODE_READ))
+					throw love::Exception("File is not open and cannot be opened.");
+
+				t = instance()->newImageSource(file, cachetiles);
+			},
+			[&](bool) { file->release(); }
+		);
+	}
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
 int w_newCubeFaces(lua_State *L)
 {
 	ImageData *id = luax_checkimagedata(L, 1);
@@ -142,8 +189,10 @@ int w_newCubeFaces(lua_State *L)
 static const luaL_Reg functions[] =
 {
 	{ "newImageData",  w_newImageData },
+	{ "newImageDataAsync", w_newImageDataAsync },
 	{ "newCompressedData", w_newCompressedData },
 	{ "isCompressed", w_isCompressed },
+	{ "newImageSource", w_newImageSource },
 	{ "newCubeFaces", w_newCubeFaces },
 	{ 0, 0 }
 };
@@ -152,6 +201,8 @@ static const lua_CFunction types[] =
 {
 	luaopen_imagedata,
 	luaopen_compressedimagedata,
+	luaopen_imagesource,
+	thread::luaopen_job,
 	0
 };
 
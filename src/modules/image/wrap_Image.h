@@ -25,6 +25,7 @@
 #include "Image.h"
 #include "wrap_ImageData.h"
 #include "wrap_CompressedImageData.h"
+#include "wrap_ImageSource.h"
 
 namespace love
 {
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_ImageSource.h"
+
+namespace love
+{
+namespace image
+{
+
+ImageSource *luax_checkimagesource(lua_State *L, int idx)
+{
+	return luax_checktype<ImageSource>(L, idx);
+}
+
+int w_ImageSource_getWidth(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	lua_pushinteger(L, t->getWidth());
+	return 1;
+}
+
+int w_ImageSource_getHeight(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	lua_pushinteger(L, t->getHeight());
+	return 1;
+}
+
+int w_ImageSource_getDimensions(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	lua_pushinteger(L, t->getWidth());
+	lua_pushinteger(L, t->getHeight());
+	return 2;
+}
+
+int w_ImageSource_getFormat(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+
+	PixelFormat format = t->getFormat();
+	const char *str;
+
+	if (getConstant(format, str))
+		lua_pushstring(L, str);
+	else
+		lua_pushstring(L, "unknown");
+
+	return 1;
+}
+
+int w_ImageSource_isTiled(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	luax_pushboolean(L, t->isTiled());
+	return 1;
+}
+
+int w_ImageSource_getTileSize(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	lua_pushinteger(L, t->getTileSize());
+	return 1;
+}
+
+int w_ImageSource_getRegion(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	int x = (int) luaL_checkinteger(L, 2);
+	int y = (int) luaL_checkinteger(L, 3);
+	int w = (int) luaL_checkinteger(L, 4);
+	int h = (int) luaL_checkinteger(L, 5);
+
+	ImageData *region = nullptr;
+	luax_catchexcept(L, [&]() { region = t->getRegion(x, y, w, h); });
+
+	luax_pushtype(L, region);
+	region->release();
+	return 1;
+}
+
+int w_ImageSource_setCacheLimit(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	int tiles = (int) luaL_checkinteger(L, 2);
+	t->setCacheLimit(tiles);
+	return 0;
+}
+
+int w_ImageSource_getCacheLimit(lua_State *L)
+{
+	ImageSource *t = luax_checkimagesource(L, 1);
+	lua_pushinteger(L, t->getCacheLimit());
+	return 1;
+}
+
+static const luaL_Reg w_ImageSource_functions[] =
+{
+	{ "getWidth", w_ImageSource_getWidth },
+	{ "getHeight", w_ImageSource_getHeight },
+	{ "getDimensions", w_ImageSource_getDimensions },
+	{ "getFormat", w_ImageSource_getFormat },
+	{ "isTiled", w_ImageSource_isTiled },
+	{ "getTileSize", w_ImageSource_getTileSize },
+	{ "getRegion", w_ImageSource_getRegion },
+	{ "setCacheLimit", w_ImageSource_setCacheLimit },
+	{ "getCacheLimit", w_ImageSource_getCacheLimit },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_imagesource(lua_State *L)
+{
+	return luax_register_type(L, &ImageSource::type, w_ImageSource_functions, nullptr);
+}
+
+} // image
+} // love
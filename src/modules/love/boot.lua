@@ -179,6 +179,7 @@ function love.init()
 		externalstorage = false, -- Only relevant for Android.
 		accelerometerjoystick = true, -- Only relevant for Android / iOS.
 		gammacorrect = false,
+		threadedrendering = false, -- Only relevant for macOS and Mesa / NVIDIA drivers on Linux.
 	}
 
 	-- Console hack, part 1.
@@ -216,6 +217,10 @@ function love.init()
 		love._setGammaCorrect(c.gammacorrect)
 	end
 
+	if love._setThreadedRendering then
+		love._setThreadedRendering(c.threadedrendering)
+	end
+
 	if love._setAudioMixWithSystem then
 		if c.audio and c.audio.mixwithsystem ~= nil then
 			love._setAudioMixWithSystem(c.audio.mixwithsystem)
@@ -103,6 +103,9 @@ function love.createhandlers()
 		threaderror = function (t, err)
 			if love.threaderror then return love.threaderror(t, err) end
 		end,
+		filesystemio = function (id, filename, result, err)
+			if love.filesystem then return love.filesystem._dispatchAsync(id, filename, result, err) end
+		end,
 		resize = function (w, h)
 			if love.resize then return love.resize(w, h) end
 		end,
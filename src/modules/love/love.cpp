@@ -71,7 +71,7 @@ extern "C"
 #	include "libraries/lua53/lutf8lib.h"
 #endif
 
-// For love::graphics::setGammaCorrect.
+// For love::graphics::setGammaCorrect and setThreadedRendering.
 #ifdef LOVE_ENABLE_GRAPHICS
 #	include "graphics/Graphics.h"
 #endif
@@ -351,6 +351,14 @@ static int w__setGammaCorrect(lua_State *L)
 	return 0;
 }
 
+static int w__setThreadedRendering(lua_State *L)
+{
+#ifdef LOVE_ENABLE_GRAPHICS
+	love::graphics::setThreadedRendering((bool) lua_toboolean(L, 1));
+#endif
+	return 0;
+}
+
 static int w__setAudioMixWithSystem(lua_State *L)
 {
 	bool success = false;
@@ -455,6 +463,9 @@ int luaopen_love(lua_State *L)
 	lua_pushcfunction(L, w__setGammaCorrect);
 	lua_setfield(L, -2, "_setGammaCorrect");
 
+	lua_pushcfunction(L, w__setThreadedRendering);
+	lua_setfield(L, -2, "_setThreadedRendering");
+
 	// Exposed here because we need to be able to call it before the audio
 	// module is initialized.
 	lua_pushcfunction(L, w__setAudioMixWithSystem);
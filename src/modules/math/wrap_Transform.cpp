@@ -20,6 +20,11 @@
 
 #include "wrap_Transform.h"
 
+// Put the Lua code directly into a raw string literal.
+static const char transform_lua[] =
+#include "wrap_Transform.lua"
+;
+
 namespace love
 {
 namespace math
@@ -291,6 +296,69 @@ int w_Transform__mul(lua_State *L)
 	return 1;
 }
 
+// C functions in a struct, necessary for the FFI versions of Transform
+// functions. Each returns false if the Proxy isn't a Transform.
+struct FFI_Transform
+{
+	bool (*translate)(Proxy *p, float x, float y);
+	bool (*rotate)(Proxy *p, float angle);
+	bool (*scale)(Proxy *p, float sx, float sy);
+	bool (*transformPoint)(Proxy *p, float *xy);
+	bool (*inverseTransformPoint)(Proxy *p, float *xy);
+};
+
+static FFI_Transform ffifuncs =
+{
+	[](Proxy *p, float x, float y) -> bool // translate
+	{
+		Transform *t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->translate(x, y);
+		return true;
+	},
+
+	[](Proxy *p, float angle) -> bool // rotate
+	{
+		Transform *t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->rotate(angle);
+		return true;
+	},
+
+	[](Proxy *p, float sx, float sy) -> bool // scale
+	{
+		Transform *t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->scale(sx, sy);
+		return true;
+	},
+
+	[](Proxy *p, float *xy) -> bool // transformPoint
+	{
+		Transform *t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		love::Vector2 v = t->transformPoint(love::Vector2(xy[0], xy[1]));
+		xy[0] = v.x;
+		xy[1] = v.y;
+		return true;
+	},
+
+	[](Proxy *p, float *xy) -> bool // inverseTransformPoint
+	{
+		Transform *t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		love::Vector2 v = t->inverseTransformPoint(love::Vector2(xy[0], xy[1]));
+		xy[0] = v.x;
+		xy[1] = v.y;
+		return true;
+	},
+};
+
 static const luaL_Reg functions[] =
 {
 	{ "clone", w_Transform_clone },
@@ -313,7 +381,11 @@ static const luaL_Reg functions[] =
 
 extern "C" int luaopen_transform(lua_State *L)
 {
-	return luax_register_type(L, &Transform::type, functions, nullptr);
+	int n = luax_register_type(L, &Transform::type, functions, nullptr);
+
+	luax_runwrapper(L, transform_lua, sizeof(transform_lua), "Transform.lua", Transform::type, &ffifuncs);
+
+	return n;
 }
 
 } // math
@@ -0,0 +1,114 @@
+R"luastring"--(
+-- DO NOT REMOVE THE ABOVE LINE. It is used to load this file as a C++ string.
+-- There is a matching delimiter at the bottom of the file.
+
+--[[
+Copyright (c) 2006-2023 LOVE Development Team
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+claim that you wrote the original software. If you use this software
+in a product, an acknowledgment in the product documentation would be
+appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+--]]
+
+
+local Transform_mt, ffifuncspointer_str = ...
+local Transform = Transform_mt.__index
+
+local type = type
+
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+-- Matches the struct declaration in wrap_Transform.cpp.
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_Transform
+{
+	bool (*translate)(Proxy *p, float x, float y);
+	bool (*rotate)(Proxy *p, float angle);
+	bool (*scale)(Proxy *p, float sx, float sy);
+	bool (*transformPoint)(Proxy *p, float *xy);
+	bool (*inverseTransformPoint)(Proxy *p, float *xy);
+} FFI_Transform;
+]])
+
+local ffifuncs = ffi.cast("FFI_Transform **", ffifuncspointer_str)[0]
+
+-- Scratch space for arguments and return values. Only used for the duration of
+-- a single method call, so it can be shared.
+local point = ffi.new("float[2]")
+
+-- The regular methods handle non-number arguments (and raise the appropriate
+-- errors) when the FFI versions can't be used.
+local _translate = Transform.translate
+local _rotate = Transform.rotate
+local _scale = Transform.scale
+local _transformPoint = Transform.transformPoint
+local _inverseTransformPoint = Transform.inverseTransformPoint
+
+
+-- Overwrite some regular Transform methods with FFI implementations.
+
+function Transform:translate(x, y)
+	if type(x) == "number" and type(y) == "number" and ffifuncs.translate(self, x, y) then
+		return self
+	end
+	return _translate(self, x, y)
+end
+
+function Transform:rotate(angle)
+	if type(angle) == "number" and ffifuncs.rotate(self, angle) then
+		return self
+	end
+	return _rotate(self, angle)
+end
+
+function Transform:scale(sx, sy)
+	if sy == nil then sy = sx end
+	if type(sx) == "number" and type(sy) == "number" and ffifuncs.scale(self, sx, sy) then
+		return self
+	end
+	return _scale(self, sx, sy)
+end
+
+function Transform:transformPoint(x, y)
+	if type(x) == "number" and type(y) == "number" then
+		point[0], point[1] = x, y
+		if ffifuncs.transformPoint(self, point) then
+			return point[0], point[1]
+		end
+	end
+	return _transformPoint(self, x, y)
+end
+
+function Transform:inverseTransformPoint(x, y)
+	if type(x) == "number" and type(y) == "number" then
+		point[0], point[1] = x, y
+		if ffifuncs.inverseTransformPoint(self, point) then
+			return point[0], point[1]
+		end
+	end
+	return _inverseTransformPoint(self, x, y)
+end
+
+-- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
+--)luastring"--"
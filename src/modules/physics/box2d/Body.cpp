@@ -47,6 +47,8 @@ Body::Body(World *world, b2Vec2 p, Body::Type type)
 	def.position = Physics::scaleDown(p);
 	def.userData = (void *) udata;
 	body = world->world->CreateBody(&def);
+	udata->previousPosition = body->GetPosition();
+	udata->previousAngle = body->GetAngle();
 	// Box2D body holds a reference to the love Body.
 	this->retain();
 	this->setType(type);
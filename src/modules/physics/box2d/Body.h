@@ -49,6 +49,12 @@ struct bodyudata
 {
 	// Reference to arbitrary data.
 	Reference *ref = nullptr;
+
+	// Position and angle before the World's most recent step, in Box2D
+	// units. Only kept up to date while the World uses a fixed timestep or
+	// interpolation. Used for World:getInterpolatedTransforms.
+	b2Vec2 previousPosition = b2Vec2(0.0f, 0.0f);
+	float previousAngle = 0.0f;
 };
 
 /**
@@ -68,6 +74,7 @@ class Body : public love::physics::Body
 	friend class PolygonShape;
 	friend class Shape;
 	friend class Fixture;
+	friend class World;
 
 	// Public because joints et al ask for b2body
 	b2Body *body;
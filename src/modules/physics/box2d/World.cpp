@@ -25,10 +25,17 @@
 #include "Contact.h"
 #include "Physics.h"
 #include "common/Reference.h"
+#include "thread/JobSystem.h"
 
 // Needed for World::getJoints. It should be moved to wrapper code...
 #include "wrap_Joint.h"
 
+// C++
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstring>
+
 namespace love
 {
 namespace physics
@@ -36,6 +43,171 @@ namespace physics
 namespace box2d
 {
 
+namespace
+{
+
+// Handing work to other threads isn't free, so small batches stay on the
+// calling thread.
+const int MIN_QUERIES_PER_THREAD = 256;
+
+class BatchRayCastCallback : public b2RayCastCallback
+{
+public:
+
+	BatchRayCastCallback(World::RayCastMode mode, std::vector<World::RayCastHit> &hits)
+		: mode(mode)
+		, hits(hits)
+		, found(false)
+	{}
+
+	void cast(const b2World *world, int ray, const b2Vec2 &p1, const b2Vec2 &p2)
+	{
+		// Box2D asserts on zero-length rays, and they can't hit anything.
+		if ((p2 - p1).LengthSquared() <= 0.0f)
+			return;
+
+		this->ray = ray;
+		found = false;
+
+		size_t first = hits.size();
+		world->RayCast(this, p1, p2);
+
+		if (found)
+			hits.push_back(closest);
+		else if (mode == World::RAYCAST_ALL)
+		{
+			std::sort(hits.begin() + first, hits.end(), [](const World::RayCastHit &a, const World::RayCastHit &b)
+			{
+				return a.fraction < b.fraction;
+			});
+		}
+	}
+
+	float32 ReportFixture(b2Fixture *fixture, const b2Vec2 &point, const b2Vec2 &normal, float32 fraction) override
+	{
+		World::RayCastHit hit = {ray, fixture, point, normal, fraction};
+
+		switch (mode)
+		{
+		case World::RAYCAST_CLOSEST:
+			closest = hit;
+			found = true;
+			return fraction; // Clip the ray, so only closer fixtures are reported.
+		case World::RAYCAST_ANY:
+			closest = hit;
+			found = true;
+			return 0.0f; // Stop at the first hit.
+		case World::RAYCAST_ALL:
+		default:
+			hits.push_back(hit);
+			return 1.0f;
+		}
+	}
+
+private:
+
+	World::RayCastMode mode;
+	std::vector<World::RayCastHit> &hits;
+
+	int ray;
+	World::RayCastHit closest;
+	bool found;
+
+}; // BatchRayCastCallback
+
+class BatchQueryCallback : public b2QueryCallback
+{
+public:
+
+	BatchQueryCallback(std::vector<World::QueryHit> &hits)
+		: hits(hits)
+		, box(0)
+	{}
+
+	void query(const b2World *world, int box, const b2AABB &aabb)
+	{
+		this->box = box;
+		world->QueryAABB(this, aabb);
+	}
+
+	bool ReportFixture(b2Fixture *fixture) override
+	{
+		World::QueryHit hit = {box, fixture};
+		hits.push_back(hit);
+		return true;
+	}
+
+private:
+
+	std::vector<World::QueryHit> &hits;
+	int box;
+
+}; // BatchQueryCallback
+
+/**
+ * Calls func for contiguous ranges of [0, count), spread across up to
+ * threadcount threads of the JobSystem, including the calling one. Each range
+ * collects its hits separately, and they're joined in order afterwards.
+ **/
+template <typename Hit>
+void runBatch(int count, int threadcount, const std::function<void(int, int, std::vector<Hit> &)> &func, std::vector<Hit> &hits)
+{
+	threadcount = std::max(1, std::min(threadcount, count / MIN_QUERIES_PER_THREAD));
+
+	thread::JobSystem *jobs = nullptr;
+	if (threadcount > 1)
+	{
+		jobs = thread::JobSystem::getInstance();
+		threadcount = std::min(threadcount, jobs->getThreadCount() + 1);
+	}
+
+	if (threadcount == 1)
+	{
+		func(0, count, hits);
+		return;
+	}
+
+	int rangesize = (count + threadcount - 1) / threadcount;
+	std::vector<std::vector<Hit>> results(threadcount);
+	std::vector<thread::Job *> workers;
+
+	for (int i = 1; i < threadcount && i * rangesize < count; i++)
+	{
+		int first = i * rangesize;
+		int last = std::min(count, first + rangesize);
+		std::vector<Hit> &result = results[i];
+
+		workers.push_back(jobs->schedule([&func, &result, first, last]() { func(first, last, result); }));
+	}
+
+	std::string error;
+
+	try
+	{
+		func(0, std::min(count, rangesize), results[0]);
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+	}
+
+	for (thread::Job *worker : workers)
+	{
+		jobs->wait(worker);
+		if (error.empty())
+			error = worker->getError();
+		worker->release();
+	}
+
+	if (!error.empty())
+		throw love::Exception("%s", error.c_str());
+
+	for (const std::vector<Hit> &result : results)
+		hits.insert(hits.end(), result.begin(), result.end());
+}
+
+} // anonymous namespace
+
 love::Type World::type("World", &Object::type);
 
 World::ContactCallback::ContactCallback(World *world)
@@ -226,6 +398,11 @@ void World::SayGoodbye(b2Joint *joint)
 World::World()
 	: world(nullptr)
 	, destructWorld(false)
+	, restoringState(false)
+	, fixedTimestep(0.0f)
+	, maxSubsteps(DEFAULT_MAX_SUBSTEPS)
+	, accumulator(0.0)
+	, interpolating(false)
 	, begin(this)
 	, end(this)
 	, presolve(this)
@@ -244,6 +421,11 @@ World::World()
 World::World(b2Vec2 gravity, bool sleep)
 	: world(nullptr)
 	, destructWorld(false)
+	, restoringState(false)
+	, fixedTimestep(0.0f)
+	, maxSubsteps(DEFAULT_MAX_SUBSTEPS)
+	, accumulator(0.0)
+	, interpolating(false)
 	, begin(this)
 	, end(this)
 	, presolve(this)
@@ -270,6 +452,37 @@ void World::update(float dt)
 }
 
 void World::update(float dt, int velocityIterations, int positionIterations)
+{
+	if (fixedTimestep <= 0.0f)
+	{
+		if (interpolating)
+			savePreviousTransforms();
+
+		step(dt, velocityIterations, positionIterations);
+		return;
+	}
+
+	accumulator += dt;
+
+	int steps = std::min((int) (accumulator / fixedTimestep), maxSubsteps);
+
+	for (int i = 0; i < steps && world != nullptr; i++)
+	{
+		// Interpolation only needs the state from before the last step.
+		if (i == steps - 1)
+			savePreviousTransforms();
+
+		step(fixedTimestep, velocityIterations, positionIterations);
+		accumulator -= fixedTimestep;
+	}
+
+	// Drop whatever couldn't be simulated within maxSubsteps, so a long
+	// frame doesn't make the following ones try to catch up.
+	if (accumulator >= fixedTimestep)
+		accumulator = std::fmod(accumulator, (double) fixedTimestep);
+}
+
+void World::step(float dt, int velocityIterations, int positionIterations)
 {
 	world->Step(dt, velocityIterations, positionIterations);
 
@@ -307,7 +520,10 @@ void World::BeginContact(b2Contact *contact)
 
 void World::EndContact(b2Contact *contact)
 {
-	end.process(contact);
+	// Contacts destroyed while restoring a saved state never ended in the
+	// simulation being restored, so they aren't reported.
+	if (!restoringState)
+		end.process(contact);
 
 	// Letting the Contact know that the b2Contact will be destroyed any second.
 	Contact *c = (Contact *)findObject(contact);
@@ -459,6 +675,176 @@ bool World::isLocked() const
 	return world->IsLocked();
 }
 
+void World::setFixedTimestep(float timestep, int maxSubsteps)
+{
+	if (timestep < 0.0f)
+		throw love::Exception("The fixed timestep cannot be negative.");
+
+	if (maxSubsteps < 1)
+		throw love::Exception("The maximum number of substeps must be at least 1.");
+
+	// Previous transforms aren't recorded by variable-timestep updates unless
+	// interpolation is already in use.
+	if (timestep > 0.0f && fixedTimestep <= 0.0f && !interpolating && !world->IsLocked())
+		savePreviousTransforms();
+
+	fixedTimestep = timestep;
+	this->maxSubsteps = maxSubsteps;
+	accumulator = 0.0;
+}
+
+float World::getFixedTimestep() const
+{
+	return fixedTimestep;
+}
+
+int World::getMaxSubsteps() const
+{
+	return maxSubsteps;
+}
+
+float World::getInterpolationAlpha() const
+{
+	if (fixedTimestep <= 0.0f)
+		return 1.0f;
+
+	return (float) std::min(accumulator / fixedTimestep, 1.0);
+}
+
+void World::savePreviousTransforms()
+{
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		bodyudata *udata = (bodyudata *) b->GetUserData();
+		if (udata == nullptr)
+			continue;
+
+		udata->previousPosition = b->GetPosition();
+		udata->previousAngle = b->GetAngle();
+	}
+}
+
+int World::getInterpolatedTransforms(float alpha, float *dst, int maxbodies)
+{
+	// Start recording previous transforms. Until the next update they're the
+	// same as the current ones.
+	if (!interpolating)
+	{
+		interpolating = true;
+		if (fixedTimestep <= 0.0f)
+			savePreviousTransforms();
+	}
+
+	int count = 0;
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr && count < maxbodies; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+
+		const bodyudata *udata = (const bodyudata *) b->GetUserData();
+		if (udata == nullptr)
+			throw love::Exception("A body has escaped Memoizer!");
+
+		b2Vec2 position = udata->previousPosition + alpha * (b->GetPosition() - udata->previousPosition);
+		float angle = udata->previousAngle + alpha * (b->GetAngle() - udata->previousAngle);
+
+		position = Physics::scaleUp(position);
+
+		dst[count * 3 + 0] = position.x;
+		dst[count * 3 + 1] = position.y;
+		dst[count * 3 + 2] = angle;
+		count++;
+	}
+
+	return count;
+}
+
+love::data::ByteData *World::saveState() const
+{
+	if (world->IsLocked())
+		throw love::Exception("The World's state cannot be saved during a World update.");
+
+	// The previous transforms used for interpolation follow Box2D's state, as
+	// the x, y and angle of each body in body list order, and then the
+	// fixed timestep accumulator.
+	size_t snapshotsize = (size_t) b2WorldSnapshot::GetSize(world);
+	size_t transformsize = (size_t) getBodyCount() * sizeof(float) * 3;
+
+	love::data::ByteData *data = new love::data::ByteData(snapshotsize + transformsize + sizeof(double));
+	b2WorldSnapshot::Save(world, data->getData());
+
+	char *dst = (char *) data->getData() + snapshotsize;
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+
+		const bodyudata *udata = (const bodyudata *) b->GetUserData();
+		float transform[3] = {0.0f, 0.0f, 0.0f};
+
+		if (udata != nullptr)
+		{
+			transform[0] = udata->previousPosition.x;
+			transform[1] = udata->previousPosition.y;
+			transform[2] = udata->previousAngle;
+		}
+
+		memcpy(dst, transform, sizeof(transform));
+		dst += sizeof(transform);
+	}
+
+	memcpy(dst, &accumulator, sizeof(double));
+
+	return data;
+}
+
+void World::restoreState(const Data *data)
+{
+	if (world->IsLocked())
+		throw love::Exception("The World's state cannot be restored during a World update.");
+
+	size_t trailingsize = (size_t) getBodyCount() * sizeof(float) * 3 + sizeof(double);
+
+	if (data->getSize() > (size_t) LOVE_INT32_MAX || data->getSize() < trailingsize)
+		throw love::Exception("Invalid World state.");
+
+	size_t snapshotsize = data->getSize() - trailingsize;
+
+	restoringState = true;
+	bool success = b2WorldSnapshot::Restore(world, data->getData(), (int32) snapshotsize);
+	restoringState = false;
+
+	if (!success)
+		throw love::Exception("The saved state doesn't match the World's current bodies, fixtures and joints.");
+
+	// Otherwise the first interpolated transforms after a rollback would
+	// blend from where the bodies were before it.
+	const char *src = (const char *) data->getData() + snapshotsize;
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+
+		float transform[3];
+		memcpy(transform, src, sizeof(transform));
+		src += sizeof(transform);
+
+		bodyudata *udata = (bodyudata *) b->GetUserData();
+		if (udata == nullptr)
+			continue;
+
+		udata->previousPosition = b2Vec2(transform[0], transform[1]);
+		udata->previousAngle = transform[2];
+	}
+
+	// The number of substeps in the next update and the interpolation alpha
+	// both depend on it.
+	memcpy(&accumulator, src, sizeof(double));
+}
+
 int World::getBodyCount() const
 {
 	return world->GetBodyCount()-1; // ignore the ground body
@@ -570,6 +956,142 @@ int World::rayCast(lua_State *L)
 	return 0;
 }
 
+void World::rayCastBatch(const std::vector<b2Vec2> &points, RayCastMode mode, int threadcount, std::vector<RayCastHit> &hits) const
+{
+	int count = (int) (points.size() / 2);
+	const b2World *w = world;
+
+	runBatch<RayCastHit>(count, threadcount, [&](int first, int last, std::vector<RayCastHit> &result)
+	{
+		BatchRayCastCallback callback(mode, result);
+		for (int i = first; i < last; i++)
+			callback.cast(w, i, points[i * 2 + 0], points[i * 2 + 1]);
+	}, hits);
+}
+
+void World::queryBoundingBoxes(const std::vector<b2AABB> &boxes, int threadcount, std::vector<QueryHit> &hits) const
+{
+	int count = (int) boxes.size();
+	const b2World *w = world;
+
+	runBatch<QueryHit>(count, threadcount, [&](int first, int last, std::vector<QueryHit> &result)
+	{
+		BatchQueryCallback callback(result);
+		for (int i = first; i < last; i++)
+			callback.query(w, i, boxes[i]);
+	}, hits);
+}
+
+int World::rayCastBatch(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	RayCastMode mode = RAYCAST_CLOSEST;
+	if (!lua_isnoneornil(L, 2))
+	{
+		const char *modestr = luaL_checkstring(L, 2);
+		if (!getConstant(modestr, mode))
+			return luax_enumerror(L, "raycast mode", getConstants(mode), modestr);
+	}
+
+	int threadcount = (int) luaL_optinteger(L, 3, 1);
+
+	int length = (int) luax_objlen(L, 1);
+	if (length % 4 != 0)
+		return luaL_error(L, "The rays table must contain four numbers (x1, y1, x2, y2) per ray.");
+
+	std::vector<b2Vec2> points(length / 2);
+	for (int i = 0; i < length / 2; i++)
+	{
+		lua_rawgeti(L, 1, i * 2 + 1);
+		lua_rawgeti(L, 1, i * 2 + 2);
+		float x = (float) luaL_checknumber(L, -2);
+		float y = (float) luaL_checknumber(L, -1);
+		lua_pop(L, 2);
+
+		points[i] = Physics::scaleDown(b2Vec2(x, y));
+	}
+
+	std::vector<RayCastHit> hits;
+	rayCastBatch(points, mode, threadcount, hits);
+
+	// Each hit is stored as: ray index, fixture, x, y, normal x, normal y, fraction.
+	lua_createtable(L, (int) hits.size() * 7, 0);
+
+	int index = 1;
+	for (const RayCastHit &hit : hits)
+	{
+		Fixture *f = (Fixture *) findObject(hit.fixture);
+		if (!f)
+			throw love::Exception("A fixture has escaped Memoizer!");
+
+		b2Vec2 point = Physics::scaleUp(hit.point);
+
+		lua_pushinteger(L, hit.ray + 1);
+		lua_rawseti(L, -2, index++);
+		luax_pushtype(L, f);
+		lua_rawseti(L, -2, index++);
+		lua_pushnumber(L, point.x);
+		lua_rawseti(L, -2, index++);
+		lua_pushnumber(L, point.y);
+		lua_rawseti(L, -2, index++);
+		lua_pushnumber(L, hit.normal.x);
+		lua_rawseti(L, -2, index++);
+		lua_pushnumber(L, hit.normal.y);
+		lua_rawseti(L, -2, index++);
+		lua_pushnumber(L, hit.fraction);
+		lua_rawseti(L, -2, index++);
+	}
+
+	return 1;
+}
+
+int World::queryBoundingBoxes(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	int threadcount = (int) luaL_optinteger(L, 2, 1);
+
+	int length = (int) luax_objlen(L, 1);
+	if (length % 4 != 0)
+		return luaL_error(L, "The boxes table must contain four numbers (topLeftX, topLeftY, bottomRightX, bottomRightY) per box.");
+
+	std::vector<b2AABB> boxes(length / 4);
+	for (int i = 0; i < length / 4; i++)
+	{
+		float v[4];
+		for (int j = 0; j < 4; j++)
+		{
+			lua_rawgeti(L, 1, i * 4 + j + 1);
+			v[j] = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 1);
+		}
+
+		boxes[i].lowerBound = Physics::scaleDown(b2Vec2(v[0], v[1]));
+		boxes[i].upperBound = Physics::scaleDown(b2Vec2(v[2], v[3]));
+	}
+
+	std::vector<QueryHit> hits;
+	queryBoundingBoxes(boxes, threadcount, hits);
+
+	// Each hit is stored as: box index, fixture.
+	lua_createtable(L, (int) hits.size() * 2, 0);
+
+	int index = 1;
+	for (const QueryHit &hit : hits)
+	{
+		Fixture *f = (Fixture *) findObject(hit.fixture);
+		if (!f)
+			throw love::Exception("A fixture has escaped Memoizer!");
+
+		lua_pushinteger(L, hit.box + 1);
+		lua_rawseti(L, -2, index++);
+		luax_pushtype(L, f);
+		lua_rawseti(L, -2, index++);
+	}
+
+	return 1;
+}
+
 void World::destroy()
 {
 	if (world == nullptr)
@@ -631,6 +1153,30 @@ love::Object *World::findObject(void *b2object) const
 		return nullptr;
 }
 
+bool World::getConstant(const char *in, RayCastMode &out)
+{
+	return rayCastModes.find(in, out);
+}
+
+bool World::getConstant(RayCastMode in, const char *&out)
+{
+	return rayCastModes.find(in, out);
+}
+
+std::vector<std::string> World::getConstants(RayCastMode)
+{
+	return rayCastModes.getNames();
+}
+
+StringMap<World::RayCastMode, World::RAYCAST_MAX_ENUM>::Entry World::rayCastModeEntries[] =
+{
+	{"closest", World::RAYCAST_CLOSEST},
+	{"any", World::RAYCAST_ANY},
+	{"all", World::RAYCAST_ALL},
+};
+
+StringMap<World::RayCastMode, World::RAYCAST_MAX_ENUM> World::rayCastModes(World::rayCastModeEntries, sizeof(World::rayCastModeEntries));
+
 } // box2d
 } // physics
 } // love
@@ -25,6 +25,8 @@
 #include "common/Object.h"
 #include "common/runtime.h"
 #include "common/Reference.h"
+#include "common/StringMap.h"
+#include "data/ByteData.h"
 
 // STD
 #include <vector>
@@ -69,6 +71,31 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 
 	static love::Type type;
 
+	static const int DEFAULT_MAX_SUBSTEPS = 8;
+
+	enum RayCastMode
+	{
+		RAYCAST_CLOSEST,
+		RAYCAST_ANY,
+		RAYCAST_ALL,
+		RAYCAST_MAX_ENUM
+	};
+
+	struct RayCastHit
+	{
+		int ray;
+		b2Fixture *fixture;
+		b2Vec2 point;
+		b2Vec2 normal;
+		float32 fraction;
+	};
+
+	struct QueryHit
+	{
+		int box;
+		b2Fixture *fixture;
+	};
+
 	class ContactCallback
 	{
 	public:
@@ -139,6 +166,33 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	void update(float dt);
 	void update(float dt, int velocityIterations, int positionIterations);
 
+	/**
+	 * Makes update() advance the simulation in steps of exactly the given
+	 * size, carrying leftover time over to the next update. At most
+	 * maxSubsteps steps are taken per update, and any time beyond that is
+	 * dropped. A timestep of 0 makes update() step by the time it's given.
+	 **/
+	void setFixedTimestep(float timestep, int maxSubsteps);
+	float getFixedTimestep() const;
+	int getMaxSubsteps() const;
+
+	/**
+	 * Gets how much leftover time the last update has accumulated towards
+	 * the next fixed step, from 0 to 1. Always 1 without a fixed timestep.
+	 **/
+	float getInterpolationAlpha() const;
+
+	/**
+	 * Writes the x, y and angle of each Body, in getBodies order, blended
+	 * between its state before and after the last step. Without a fixed
+	 * timestep, the previous states are only recorded by updates after the
+	 * first call to this.
+	 * @param alpha The blend factor. 0 gives the previous state and 1 the
+	 *        current one.
+	 * @return The number of bodies written.
+	 **/
+	int getInterpolatedTransforms(float alpha, float *dst, int maxbodies);
+
 	// From b2ContactListener
 	void BeginContact(b2Contact *contact);
 	void EndContact(b2Contact *contact);
@@ -227,6 +281,24 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	 **/
 	bool isLocked() const;
 
+	/**
+	 * Saves the state of the simulation: body motion, joint impulses,
+	 * contacts, the previous body transforms used for interpolation and the
+	 * time accumulated towards the next fixed timestep.
+	 * Restoring it and updating again gives the same results as the
+	 * original updates. The state is only meaningful to this World.
+	 * @return The saved state.
+	 **/
+	love::data::ByteData *saveState() const;
+
+	/**
+	 * Rewinds the simulation to a state from saveState. Bodies, fixtures and
+	 * joints are not created or destroyed, so the World must still have the
+	 * same ones as when the state was saved. Existing Contact objects may be
+	 * invalidated.
+	 **/
+	void restoreState(const Data *data);
+
 	/**
 	 * Get the current body count.
 	 * @return The number of bodies.
@@ -279,6 +351,31 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	 **/
 	int rayCast(lua_State *L);
 
+	/**
+	 * Casts many rays without calling back into Lua. Every two points make
+	 * up one ray, in Box2D units. Hits are grouped by ray in the order the
+	 * rays were given, and sorted by fraction within each ray. The queries
+	 * don't modify the World, so they can be split across several threads.
+	 **/
+	void rayCastBatch(const std::vector<b2Vec2> &points, RayCastMode mode, int threadcount, std::vector<RayCastHit> &hits) const;
+
+	/**
+	 * Finds the Fixtures overlapping each of the given boxes, without calling
+	 * back into Lua. Hits are grouped by box in the order the boxes were
+	 * given.
+	 **/
+	void queryBoundingBoxes(const std::vector<b2AABB> &boxes, int threadcount, std::vector<QueryHit> &hits) const;
+
+	/**
+	 * Takes a flat array of ray endpoints and returns a flat array of hits.
+	 **/
+	int rayCastBatch(lua_State *L);
+
+	/**
+	 * Takes a flat array of box bounds and returns a flat array of hits.
+	 **/
+	int queryBoundingBoxes(lua_State *L);
+
 	/**
 	 * Destroy this world.
 	 **/
@@ -288,8 +385,18 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	void unregisterObject(void *b2object);
 	love::Object *findObject(void *b2object) const;
 
+	static bool getConstant(const char *in, RayCastMode &out);
+	static bool getConstant(RayCastMode in, const char *&out);
+	static std::vector<std::string> getConstants(RayCastMode);
+
 private:
 
+	void step(float dt, int velocityIterations, int positionIterations);
+	void savePreviousTransforms();
+
+	static StringMap<RayCastMode, RAYCAST_MAX_ENUM>::Entry rayCastModeEntries[];
+	static StringMap<RayCastMode, RAYCAST_MAX_ENUM> rayCastModes;
+
 	// Pointer to the Box2D world.
 	b2World *world;
 
@@ -302,6 +409,17 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	std::vector<Joint *> destructJoints;
 	bool destructWorld;
 
+	// Set while a saved state is restored, to skip endContact callbacks.
+	bool restoringState;
+
+	float fixedTimestep;
+	int maxSubsteps;
+	double accumulator;
+
+	// Whether getInterpolatedTransforms has been used, in which case the
+	// previous body transforms are recorded even without a fixed timestep.
+	bool interpolating;
+
 	// Contact callbacks.
 	ContactCallback begin, end, presolve, postsolve;
 	ContactFilter filter;
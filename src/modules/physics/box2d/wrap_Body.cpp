@@ -21,6 +21,11 @@
 #include "wrap_Body.h"
 #include "wrap_Physics.h"
 
+// Put the Lua code directly into a raw string literal.
+static const char body_lua[] =
+#include "wrap_Body.lua"
+;
+
 namespace love
 {
 namespace physics
@@ -644,6 +649,52 @@ int w_Body_getContactList(lua_State *L)
 	return w_Body_getContacts(L);
 }
 
+// C functions in a struct, necessary for the FFI versions of Body functions.
+// Each returns false if the Body is invalid or destroyed, in which case the
+// Lua side falls back to the regular method to raise the error.
+struct FFI_Body
+{
+	bool (*getPosition)(Proxy *p, float *xy);
+	bool (*getAngle)(Proxy *p, float *angle);
+	bool (*getLinearVelocity)(Proxy *p, float *xy);
+};
+
+static Body *ffi_checkbody(Proxy *p)
+{
+	Body *b = luax_ffi_checktype<Body>(p);
+	return b != nullptr && b->body != nullptr ? b : nullptr;
+}
+
+static FFI_Body ffifuncs =
+{
+	[](Proxy *p, float *xy) -> bool // getPosition
+	{
+		Body *b = ffi_checkbody(p);
+		if (b == nullptr)
+			return false;
+		b->getPosition(xy[0], xy[1]);
+		return true;
+	},
+
+	[](Proxy *p, float *angle) -> bool // getAngle
+	{
+		Body *b = ffi_checkbody(p);
+		if (b == nullptr)
+			return false;
+		*angle = b->getAngle();
+		return true;
+	},
+
+	[](Proxy *p, float *xy) -> bool // getLinearVelocity
+	{
+		Body *b = ffi_checkbody(p);
+		if (b == nullptr)
+			return false;
+		b->getLinearVelocity(xy[0], xy[1]);
+		return true;
+	},
+};
+
 static const luaL_Reg w_Body_functions[] =
 {
 	{ "getX", w_Body_getX },
@@ -719,7 +770,11 @@ static const luaL_Reg w_Body_functions[] =
 
 extern "C" int luaopen_body(lua_State *L)
 {
-	return luax_register_type(L, &Body::type, w_Body_functions, nullptr);
+	int n = luax_register_type(L, &Body::type, w_Body_functions, nullptr);
+
+	luax_runwrapper(L, body_lua, sizeof(body_lua), "Body.lua", Body::type, &ffifuncs);
+
+	return n;
 }
 
 } // box2d
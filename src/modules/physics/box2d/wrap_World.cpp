@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_World.h"
+#include "data/wrap_Data.h"
 
 namespace love
 {
@@ -55,6 +56,61 @@ int w_World_update(lua_State *L)
 	return 0;
 }
 
+int w_World_setFixedTimestep(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	float timestep = (float) luaL_checknumber(L, 2);
+	int maxsubsteps = (int) luaL_optinteger(L, 3, World::DEFAULT_MAX_SUBSTEPS);
+	luax_catchexcept(L, [&](){ t->setFixedTimestep(timestep, maxsubsteps); });
+	return 0;
+}
+
+int w_World_getFixedTimestep(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushnumber(L, t->getFixedTimestep());
+	lua_pushinteger(L, t->getMaxSubsteps());
+	return 2;
+}
+
+int w_World_getInterpolationAlpha(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushnumber(L, t->getInterpolationAlpha());
+	return 1;
+}
+
+int w_World_getInterpolatedTransforms(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	float alpha = (float) luaL_optnumber(L, 2, t->getInterpolationAlpha());
+
+	int count = t->getBodyCount();
+	size_t size = (size_t) count * 3 * sizeof(float);
+
+	love::data::ByteData *data = nullptr;
+
+	if (!lua_isnoneornil(L, 3))
+	{
+		data = luax_checktype<love::data::ByteData>(L, 3);
+		if (data->getSize() < size)
+			return luaL_error(L, "The ByteData is too small to hold the transforms of %d bodies (%d bytes needed).", count, (int) size);
+		data->retain();
+	}
+	else
+		luax_catchexcept(L, [&](){ data = new love::data::ByteData(size); });
+
+	luax_catchexcept(L,
+		[&](){ count = t->getInterpolatedTransforms(alpha, (float *) data->getData(), count); },
+		[&](bool should_error) { if (should_error) data->release(); }
+	);
+
+	luax_pushtype(L, data);
+	data->release();
+	lua_pushinteger(L, count);
+	return 2;
+}
+
 int w_World_setCallbacks(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -130,6 +186,24 @@ int w_World_isLocked(lua_State *L)
 	return 1;
 }
 
+int w_World_saveState(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	love::data::ByteData *data = nullptr;
+	luax_catchexcept(L, [&](){ data = t->saveState(); });
+	luax_pushtype(L, data);
+	data->release();
+	return 1;
+}
+
+int w_World_restoreState(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	Data *data = data::luax_checkdata(L, 2);
+	luax_catchexcept(L, [&](){ t->restoreState(data); });
+	return 0;
+}
+
 int w_World_getBodyCount(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -194,6 +268,24 @@ int w_World_rayCast(lua_State *L)
 	return ret;
 }
 
+int w_World_rayCastBatch(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_remove(L, 1);
+	int ret = 0;
+	luax_catchexcept(L, [&](){ ret = t->rayCastBatch(L); });
+	return ret;
+}
+
+int w_World_queryBoundingBoxes(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_remove(L, 1);
+	int ret = 0;
+	luax_catchexcept(L, [&](){ ret = t->queryBoundingBoxes(L); });
+	return ret;
+}
+
 int w_World_destroy(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -229,6 +321,10 @@ int w_World_getContactList(lua_State *L)
 static const luaL_Reg w_World_functions[] =
 {
 	{ "update", w_World_update },
+	{ "setFixedTimestep", w_World_setFixedTimestep },
+	{ "getFixedTimestep", w_World_getFixedTimestep },
+	{ "getInterpolationAlpha", w_World_getInterpolationAlpha },
+	{ "getInterpolatedTransforms", w_World_getInterpolatedTransforms },
 	{ "setCallbacks", w_World_setCallbacks },
 	{ "getCallbacks", w_World_getCallbacks },
 	{ "setContactFilter", w_World_setContactFilter },
@@ -239,6 +335,8 @@ static const luaL_Reg w_World_functions[] =
 	{ "setSleepingAllowed", w_World_setSleepingAllowed },
 	{ "isSleepingAllowed", w_World_isSleepingAllowed },
 	{ "isLocked", w_World_isLocked },
+	{ "saveState", w_World_saveState },
+	{ "restoreState", w_World_restoreState },
 	{ "getBodyCount", w_World_getBodyCount },
 	{ "getJointCount", w_World_getJointCount },
 	{ "getContactCount", w_World_getContactCount },
@@ -247,6 +345,8 @@ static const luaL_Reg w_World_functions[] =
 	{ "getContacts", w_World_getContacts },
 	{ "queryBoundingBox", w_World_queryBoundingBox },
 	{ "rayCast", w_World_rayCast },
+	{ "rayCastBatch", w_World_rayCastBatch },
+	{ "queryBoundingBoxes", w_World_queryBoundingBoxes },
 	{ "destroy", w_World_destroy },
 	{ "isDestroyed", w_World_isDestroyed },
 
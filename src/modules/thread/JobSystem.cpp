@@ -0,0 +1,481 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "JobSystem.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace thread
+{
+
+love::Type Job::type("Job", &Object::type);
+
+Job::Job()
+	: complete(false)
+	, scheduled(false)
+	, pendingDependencies(0)
+{
+}
+
+Job::~Job()
+{
+}
+
+bool Job::isComplete() const
+{
+	return complete;
+}
+
+bool Job::hasError() const
+{
+	return !error.empty();
+}
+
+const std::string &Job::getError() const
+{
+	return error;
+}
+
+const Variant &Job::getResult() const
+{
+	return result;
+}
+
+FunctionJob::FunctionJob(const std::function<void()> &func)
+	: func(func)
+{
+}
+
+void FunctionJob::run()
+{
+	func();
+}
+
+JobSystem::Worker::Worker(JobSystem *system, int index)
+	: system(system)
+	, index(index)
+{
+	threadName = "JobSystem";
+}
+
+void JobSystem::Worker::threadFunction()
+{
+	while (true)
+	{
+		Job *job = system->takeJob(index);
+
+		if (job != nullptr)
+		{
+			system->execute(job);
+			continue;
+		}
+
+		Lock lock(system->mutex);
+
+		// A Job which was queued after the queues were checked is still
+		// counted, so this won't miss it.
+		while (!system->stopping && system->queuedCount == 0)
+			system->workCond->wait(system->mutex);
+
+		if (system->stopping)
+			return;
+	}
+}
+
+Job *JobSystem::Worker::popJob()
+{
+	Lock lock(jobsMutex);
+
+	if (jobs.empty())
+		return nullptr;
+
+	// The most recently queued Job is the most likely to have its data in
+	// this thread's caches.
+	Job *job = jobs.back();
+	jobs.pop_back();
+	return job;
+}
+
+Job *JobSystem::Worker::stealJob()
+{
+	Lock lock(jobsMutex);
+
+	if (jobs.empty())
+		return nullptr;
+
+	Job *job = jobs.front();
+	jobs.pop_front();
+	return job;
+}
+
+bool JobSystem::Worker::removeJob(Job *job)
+{
+	Lock lock(jobsMutex);
+
+	auto it = std::find(jobs.begin(), jobs.end(), job);
+	if (it == jobs.end())
+		return false;
+
+	jobs.erase(it);
+	return true;
+}
+
+void JobSystem::Worker::pushJob(Job *job)
+{
+	Lock lock(jobsMutex);
+	jobs.push_back(job);
+}
+
+JobSystem *JobSystem::getInstance()
+{
+	// The threads which wait on Jobs make up for the missing one.
+	static JobSystem *instance = new JobSystem(std::max(getProcessorCount() - 1, 1));
+	return instance;
+}
+
+JobSystem::JobSystem(int threadcount)
+	: nextWorker(0)
+	, queuedCount(0)
+	, waiterCount(0)
+	, enqueueCount(0)
+	, stopping(false)
+{
+	for (int i = 0; i < std::max(threadcount, 1); i++)
+		workers.push_back(new Worker(this, i));
+
+	for (Worker *worker : workers)
+		worker->start();
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		Lock lock(mutex);
+		stopping = true;
+		workCond->broadcast();
+	}
+
+	for (Worker *worker : workers)
+		worker->wait();
+
+	// Jobs which haven't started yet are dropped.
+	for (Worker *worker : workers)
+	{
+		while (Job *job = worker->stealJob())
+			job->release();
+
+		worker->release();
+	}
+}
+
+void JobSystem::schedule(Job *job, const std::vector<Job *> &dependencies)
+{
+	bool ready = false;
+
+	{
+		Lock lock(mutex);
+
+		if (job->scheduled)
+			throw love::Exception("Job has already been scheduled.");
+
+		for (Job *dependency : dependencies)
+		{
+			if (dependency != nullptr && !dependency->scheduled)
+				throw love::Exception("A Job's dependencies must be scheduled before it.");
+		}
+
+		job->retain();
+		job->scheduled = true;
+		job->pendingDependencies = 0;
+
+		for (Job *dependency : dependencies)
+		{
+			if (dependency == nullptr)
+				continue;
+
+			if (!dependency->complete)
+			{
+				dependency->dependents.emplace_back(job);
+				job->dependencies.emplace_back(dependency);
+				job->pendingDependencies++;
+			}
+			else if (dependency->hasError() && job->error.empty())
+				job->error = "Dependency failed: " + dependency->error;
+		}
+
+		ready = job->pendingDependencies == 0;
+	}
+
+	if (ready)
+		enqueue(job);
+}
+
+Job *JobSystem::schedule(const std::function<void()> &func, const std::vector<Job *> &dependencies)
+{
+	Job *job = new FunctionJob(func);
+
+	try
+	{
+		schedule(job, dependencies);
+	}
+	catch (std::exception &)
+	{
+		job->release();
+		throw;
+	}
+
+	return job;
+}
+
+void JobSystem::wait(Job *job)
+{
+	{
+		Lock lock(mutex);
+		if (!job->scheduled)
+			throw love::Exception("Cannot wait on a Job which hasn't been scheduled.");
+	}
+
+	// Running any queued Job here could make e.g. a short parallelFor on the
+	// main thread wait for a long unrelated Job, such as an image decode.
+	while (!job->complete)
+	{
+		uint32 enqueued = 0;
+
+		{
+			Lock lock(mutex);
+			enqueued = enqueueCount;
+		}
+
+		Job *own = takeJobFor(job);
+
+		if (own != nullptr)
+		{
+			execute(own);
+			continue;
+		}
+
+		Lock lock(mutex);
+
+		waiterCount++;
+		while (!job->complete && enqueueCount == enqueued)
+			completeCond->wait(mutex);
+		waiterCount--;
+	}
+}
+
+void JobSystem::parallelFor(int count, int minrange, const std::function<void(int first, int last)> &func)
+{
+	if (count <= 0)
+		return;
+
+	int rangecount = std::min(getThreadCount() + 1, count / std::max(minrange, 1));
+	if (rangecount <= 1)
+	{
+		func(0, count);
+		return;
+	}
+
+	int rangesize = (count + rangecount - 1) / rangecount;
+	std::vector<Job *> jobs;
+	std::string error;
+	bool failed = false;
+
+	try
+	{
+		// The Jobs reference func, so every one which was scheduled has to be
+		// waited on below, even if scheduling a later one fails.
+		jobs.reserve(rangecount - 1);
+
+		for (int first = rangesize; first < count; first += rangesize)
+		{
+			int last = std::min(count, first + rangesize);
+			jobs.push_back(schedule([&func, first, last]() { func(first, last); }));
+		}
+
+		func(0, rangesize);
+	}
+	catch (std::exception &e)
+	{
+		error = e.what();
+		failed = true;
+	}
+
+	for (Job *job : jobs)
+	{
+		wait(job);
+
+		if (!failed && job->hasError())
+		{
+			error = job->getError();
+			failed = true;
+		}
+
+		job->release();
+	}
+
+	if (failed)
+		throw love::Exception("%s", error.c_str());
+}
+
+int JobSystem::getThreadCount() const
+{
+	return (int) workers.size();
+}
+
+void JobSystem::enqueue(Job *job)
+{
+	Lock lock(mutex);
+
+	workers[nextWorker]->pushJob(job);
+	nextWorker = (nextWorker + 1) % (int) workers.size();
+
+	queuedCount++;
+	enqueueCount++;
+	workCond->signal();
+
+	if (waiterCount > 0)
+		completeCond->broadcast();
+}
+
+Job *JobSystem::takeJob(int worker)
+{
+	int count = (int) workers.size();
+	Job *job = nullptr;
+
+	if (worker >= 0)
+		job = workers[worker]->popJob();
+
+	for (int i = 1; i <= count && job == nullptr; i++)
+		job = workers[(std::max(worker, 0) + i) % count]->stealJob();
+
+	if (job != nullptr)
+	{
+		Lock lock(mutex);
+		queuedCount--;
+	}
+
+	return job;
+}
+
+Job *JobSystem::takeJobFor(Job *job)
+{
+	std::vector<Job *> candidates;
+
+	{
+		Lock lock(mutex);
+
+		// The Job and every incomplete Job it depends on, directly or not.
+		// They're retained since they may complete (and their dependencies be
+		// released) once the mutex is unlocked.
+		std::vector<Job *> stack = {job};
+
+		while (!stack.empty())
+		{
+			Job *j = stack.back();
+			stack.pop_back();
+
+			if (j->complete || std::find(candidates.begin(), candidates.end(), j) != candidates.end())
+				continue;
+
+			j->retain();
+			candidates.push_back(j);
+
+			for (const StrongRef<Job> &dependency : j->dependencies)
+				stack.push_back(dependency.get());
+		}
+	}
+
+	Job *taken = nullptr;
+
+	for (size_t i = 0; i < candidates.size() && taken == nullptr; i++)
+	{
+		for (Worker *worker : workers)
+		{
+			if (worker->removeJob(candidates[i]))
+			{
+				taken = candidates[i];
+				break;
+			}
+		}
+	}
+
+	if (taken != nullptr)
+	{
+		Lock lock(mutex);
+		queuedCount--;
+	}
+
+	for (Job *candidate : candidates)
+		candidate->release();
+
+	return taken;
+}
+
+void JobSystem::execute(Job *job)
+{
+	// Jobs whose dependencies failed already have an error, and don't run.
+	if (job->error.empty())
+	{
+		try
+		{
+			job->run();
+		}
+		catch (std::exception &e)
+		{
+			job->error = e.what();
+		}
+	}
+
+	std::vector<Job *> ready;
+
+	{
+		Lock lock(mutex);
+
+		job->complete = true;
+
+		for (const StrongRef<Job> &dependent : job->dependents)
+		{
+			if (job->hasError() && dependent->error.empty())
+				dependent->error = "Dependency failed: " + job->error;
+
+			if (--dependent->pendingDependencies == 0)
+				ready.push_back(dependent.get());
+		}
+
+		job->dependents.clear();
+		job->dependencies.clear();
+
+		if (waiterCount > 0)
+			completeCond->broadcast();
+	}
+
+	for (Job *dependent : ready)
+		enqueue(dependent);
+
+	// Releases the reference from schedule().
+	job->release();
+}
+
+} // thread
+} // love
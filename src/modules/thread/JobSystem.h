@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_THREAD_JOBSYSTEM_H
+#define LOVE_THREAD_JOBSYSTEM_H
+
+// LOVE
+#include "common/Object.h"
+#include "common/Variant.h"
+#include "threads.h"
+
+// STL
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+class JobSystem;
+
+/**
+ * A unit of work for the JobSystem. Subclasses implement run(), and can store
+ * a result for Lua to retrieve once the Job is complete.
+ **/
+class Job : public love::Object
+{
+public:
+
+	static love::Type type;
+
+	Job();
+	virtual ~Job();
+
+	virtual void run() = 0;
+
+	bool isComplete() const;
+
+	/**
+	 * Only valid once the Job is complete. A Job fails if run() throws, or if
+	 * any of its dependencies failed (in which case it doesn't run).
+	 **/
+	bool hasError() const;
+	const std::string &getError() const;
+	const Variant &getResult() const;
+
+protected:
+
+	Variant result;
+
+private:
+
+	friend class JobSystem;
+
+	std::atomic<bool> complete;
+	bool scheduled;
+	std::string error;
+
+	// Protected by the JobSystem's mutex.
+	int pendingDependencies;
+	std::vector<StrongRef<Job>> dependencies;
+	std::vector<StrongRef<Job>> dependents;
+
+}; // Job
+
+class FunctionJob : public Job
+{
+public:
+
+	FunctionJob(const std::function<void()> &func);
+	virtual ~FunctionJob() {}
+
+	void run() override;
+
+private:
+
+	std::function<void()> func;
+
+}; // FunctionJob
+
+/**
+ * Runs Jobs on a shared set of threads, one fewer than the number of
+ * processors since the threads which wait on Jobs help run them. Each thread
+ * has its own queue, and idle threads steal Jobs from the others' queues.
+ **/
+class JobSystem
+{
+public:
+
+	/**
+	 * Gets the JobSystem shared by all of LOVE, creating it if necessary.
+	 **/
+	static JobSystem *getInstance();
+
+	JobSystem(int threadcount);
+	~JobSystem();
+
+	/**
+	 * Queues a Job, which runs once all of the given Jobs are complete. The
+	 * JobSystem keeps a reference to the Job until it's complete.
+	 **/
+	void schedule(Job *job, const std::vector<Job *> &dependencies = {});
+
+	/**
+	 * Queues a function and returns its Job, which the caller must release.
+	 **/
+	Job *schedule(const std::function<void()> &func, const std::vector<Job *> &dependencies = {});
+
+	/**
+	 * Blocks until the Job is complete. If the Job or any Job it depends on is
+	 * still queued, it's run on the calling thread in the meantime. Unrelated
+	 * Jobs are left to the JobSystem's threads.
+	 **/
+	void wait(Job *job);
+
+	/**
+	 * Calls func for contiguous ranges of [0, count) in parallel, using the
+	 * calling thread as well. Ranges have at least minrange elements. Throws
+	 * the first error once all ranges are done.
+	 **/
+	void parallelFor(int count, int minrange, const std::function<void(int first, int last)> &func);
+
+	int getThreadCount() const;
+
+private:
+
+	class Worker : public Threadable
+	{
+	public:
+
+		Worker(JobSystem *system, int index);
+		virtual ~Worker() {}
+
+		// Implements Threadable.
+		void threadFunction() override;
+
+		Job *popJob();
+		Job *stealJob();
+		bool removeJob(Job *job);
+		void pushJob(Job *job);
+
+	private:
+
+		JobSystem *system;
+		int index;
+
+		std::deque<Job *> jobs;
+		MutexRef jobsMutex;
+
+	}; // Worker
+
+	void enqueue(Job *job);
+	Job *takeJob(int worker);
+	Job *takeJobFor(Job *job);
+	void execute(Job *job);
+
+	std::vector<Worker *> workers;
+
+	// Protects everything below, and the dependency state of Jobs.
+	MutexRef mutex;
+	ConditionalRef workCond;
+	ConditionalRef completeCond;
+
+	int nextWorker;
+	int queuedCount;
+	int waiterCount;
+
+	// Incremented every time a Job is queued, so waiting threads can tell
+	// whether there may be something new for them to run.
+	uint32 enqueueCount;
+
+	bool stopping;
+
+}; // JobSystem
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_JOBSYSTEM_H
@@ -45,11 +45,8 @@ LuaThread::~LuaThread()
 {
 }
 
-void LuaThread::threadFunction()
+lua_State *LuaThread::newLuaState()
 {
-	error.clear();
-	haserror = false;
-
 	lua_State *L = luaL_newstate();
 	luaL_openlibs(L);
 
@@ -68,6 +65,16 @@ void LuaThread::threadFunction()
 	luax_require(L, "love.filesystem");
 	lua_pop(L, 1);
 
+	return L;
+}
+
+void LuaThread::threadFunction()
+{
+	error.clear();
+	haserror = false;
+
+	lua_State *L = newLuaState();
+
 	lua_pushcfunction(L, luax_traceback);
 	int tracebackidx = lua_gettop(L);
 
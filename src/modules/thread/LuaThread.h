@@ -50,6 +50,12 @@ class LuaThread : public Threadable
 
 	bool start(const std::vector<Variant> &args);
 
+	/**
+	 * Creates a new Lua state for thread code, with love.thread and
+	 * love.filesystem loaded.
+	 **/
+	static lua_State *newLuaState();
+
 private:
 
 	void onError();
@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "LuaThreadPool.h"
+#include "LuaThread.h"
+#include "common/Exception.h"
+
+namespace love
+{
+namespace thread
+{
+
+love::Type LuaThreadPool::type("ThreadPool", &Object::type);
+
+static std::vector<std::pair<Variant, Variant>> *newResult(uint64 id)
+{
+	auto result = new std::vector<std::pair<Variant, Variant>>();
+	result->emplace_back(Variant(std::string("id")), Variant((double) id));
+	return result;
+}
+
+static void setResultError(std::vector<std::pair<Variant, Variant>> *result, const std::string &error)
+{
+	// Keep the id, drop any returned values.
+	result->resize(1);
+	result->emplace_back(Variant(std::string("error")), Variant(error));
+}
+
+LuaThreadPool::Worker::Worker(LuaThreadPool *pool, int index)
+	: pool(pool)
+	, index(index)
+{
+	threadName = pool->name;
+}
+
+void LuaThreadPool::Worker::threadFunction()
+{
+	lua_State *L = LuaThread::newLuaState();
+
+	lua_pushcfunction(L, luax_traceback);
+	int tracebackidx = lua_gettop(L);
+
+	std::string initerror;
+
+	Data *code = pool->code.get();
+	if (luaL_loadbuffer(L, (const char *) code->getData(), code->getSize(), pool->name.c_str()) != 0)
+		initerror = luax_tostring(L, -1);
+	else
+	{
+		lua_pushinteger(L, index + 1);
+
+		if (lua_pcall(L, 1, 1, tracebackidx) != 0)
+			initerror = luax_tostring(L, -1);
+		else if (!lua_isfunction(L, -1))
+			initerror = "Thread pool code must return a function.";
+	}
+
+	int handleridx = lua_gettop(L);
+
+	// Every job reports the error if the code couldn't be run, rather than
+	// never finishing.
+	Job job;
+	while (pool->nextJob(index, job))
+	{
+		if (initerror.empty())
+			runJob(L, tracebackidx, handleridx, job);
+		else
+		{
+			auto result = newResult(job.id);
+			setResultError(result, initerror);
+			pool->finishJob(result);
+		}
+
+		job.args.clear();
+	}
+
+	lua_close(L);
+}
+
+void LuaThreadPool::Worker::runJob(lua_State *L, int tracebackidx, int handleridx, const Job &job)
+{
+	auto result = newResult(job.id);
+	int base = lua_gettop(L);
+	int nargs = (int) job.args.size();
+
+	if (!lua_checkstack(L, nargs + 1))
+	{
+		setResultError(result, "Too many arguments.");
+		pool->finishJob(result);
+		return;
+	}
+
+	lua_pushvalue(L, handleridx);
+	for (const Variant &arg : job.args)
+		arg.toLua(L);
+
+	if (lua_pcall(L, nargs, LUA_MULTRET, tracebackidx) != 0)
+		setResultError(result, luax_tostring(L, -1));
+	else
+	{
+		int nresults = lua_gettop(L) - base;
+
+		try
+		{
+			for (int i = 1; i <= nresults; i++)
+			{
+				Variant v = Variant::fromLua(L, base + i);
+				if (v.getType() == Variant::UNKNOWN)
+					throw love::Exception("Return value #%d can't be sent between threads.", i);
+
+				result->emplace_back(Variant((double) i), v);
+			}
+
+			result->emplace_back(Variant(std::string("n")), Variant((double) nresults));
+		}
+		catch (std::exception &e)
+		{
+			setResultError(result, e.what());
+		}
+	}
+
+	lua_settop(L, base);
+	pool->finishJob(result);
+}
+
+bool LuaThreadPool::Worker::popJob(Job &job)
+{
+	Lock lock(jobsMutex);
+
+	if (jobs.empty())
+		return false;
+
+	job = std::move(jobs.front());
+	jobs.pop_front();
+	return true;
+}
+
+bool LuaThreadPool::Worker::stealJob(Job &job)
+{
+	Lock lock(jobsMutex);
+
+	if (jobs.empty())
+		return false;
+
+	job = std::move(jobs.back());
+	jobs.pop_back();
+	return true;
+}
+
+void LuaThreadPool::Worker::pushJob(Job &&job)
+{
+	Lock lock(jobsMutex);
+	jobs.push_back(std::move(job));
+}
+
+LuaThreadPool::LuaThreadPool(const std::string &name, love::Data *code, int threadcount)
+	: code(code)
+	, name(name)
+	, channel(new Channel(), Acquire::NORETAIN)
+	, nextID(1)
+	, nextWorker(0)
+	, queuedCount(0)
+	, runningCount(0)
+	, stopping(false)
+{
+	if (threadcount < 1)
+		throw love::Exception("Thread pools must have at least one thread.");
+
+	for (int i = 0; i < threadcount; i++)
+		workers.push_back(new Worker(this, i));
+
+	for (Worker *worker : workers)
+		worker->start();
+}
+
+LuaThreadPool::~LuaThreadPool()
+{
+	{
+		Lock lock(mutex);
+		stopping = true;
+		cond->broadcast();
+	}
+
+	// Jobs which haven't started yet are dropped.
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+uint64 LuaThreadPool::submit(const std::vector<Variant> &args)
+{
+	Lock lock(mutex);
+
+	Job job;
+	job.id = nextID++;
+	job.args = args;
+
+	uint64 id = job.id;
+
+	// Submitted jobs are spread across the queues, idle workers steal the
+	// rest.
+	workers[nextWorker]->pushJob(std::move(job));
+	nextWorker = (nextWorker + 1) % (int) workers.size();
+
+	queuedCount++;
+	cond->signal();
+
+	return id;
+}
+
+bool LuaThreadPool::nextJob(int worker, Job &job)
+{
+	int count = (int) workers.size();
+
+	while (true)
+	{
+		bool found = workers[worker]->popJob(job);
+
+		for (int i = 1; i < count && !found; i++)
+			found = workers[(worker + i) % count]->stealJob(job);
+
+		Lock lock(mutex);
+
+		if (stopping)
+			return false;
+
+		if (found)
+		{
+			queuedCount--;
+			runningCount++;
+			return true;
+		}
+
+		// A job which was submitted after the queues were checked is still
+		// counted as queued, so this won't miss it.
+		while (!stopping && queuedCount == 0)
+			cond->wait(mutex);
+
+		if (stopping)
+			return false;
+	}
+}
+
+void LuaThreadPool::finishJob(std::vector<std::pair<Variant, Variant>> *result)
+{
+	// The result is pushed before the job stops counting as pending, so all
+	// results are in the Channel once getPendingCount returns 0.
+	channel->push(Variant(result));
+
+	Lock lock(mutex);
+	runningCount--;
+}
+
+Channel *LuaThreadPool::getChannel() const
+{
+	return channel.get();
+}
+
+int LuaThreadPool::getThreadCount() const
+{
+	return (int) workers.size();
+}
+
+int LuaThreadPool::getPendingCount() const
+{
+	Lock lock(mutex);
+	return queuedCount + runningCount;
+}
+
+} // thread
+} // love
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_THREAD_LUATHREADPOOL_H
+#define LOVE_THREAD_LUATHREADPOOL_H
+
+// LOVE
+#include "common/Data.h"
+#include "common/Object.h"
+#include "common/Variant.h"
+#include "common/int.h"
+#include "Channel.h"
+#include "threads.h"
+
+// STL
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * A set of persistent threads which run jobs with the same Lua code. Each
+ * thread creates its Lua state and runs the code once, which must return the
+ * function to call for every job. Jobs are distributed across per-thread
+ * queues, and idle threads steal jobs from the others' queues.
+ *
+ * The results of each job are pushed to the pool's Channel as a table with
+ * the job's id, and either the returned values (and their count, n) or an
+ * error.
+ **/
+class LuaThreadPool : public love::Object
+{
+public:
+
+	static love::Type type;
+
+	LuaThreadPool(const std::string &name, love::Data *code, int threadcount);
+	virtual ~LuaThreadPool();
+
+	/**
+	 * Queues a job and returns its id.
+	 **/
+	uint64 submit(const std::vector<Variant> &args);
+
+	Channel *getChannel() const;
+	int getThreadCount() const;
+
+	/**
+	 * Gets the number of jobs which have been submitted but haven't finished.
+	 **/
+	int getPendingCount() const;
+
+private:
+
+	struct Job
+	{
+		uint64 id;
+		std::vector<Variant> args;
+	};
+
+	class Worker : public Threadable
+	{
+	public:
+
+		Worker(LuaThreadPool *pool, int index);
+		virtual ~Worker() {}
+
+		// Implements Threadable.
+		void threadFunction() override;
+
+		bool popJob(Job &job);
+		bool stealJob(Job &job);
+		void pushJob(Job &&job);
+
+	private:
+
+		void runJob(lua_State *L, int tracebackidx, int handleridx, const Job &job);
+
+		LuaThreadPool *pool;
+		int index;
+
+		std::deque<Job> jobs;
+		MutexRef jobsMutex;
+
+	}; // Worker
+
+	bool nextJob(int worker, Job &job);
+	void finishJob(std::vector<std::pair<Variant, Variant>> *result);
+
+	StrongRef<love::Data> code;
+	std::string name;
+
+	StrongRef<Channel> channel;
+
+	std::vector<Worker *> workers;
+
+	// Protects everything below.
+	MutexRef mutex;
+	ConditionalRef cond;
+
+	uint64 nextID;
+	int nextWorker;
+
+	// Jobs which are in a queue, and jobs which are running.
+	int queuedCount;
+	int runningCount;
+
+	bool stopping;
+
+}; // LuaThreadPool
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_LUATHREADPOOL_H
@@ -30,6 +30,11 @@ LuaThread *ThreadModule::newThread(const std::string &name, love::Data *data)
 	return new LuaThread(name, data);
 }
 
+LuaThreadPool *ThreadModule::newPool(const std::string &name, love::Data *data, int threadcount)
+{
+	return new LuaThreadPool(name, data, threadcount);
+}
+
 Channel *ThreadModule::newChannel()
 {
 	return new Channel();
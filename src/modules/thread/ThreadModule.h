@@ -33,6 +33,7 @@
 #include "Thread.h"
 #include "Channel.h"
 #include "LuaThread.h"
+#include "LuaThreadPool.h"
 #include "threads.h"
 
 namespace love
@@ -45,6 +46,7 @@ class ThreadModule : public love::Module
 
 	virtual ~ThreadModule() {}
 	virtual LuaThread *newThread(const std::string &name, love::Data *data);
+	virtual LuaThreadPool *newPool(const std::string &name, love::Data *data, int threadcount);
 	virtual Channel *newChannel();
 	virtual Channel *getChannel(const std::string &name);
 
@@ -129,6 +129,11 @@ Mutex *newMutex();
 Conditional *newConditional();
 Thread *newThread(Threadable *t);
 
+/**
+ * Gets the number of logical processors, like love.system.getProcessorCount.
+ **/
+int getProcessorCount();
+
 #if defined(LOVE_LINUX)
 void disableSignals();
 void reenableSignals();
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2006-2023 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_LuaThreadPool.h"
+#include "wrap_Channel.h"
+
+namespace love
+{
+namespace thread
+{
+
+LuaThreadPool *luax_checkthreadpool(lua_State *L, int idx)
+{
+	return luax_checktype<LuaThreadPool>(L, idx);
+}
+
+int w_ThreadPool_submit(lua_State *L)
+{
+	LuaThreadPool *t = luax_checkthreadpool(L, 1);
+	std::vector<Variant> args;
+	int nargs = lua_gettop(L) - 1;
+
+	for (int i = 0; i < nargs; ++i)
+	{
+		luax_catchexcept(L, [&]() {
+			args.push_back(Variant::fromLua(L, i+2));
+		});
+
+		if (args.back().getType() == Variant::UNKNOWN)
+		{
+			args.clear();
+			return luaL_argerror(L, i+2, "boolean, number, string, love type, or flat table expected");
+		}
+	}
+
+	uint64 id = t->submit(args);
+	lua_pushnumber(L, (lua_Number) id);
+	return 1;
+}
+
+int w_ThreadPool_getChannel(lua_State *L)
+{
+	LuaThreadPool *t = luax_checkthreadpool(L, 1);
+	luax_pushtype(L, t->getChannel());
+	return 1;
+}
+
+int w_ThreadPool_getThreadCount(lua_State *L)
+{
+	LuaThreadPool *t = luax_checkthreadpool(L, 1);
+	lua_pushinteger(L, t->getThreadCount());
+	return 1;
+}
+
+int w_ThreadPool_getPendingCount(lua_State *L)
+{
+	LuaThreadPool *t = luax_checkthreadpool(L, 1);
+	lua_pushinteger(L, t->getPendingCount());
+	return 1;
+}
+
+static const luaL_Reg w_ThreadPool_functions[] =
+{
+	{ "submit", w_ThreadPool_submit },
+	{ "getChannel", w_ThreadPool_getChannel },
+	{ "getThreadCount", w_ThreadPool_getThreadCount },
+	{ "getPendingCount", w_ThreadPool_getPendingCount },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_threadpool(lua_State *L)
+{
+	return luax_register_type(L, &LuaThreadPool::type, w_ThreadPool_functions, nullptr);
+}
+
+} // thread
+} // love
@@ -21,7 +21,9 @@
 // LOVE
 #include "wrap_ThreadModule.h"
 #include "wrap_LuaThread.h"
+#include "wrap_LuaThreadPool.h"
 #include "wrap_Channel.h"
+#include "wrap_Job.h"
 #include "ThreadModule.h"
 
 #include "filesystem/File.h"
@@ -37,43 +39,47 @@ namespace thread
 
 #define instance() (Module::getInstance<ThreadModule>(Module::M_THREAD))
 
-int w_newThread(lua_State *L)
+// Converts the thread code argument at idx to a Data, in place.
+static love::Data *checkThreadCode(lua_State *L, int idx, std::string &name)
 {
-	std::string name = "Thread code";
-	love::Data *data = nullptr;
+	name = "Thread code";
 
-	if (lua_isstring(L, 1))
+	if (lua_isstring(L, idx))
 	{
 		size_t slen = 0;
-		const char *str = lua_tolstring(L, 1, &slen);
+		const char *str = lua_tolstring(L, idx, &slen);
 
 		// Treat the string as Lua code if it's long or has a newline.
 		if (slen >= 1024 || memchr(str, '\n', slen))
 		{
 			// Construct a FileData from the string.
-			lua_pushvalue(L, 1);
+			lua_pushvalue(L, idx);
 			lua_pushstring(L, "string");
 			int idxs[] = {lua_gettop(L) - 1, lua_gettop(L)};
 			luax_convobj(L, idxs, 2, "filesystem", "newFileData");
 			lua_pop(L, 1);
-			lua_replace(L, 1);
+			lua_replace(L, idx);
 		}
 		else
-			luax_convobj(L, 1, "filesystem", "newFileData");
+			luax_convobj(L, idx, "filesystem", "newFileData");
 	}
-	else if (luax_istype(L, 1, love::filesystem::File::type))
-		luax_convobj(L, 1, "filesystem", "newFileData");
+	else if (luax_istype(L, idx, love::filesystem::File::type))
+		luax_convobj(L, idx, "filesystem", "newFileData");
 
-	if (luax_istype(L, 1, love::filesystem::FileData::type))
+	if (luax_istype(L, idx, love::filesystem::FileData::type))
 	{
-		love::filesystem::FileData *fdata = luax_checktype<love::filesystem::FileData>(L, 1);
+		love::filesystem::FileData *fdata = luax_checktype<love::filesystem::FileData>(L, idx);
 		name = std::string("@") + fdata->getFilename();
-		data = fdata;
+		return fdata;
 	}
 	else
-	{
-		data = luax_checktype<love::Data>(L, 1);
-	}
+		return luax_checktype<love::Data>(L, idx);
+}
+
+int w_newThread(lua_State *L)
+{
+	std::string name;
+	love::Data *data = checkThreadCode(L, 1, name);
 
 	LuaThread *t = instance()->newThread(name, data);
 	luax_pushtype(L, t);
@@ -81,6 +87,21 @@ int w_newThread(lua_State *L)
 	return 1;
 }
 
+int w_newPool(lua_State *L)
+{
+	int threadcount = (int) luaL_checkinteger(L, 1);
+
+	std::string name;
+	love::Data *data = checkThreadCode(L, 2, name);
+
+	LuaThreadPool *t = nullptr;
+	luax_catchexcept(L, [&](){ t = instance()->newPool(name, data, threadcount); });
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
 int w_newChannel(lua_State *L)
 {
 	Channel *c = instance()->newChannel();
@@ -101,6 +122,7 @@ int w_getChannel(lua_State *L)
 static const luaL_Reg module_functions[] =
 {
 	{ "newThread", w_newThread },
+	{ "newPool", w_newPool },
 	{ "newChannel", w_newChannel },
 	{ "getChannel", w_getChannel },
 	{ 0, 0 }
@@ -108,7 +130,9 @@ static const luaL_Reg module_functions[] =
 
 static const lua_CFunction types[] = {
 	luaopen_thread,
+	luaopen_threadpool,
 	luaopen_channel,
+	luaopen_job,
 	0
 };
 
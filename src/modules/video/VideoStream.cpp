@@ -68,6 +68,9 @@ VideoStream::Frame::Frame()
 	: yplane(nullptr)
 	, cbplane(nullptr)
 	, crplane(nullptr)
+	, yversion(0)
+	, cbversion(0)
+	, crversion(0)
 {
 }
 
@@ -23,6 +23,7 @@
 
 // LOVE
 #include "common/Stream.h"
+#include "common/int.h"
 #include "audio/Source.h"
 #include "thread/threads.h"
 
@@ -69,6 +70,9 @@ class VideoStream : public Stream
 		int cw, ch;
 		unsigned char *cbplane;
 		unsigned char *crplane;
+
+		// Incremented by the decoder whenever a plane's contents change.
+		uint64 yversion, cbversion, crversion;
 	};
 
 	class FrameSync : public Object
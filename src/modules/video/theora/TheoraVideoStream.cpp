@@ -23,6 +23,7 @@
 
 // LOVE
 #include "TheoraVideoStream.h"
+#include "libraries/xxHash/xxhash.h"
 
 using love::filesystem::File;
 
@@ -37,17 +38,23 @@ TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
 	: demuxer(file)
 	, headerParsed(false)
 	, decoder(nullptr)
-	, frameReady(false)
+	, planeHashes()
+	, planeVersions()
 	, lastFrame(0)
 	, nextFrame(0)
+	, frameDuration(0)
+	, lastPosition(0)
 {
 	if (demuxer.findStream() != OggDemuxer::TYPE_THEORA)
 		throw love::Exception("Invalid video file, video is not theora");
 
 	th_info_init(&videoInfo);
 
-	frontBuffer = new Frame();
-	backBuffer = new Frame();
+	for (int i = 0; i < MAX_QUEUED_FRAMES + 1; i++)
+		frames.push_back(new Frame());
+
+	frontBuffer = frames[0];
+	freeFrames.assign(frames.begin() + 1, frames.end());
 
 	try
 	{
@@ -55,8 +62,8 @@ TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
 	}
 	catch (love::Exception &ex)
 	{
-		delete backBuffer;
-		delete frontBuffer;
+		for (Frame *frame : frames)
+			delete frame;
 		th_info_clear(&videoInfo);
 		throw ex;
 	}
@@ -71,8 +78,8 @@ TheoraVideoStream::~TheoraVideoStream()
 
 	th_info_clear(&videoInfo);
 
-	delete frontBuffer;
-	delete backBuffer;
+	for (Frame *frame : frames)
+		delete frame;
 }
 
 int TheoraVideoStream::getWidth() const
@@ -162,27 +169,28 @@ void TheoraVideoStream::parseHeader()
 	decoder = th_decode_alloc(&videoInfo, setupInfo);
 	th_setup_free(setupInfo);
 
-	Frame *buffers[2] = {backBuffer, frontBuffer};
+	if (videoInfo.fps_numerator > 0)
+		frameDuration = (double) videoInfo.fps_denominator / (double) videoInfo.fps_numerator;
 
 	yPlaneXOffset = cPlaneXOffset = videoInfo.pic_x;
 	yPlaneYOffset = cPlaneYOffset = videoInfo.pic_y;
 
 	scaleFormat(videoInfo.pixel_fmt, cPlaneXOffset, cPlaneYOffset);
 
-	for (int i = 0; i < 2; i++)
+	for (Frame *frame : frames)
 	{
-		buffers[i]->cw = buffers[i]->yw = videoInfo.pic_width;
-		buffers[i]->ch = buffers[i]->yh = videoInfo.pic_height;
+		frame->cw = frame->yw = videoInfo.pic_width;
+		frame->ch = frame->yh = videoInfo.pic_height;
 
-		scaleFormat(videoInfo.pixel_fmt, buffers[i]->cw, buffers[i]->ch);
+		scaleFormat(videoInfo.pixel_fmt, frame->cw, frame->ch);
 
-		buffers[i]->yplane = new unsigned char[buffers[i]->yw * buffers[i]->yh];
-		buffers[i]->cbplane = new unsigned char[buffers[i]->cw * buffers[i]->ch];
-		buffers[i]->crplane = new unsigned char[buffers[i]->cw * buffers[i]->ch];
+		frame->yplane = new unsigned char[frame->yw * frame->yh];
+		frame->cbplane = new unsigned char[frame->cw * frame->ch];
+		frame->crplane = new unsigned char[frame->cw * frame->ch];
 
-		memset(buffers[i]->yplane, 16, buffers[i]->yw * buffers[i]->yh);
-		memset(buffers[i]->cbplane, 128, buffers[i]->cw * buffers[i]->ch);
-		memset(buffers[i]->crplane, 128, buffers[i]->cw * buffers[i]->ch);
+		memset(frame->yplane, 16, frame->yw * frame->yh);
+		memset(frame->cbplane, 128, frame->cw * frame->ch);
+		memset(frame->crplane, 128, frame->cw * frame->ch);
 	}
 
 	headerParsed = true;
@@ -201,6 +209,79 @@ void TheoraVideoStream::seekDecoder(double target)
 	// Now update theora and our decoder on this new position of ours
 	lastFrame = nextFrame = -1;
 	th_decode_ctl(decoder, TH_DECCTL_SET_GRANPOS, &packet.granulepos, sizeof(packet.granulepos));
+
+	// Anything decoded before the seek is stale.
+	clearQueuedFrames();
+}
+
+static void copyPlane(unsigned char *dst, int w, int h, const th_img_plane &src, unsigned int xoffset, unsigned int yoffset)
+{
+	for (int y = 0; y < h; ++y)
+		memcpy(dst + w * y, src.data + src.stride * (y + yoffset) + xoffset, w);
+}
+
+void TheoraVideoStream::queueFrame(const th_img_plane *planes, double time)
+{
+	Frame *frame = nullptr;
+
+	{
+		love::thread::Lock l(bufferMutex);
+
+		if (!freeFrames.empty())
+		{
+			frame = freeFrames.back();
+			freeFrames.pop_back();
+		}
+		else
+		{
+			// The queue is full of frames which are all due by now, so the
+			// oldest one would never be shown anyway.
+			frame = queuedFrames.front().frame;
+			queuedFrames.pop_front();
+		}
+	}
+
+	copyPlane(frame->yplane, frame->yw, frame->yh, planes[0], yPlaneXOffset, yPlaneYOffset);
+	copyPlane(frame->cbplane, frame->cw, frame->ch, planes[1], cPlaneXOffset, cPlaneYOffset);
+	copyPlane(frame->crplane, frame->cw, frame->ch, planes[2], cPlaneXOffset, cPlaneYOffset);
+
+	// Bump a plane's version only when its contents change, so the graphics
+	// side can skip re-uploading the others.
+	const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
+	size_t sizes[3] = {
+		(size_t) frame->yw * frame->yh,
+		(size_t) frame->cw * frame->ch,
+		(size_t) frame->cw * frame->ch,
+	};
+
+	for (int i = 0; i < 3; i++)
+	{
+		uint64 hash = XXH64(data[i], sizes[i], 0);
+		if (hash != planeHashes[i])
+		{
+			planeHashes[i] = hash;
+			planeVersions[i]++;
+		}
+	}
+
+	frame->yversion = planeVersions[0];
+	frame->cbversion = planeVersions[1];
+	frame->crversion = planeVersions[2];
+
+	love::thread::Lock l(bufferMutex);
+
+	QueuedFrame queued = {frame, time};
+	queuedFrames.push_back(queued);
+}
+
+void TheoraVideoStream::clearQueuedFrames()
+{
+	love::thread::Lock l(bufferMutex);
+
+	for (const QueuedFrame &queued : queuedFrames)
+		freeFrames.push_back(queued.frame);
+
+	queuedFrames.clear();
 }
 
 void TheoraVideoStream::threadedFillBackBuffer(double dt)
@@ -209,28 +290,45 @@ void TheoraVideoStream::threadedFillBackBuffer(double dt)
 	frameSync->update(dt);
 	double position = frameSync->getPosition();
 
-	// Seeking backwards
-	if (position < lastFrame)
+	// Seeking backwards. Decoded frames run ahead of the position, so it's
+	// compared against the previous position rather than the last frame.
+	if (position < lastPosition)
 		seekDecoder(position);
 
+	lastPosition = position;
+
 	th_ycbcr_buffer bufferinfo;
-	bool hasFrame = false;
 
-	// Until we are at the end of the stream, or we are displaying the right frame
+	// Until we are at the end of the stream, or the queue is full of frames
+	// which aren't due yet.
 	unsigned int framesBehind = 0;
 	bool failedSeek = false;
-	while (!demuxer.isEos() && position >= nextFrame)
+	while (!demuxer.isEos())
 	{
+		bool late = position >= nextFrame;
+
+		if (!late)
+		{
+			love::thread::Lock l(bufferMutex);
+			if (freeFrames.empty())
+				break;
+		}
+
 		// If we can't catch up, seek
-		if (framesBehind++ > 5 && !failedSeek)
+		if (late && framesBehind++ > 5 && !failedSeek)
 		{
 			seekDecoder(position);
 			framesBehind = 0;
 			failedSeek = true;
 		}
 
+		double frameTime = nextFrame;
 		th_decode_ycbcr_out(decoder, bufferinfo);
-		hasFrame = true;
+
+		// Late frames which the next one will replace before they're ever
+		// shown aren't worth copying.
+		if (!late || position < frameTime + frameDuration)
+			queueFrame(bufferinfo, frameTime);
 
 		ogg_int64_t granulePosition;
 		do
@@ -241,46 +339,6 @@ void TheoraVideoStream::threadedFillBackBuffer(double dt)
 		lastFrame = nextFrame;
 		nextFrame = th_granule_time(decoder, granulePosition);
 	}
-
-	// Only swap once, even if we read many frames to get here
-	if (hasFrame)
-	{
-		// Don't swap whilst we're writing to the backbuffer
-		{
-			love::thread::Lock l(bufferMutex);
-			frameReady = false;
-		}
-
-		for (int y = 0; y < backBuffer->yh; ++y)
-		{
-			memcpy(backBuffer->yplane+backBuffer->yw*y,
-					bufferinfo[0].data+
-						bufferinfo[0].stride*(y+yPlaneYOffset)+yPlaneXOffset,
-					backBuffer->yw);
-		}
-
-		for (int y = 0; y < backBuffer->ch; ++y)
-		{
-			memcpy(backBuffer->cbplane+backBuffer->cw*y,
-					bufferinfo[1].data+
-						bufferinfo[1].stride*(y+cPlaneYOffset)+cPlaneXOffset,
-					backBuffer->cw);
-		}
-
-		for (int y = 0; y < backBuffer->ch; ++y)
-		{
-			memcpy(backBuffer->crplane+backBuffer->cw*y,
-					bufferinfo[2].data+
-						bufferinfo[2].stride*(y+cPlaneYOffset)+cPlaneXOffset,
-					backBuffer->cw);
-		}
-
-		// Re-enable swapping
-		{
-			love::thread::Lock l(bufferMutex);
-			frameReady = true;
-		}
-	}
 }
 
 void TheoraVideoStream::fillBackBuffer()
@@ -290,20 +348,29 @@ void TheoraVideoStream::fillBackBuffer()
 
 bool TheoraVideoStream::swapBuffers()
 {
-	if (demuxer.isEos())
-		return false;
-
 	if (!frameSync->isPlaying())
 		return false;
 
+	double position = frameSync->getPosition();
+
 	love::thread::Lock l(bufferMutex);
-	if (!frameReady)
+
+	// Show the newest frame which is due, and recycle any older ones.
+	Frame *newFront = nullptr;
+	while (!queuedFrames.empty() && queuedFrames.front().time <= position)
+	{
+		if (newFront != nullptr)
+			freeFrames.push_back(newFront);
+
+		newFront = queuedFrames.front().frame;
+		queuedFrames.pop_front();
+	}
+
+	if (newFront == nullptr)
 		return false;
-	frameReady = false;
 
-	Frame *temp = frontBuffer;
-	frontBuffer = backBuffer;
-	backBuffer = temp;
+	freeFrames.push_back(frontBuffer);
+	frontBuffer = newFront;
 
 	return true;
 }
@@ -23,6 +23,10 @@
 
 #include "video/VideoStream.h"
 
+// STL
+#include <vector>
+#include <deque>
+
 // LOVE
 #include "common/int.h"
 #include "filesystem/File.h"
@@ -62,6 +66,16 @@ class TheoraVideoStream : public love::video::VideoStream
 	void threadedFillBackBuffer(double dt);
 
 private:
+
+	// The number of decoded frames which can wait behind the displayed one.
+	static const int MAX_QUEUED_FRAMES = 4;
+
+	struct QueuedFrame
+	{
+		Frame *frame;
+		double time;
+	};
+
 	OggDemuxer demuxer;
 
 	bool headerParsed;
@@ -71,21 +85,33 @@ class TheoraVideoStream : public love::video::VideoStream
 	th_info videoInfo;
 	th_dec_ctx *decoder;
 
+	std::vector<Frame *> frames;
 	Frame *frontBuffer;
-	Frame *backBuffer;
+
+	// Guarded by bufferMutex.
+	std::vector<Frame *> freeFrames;
+	std::deque<QueuedFrame> queuedFrames;
+
+	// Only touched by the decoding thread.
+	uint64 planeHashes[3];
+	uint64 planeVersions[3];
+
 	unsigned int yPlaneXOffset;
 	unsigned int cPlaneXOffset;
 	unsigned int yPlaneYOffset;
 	unsigned int cPlaneYOffset;
 
 	love::thread::MutexRef bufferMutex;
-	bool frameReady;
 
 	double lastFrame;
 	double nextFrame;
+	double frameDuration;
+	double lastPosition;
 
 	void parseHeader();
 	void seekDecoder(double target);
+	void queueFrame(const th_img_plane *planes, double time);
+	void clearQueuedFrames();
 }; // TheoraVideoStream
 
 } // theora
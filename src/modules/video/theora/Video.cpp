@@ -20,10 +20,11 @@
 
 // STL
 #include <vector>
+#include <thread>
+#include <algorithm>
 
 // LOVE
 #include "Video.h"
-#include "common/delay.h"
 #include "timer/Timer.h"
 
 namespace love
@@ -33,21 +34,27 @@ namespace video
 namespace theora
 {
 
+// Decoding is usually cheap compared to everything else a game does, so only
+// a few threads are used even on machines with many cores.
+static const int MAX_DECODE_THREADS = 4;
+
 Video::Video()
 {
-	workerThread = new Worker();
-	workerThread->start();
+	int threadcount = (int) std::thread::hardware_concurrency() - 1;
+	threadcount = std::max(1, std::min(threadcount, MAX_DECODE_THREADS));
+
+	decodePool = new DecodePool(threadcount);
 }
 
 Video::~Video()
 {
-	delete workerThread;
+	delete decodePool;
 }
 
 VideoStream *Video::newVideoStream(love::filesystem::File *file)
 {
 	TheoraVideoStream *stream = new TheoraVideoStream(file);
-	workerThread->addStream(stream);
+	decodePool->addStream(stream);
 	return stream;
 }
 
@@ -56,25 +63,38 @@ const char *Video::getName() const
 	return "love.video.theora";
 }
 
-Worker::Worker()
-	: stopping(false)
+DecodePool::Worker::Worker(DecodePool *pool)
+	: pool(pool)
 {
 	threadName = "VideoWorker";
 }
 
-Worker::~Worker()
+void DecodePool::Worker::threadFunction()
 {
-	stop();
+	StrongRef<TheoraVideoStream> stream;
+	double dt = 0.0;
+
+	while (pool->nextStream(stream, dt))
+	{
+		stream->threadedFillBackBuffer(dt);
+		pool->finishStream(stream);
+		stream.set(nullptr);
+	}
 }
 
-void Worker::addStream(TheoraVideoStream *stream)
+DecodePool::DecodePool(int threadcount)
+	: nextIndex(0)
+	, stopping(false)
 {
-	love::thread::Lock l(mutex);
-	streams.push_back(stream);
-	cond->broadcast();
+	for (int i = 0; i < threadcount; i++)
+	{
+		Worker *worker = new Worker(this);
+		workers.push_back(worker);
+		worker->start();
+	}
 }
 
-void Worker::stop()
+DecodePool::~DecodePool()
 {
 	{
 		love::thread::Lock l(mutex);
@@ -82,45 +102,91 @@ void Worker::stop()
 		cond->broadcast();
 	}
 
-	owner->wait();
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
 }
 
-void Worker::threadFunction()
+void DecodePool::addStream(TheoraVideoStream *stream)
 {
-	double lastFrame = love::timer::Timer::getTime();
+	love::thread::Lock l(mutex);
 
-	while (true)
-	{
-		love::sleep(2);
+	StreamEntry entry;
+	entry.stream.set(stream);
+	entry.lastUpdate = love::timer::Timer::getTime();
+	entry.busy = false;
 
-		love::thread::Lock l(mutex);
+	streams.push_back(entry);
+	cond->broadcast();
+}
+
+bool DecodePool::nextStream(StrongRef<TheoraVideoStream> &stream, double &dt)
+{
+	love::thread::Lock l(mutex);
 
-		while (!stopping && streams.empty())
+	while (!stopping)
+	{
+		// Streams which only we reference can't be drawn anymore.
+		for (int i = (int) streams.size() - 1; i >= 0; i--)
 		{
-			cond->wait(mutex);
-			lastFrame = love::timer::Timer::getTime();
+			if (!streams[i].busy && streams[i].stream->getReferenceCount() == 1)
+				streams.erase(streams.begin() + i);
 		}
 
-		if (stopping)
-			return;
-
-		double curFrame = love::timer::Timer::getTime();
-		double dt = curFrame-lastFrame;
-		lastFrame = curFrame;
+		double now = love::timer::Timer::getTime();
+		double wait = -1.0;
 
-		for (auto it = streams.begin(); it != streams.end(); ++it)
+		// Round-robin, so a slow stream can't starve the others.
+		for (size_t i = 0; i < streams.size(); i++)
 		{
-			TheoraVideoStream *stream = *it;
-			if (stream->getReferenceCount() == 1)
+			size_t index = (nextIndex + i) % streams.size();
+			StreamEntry &entry = streams[index];
+
+			if (entry.busy)
+				continue;
+
+			double due = entry.lastUpdate + UPDATE_INTERVAL;
+			if (now < due)
 			{
-				// We're the only ones left
-				streams.erase(it);
-				break;
+				if (wait < 0.0 || due - now < wait)
+					wait = due - now;
+				continue;
 			}
 
-			stream->threadedFillBackBuffer(dt);
+			entry.busy = true;
+			dt = now - entry.lastUpdate;
+			entry.lastUpdate = now;
+
+			stream = entry.stream;
+			nextIndex = index + 1;
+			return true;
 		}
+
+		if (wait < 0.0)
+			cond->wait(mutex);
+		else
+			cond->wait(mutex, std::max(1, (int) (wait * 1000.0)));
 	}
+
+	return false;
+}
+
+void DecodePool::finishStream(TheoraVideoStream *stream)
+{
+	love::thread::Lock l(mutex);
+
+	for (StreamEntry &entry : streams)
+	{
+		if (entry.stream.get() == stream)
+		{
+			entry.busy = false;
+			break;
+		}
+	}
+
+	cond->signal();
 }
 
 } // theora
@@ -38,7 +38,7 @@ namespace video
 namespace theora
 {
 
-class Worker;
+class DecodePool;
 
 class Video : public love::video::Video
 {
@@ -52,31 +52,63 @@ class Video : public love::video::Video
 	VideoStream *newVideoStream(love::filesystem::File* file);
 
 private:
-	Worker *workerThread;
+	DecodePool *decodePool;
 }; // Video
 
-class Worker : public love::thread::Threadable
+/**
+ * Decodes playing streams on a pool of threads. Each stream is decoded by at
+ * most one thread at a time, so separate streams decode in parallel while a
+ * single stream's decoder is never shared.
+ **/
+class DecodePool
 {
 public:
-	Worker();
-	virtual ~Worker();
-
-	// Implements Threadable
-	void threadFunction();
+	DecodePool(int threadcount);
+	~DecodePool();
 
 	void addStream(TheoraVideoStream *stream);
-	// Frees itself!
-	void stop();
 
 private:
 
-	std::vector<StrongRef<TheoraVideoStream>> streams;
+	class Worker : public love::thread::Threadable
+	{
+	public:
+
+		Worker(DecodePool *pool);
+		virtual ~Worker() {}
+
+		// Implements Threadable.
+		void threadFunction() override;
+
+	private:
+
+		DecodePool *pool;
+
+	}; // Worker
+
+	struct StreamEntry
+	{
+		StrongRef<TheoraVideoStream> stream;
+		double lastUpdate;
+		bool busy;
+	};
+
+	bool nextStream(StrongRef<TheoraVideoStream> &stream, double &dt);
+	void finishStream(TheoraVideoStream *stream);
+
+	std::vector<Worker *> workers;
+	std::vector<StreamEntry> streams;
+	size_t nextIndex;
 
 	love::thread::MutexRef mutex;
 	love::thread::ConditionalRef cond;
 
 	bool stopping;
-}; // Worker
+
+	// In seconds.
+	static constexpr double UPDATE_INTERVAL = 0.002;
+
+}; // DecodePool
 
 } // theora
 } // video
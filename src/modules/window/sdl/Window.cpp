@@ -48,6 +48,7 @@
 #include <VersionHelpers.h>
 #elif defined(LOVE_MACOSX)
 #include "common/macosx.h"
+#include <OpenGL/OpenGL.h>
 #endif
 
 #ifndef APIENTRY
@@ -282,6 +283,16 @@ bool Window::createWindowAndContext(int x, int y, int w, int h, Uint32 windowfla
 	std::string contexterror;
 	std::string glversion;
 
+	// Drivers which can execute GL commands on a thread of their own read these
+	// when the context is created. A user's own values take precedence.
+	// Windows drivers don't read either variable and offer no equivalent, so
+	// there this does nothing.
+	if (love::graphics::isThreadedRendering())
+	{
+		SDL_setenv("mesa_glthread", "true", 0);
+		SDL_setenv("__GL_THREADED_OPTIMIZATIONS", "1", 0);
+	}
+
 	// Unfortunately some OpenGL context settings are part of the internal
 	// window state in the Windows and Linux SDL backends, so we have to
 	// recreate the window when we want to change those settings...
@@ -334,6 +345,12 @@ bool Window::createWindowAndContext(int x, int y, int w, int h, Uint32 windowfla
 			return false;
 		}
 
+#ifdef LOVE_MACOSX
+		// The multithreaded GL engine is opt-in per context on macOS.
+		if (love::graphics::isThreadedRendering())
+			CGLEnable(CGLGetCurrentContext(), kCGLCEMPEngine);
+#endif
+
 		return true;
 	};
 